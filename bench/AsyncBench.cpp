@@ -0,0 +1,64 @@
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Core/Async.h"
+#include "Core/PositionFile.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	std::vector<std::string> GetPaths(std::size_t a_count) {
+		Corpus::PositionOptions options;
+		options.count = a_count;
+		options.player = false;
+
+		std::filesystem::path dir = Corpus::GetPositions(options);
+		std::vector<std::string> paths;
+		for (std::size_t ii = 0; ii < a_count; ii++) {
+			paths.push_back((dir / (Corpus::GetPositionName(ii) + ".txt")).string());
+		}
+		return paths;
+	}
+
+	// The apply step runs inline, only the script thread's share of the event is of interest here
+	class InlineExecutor : public Async::Executor {
+	public:
+		void Post(std::function<void()> a_work) override { a_work(); }
+	};
+
+	Async::Task RunAnimationChange(Async::Executor& a_io, Async::Executor& a_main, const std::string& a_path) {
+		co_await Async::ResumeOn{ a_io };
+		std::vector<PositionFile::Entry> entries;
+		PositionFile::Load(a_path, entries);
+
+		co_await Async::ResumeOn{ a_main };
+		Bench::DoNotOptimize(entries);
+	}
+}
+
+// Script thread time per animation change, loading the position file inline and handing it to the I/O executor
+static void Async_AnimationChange(Bench::State& a_state) {
+	std::vector<std::string> paths = GetPaths(100);
+	bool async = a_state.Range() != 0;
+
+	InlineExecutor main;
+	Async::ThreadExecutor io;
+
+	std::size_t index = 0;
+	while (a_state.KeepRunning()) {
+		const std::string& path = paths[index++ % paths.size()];
+		if (async) {
+			RunAnimationChange(io, main, path);
+		}
+		else {
+			std::vector<PositionFile::Entry> entries;
+			PositionFile::Load(path, entries);
+			Bench::DoNotOptimize(entries);
+		}
+	}
+	// Queued loads finish when the executor is destroyed, after the clock stopped
+	a_state.SetItemsProcessed(a_state.GetIterations());
+}
+BENCHMARK(Async_AnimationChange, 0, 1);
@@ -0,0 +1,119 @@
+#include "bench/Bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <regex>
+
+namespace Bench {
+	struct Case {
+		std::string               name;
+		Function                  function;
+		std::vector<std::int64_t> args;
+	};
+
+	std::vector<Case>& GetCases() {
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	bool State::KeepRunning() {
+		if (!started) {
+			started = true;
+			start = Clock::now();
+		}
+
+		if (completed < iterations) {
+			completed++;
+			return true;
+		}
+
+		if (!paused) {
+			elapsed += Clock::now() - start;
+			paused = true;
+		}
+		return false;
+	}
+
+	void State::PauseTiming() {
+		if (!paused) {
+			elapsed += Clock::now() - start;
+			paused = true;
+		}
+	}
+
+	void State::ResumeTiming() {
+		if (paused) {
+			start = Clock::now();
+			paused = false;
+		}
+	}
+
+	// Cases with arguments are registered once per argument as name/argument
+	int Register(std::string_view a_name, Function a_function, std::initializer_list<std::int64_t> a_args) {
+		if (a_args.size() == 0) {
+			GetCases().push_back(Case{ std::string(a_name), a_function, {} });
+		}
+
+		for (std::int64_t arg : a_args) {
+			GetCases().push_back(Case{ std::string(a_name) + "/" + std::to_string(arg), a_function, { arg } });
+		}
+
+		return static_cast<int>(GetCases().size());
+	}
+
+	std::vector<std::string> List() {
+		std::vector<std::string> result;
+		for (const auto& benchCase : GetCases()) {
+			result.push_back(benchCase.name);
+		}
+		return result;
+	}
+
+	std::vector<Result> Run(std::string_view a_filter, double a_minTime) {
+		std::regex filter(a_filter.empty() ? std::string(".") : std::string(a_filter));
+		std::chrono::nanoseconds minTime(static_cast<std::int64_t>(a_minTime * 1e9));
+
+		std::printf("%-48s %14s %12s %14s\n", "Benchmark", "ns/iter", "Iterations", "Items/s");
+
+		std::vector<Result> results;
+		for (const auto& benchCase : GetCases()) {
+			if (!std::regex_search(benchCase.name, filter)) {
+				continue;
+			}
+
+			// Grows the iteration count until the run is long enough to time, capped so a slow case still ends
+			std::uint64_t iterations = 1;
+			while (true) {
+				State state(iterations, benchCase.args);
+				benchCase.function(state);
+
+				std::chrono::nanoseconds elapsed = state.GetElapsed();
+				if (elapsed >= minTime || iterations >= (1ull << 40)) {
+					double seconds = static_cast<double>(elapsed.count()) / 1e9;
+
+					Result result;
+					result.name = benchCase.name;
+					result.ns = static_cast<double>(elapsed.count()) / static_cast<double>(iterations);
+					result.iterations = iterations;
+					result.itemsPerSecond = seconds > 0.0 ? static_cast<double>(state.GetItemsProcessed()) / seconds : 0.0;
+					result.counters = state.GetCounters();
+
+					std::printf("%-48s %14.1f %12llu %14.4g", result.name.c_str(), result.ns, static_cast<unsigned long long>(iterations), result.itemsPerSecond);
+					for (const auto& [name, value] : result.counters) {
+						std::printf(" %s=%g", name.c_str(), value);
+					}
+					std::printf("\n");
+					std::fflush(stdout);
+
+					results.push_back(std::move(result));
+					break;
+				}
+
+				double scale = elapsed.count() > 0 ? static_cast<double>(minTime.count()) * 1.4 / static_cast<double>(elapsed.count()) : 10.0;
+				iterations = std::max(iterations + 1, static_cast<std::uint64_t>(static_cast<double>(iterations) * std::min(scale, 10.0)));
+			}
+		}
+
+		return results;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+// A minimal benchmark harness, each case runs with a doubling iteration count until it takes at least the minimum time
+namespace Bench {
+	class State {
+	public:
+		State(std::uint64_t a_iterations, std::vector<std::int64_t> a_args) : iterations(a_iterations), args(std::move(a_args)) {}
+
+		// The clock starts on the first call, so setup before the loop is not measured
+		bool KeepRunning();
+		void PauseTiming();
+		void ResumeTiming();
+
+		std::int64_t Range(std::size_t a_index = 0) const { return a_index < args.size() ? args[a_index] : 0; }
+		std::uint64_t GetIterations() const { return iterations; }
+		void SetItemsProcessed(std::uint64_t a_items) { items = a_items; }
+		void SetCounter(std::string_view a_name, double a_value) { counters[std::string(a_name)] = a_value; }
+
+		std::chrono::nanoseconds GetElapsed() const { return elapsed; }
+		std::uint64_t GetItemsProcessed() const { return items; }
+		const std::map<std::string, double>& GetCounters() const { return counters; }
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		std::uint64_t                 iterations;
+		std::uint64_t                 completed = 0;
+		bool                          started = false;
+		bool                          paused = false;
+		Clock::time_point             start;
+		std::chrono::nanoseconds      elapsed{ 0 };
+		std::vector<std::int64_t>     args;
+		std::uint64_t                 items = 0;
+		std::map<std::string, double> counters;
+	};
+
+	using Function = void (*)(State&);
+
+	struct Result {
+		std::string                   name;
+		double                        ns;
+		std::uint64_t                 iterations;
+		double                        itemsPerSecond;
+		std::map<std::string, double> counters;
+	};
+
+	int Register(std::string_view a_name, Function a_function, std::initializer_list<std::int64_t> a_args = {});
+	std::vector<std::string> List();
+	std::vector<Result> Run(std::string_view a_filter, double a_minTime);
+
+	template <class T>
+	inline void DoNotOptimize(const T& a_value) {
+#if defined(_MSC_VER)
+		const volatile char* sink = reinterpret_cast<const volatile char*>(&a_value);
+		(void)*sink;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(a_value) : "memory");
+#endif
+	}
+}
+
+#define BENCH_CONCAT_IMPL(a_lhs, a_rhs) a_lhs##a_rhs
+#define BENCH_CONCAT(a_lhs, a_rhs) BENCH_CONCAT_IMPL(a_lhs, a_rhs)
+
+// BENCHMARK(Function) or BENCHMARK(Function, 10, 100) to run it once per argument
+#define BENCHMARK(a_function, ...) \
+	static const int BENCH_CONCAT(g_benchmark, __LINE__) = Bench::Register(#a_function, a_function, { __VA_ARGS__ })
@@ -0,0 +1,104 @@
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "Core/OffsetMath.h"
+#include "bench/Bench.h"
+
+namespace {
+	struct Actor {
+		std::uint32_t formID;
+		Vector3       offset;
+	};
+
+	// Stand-in for BindNativeMethod, the VM holds the arguments and the bound function receives them as its own parameter types,
+	// so a by-value parameter is copied on every call and a reference parameter is not
+	template <class R, class... Args>
+	std::function<R(const std::decay_t<Args>&...)> Bind(R (*a_func)(std::monostate, Args...)) {
+		return [a_func](const std::decay_t<Args>&... a_args) { return a_func(std::monostate{}, a_args...); };
+	}
+
+	float& GetAxis(Vector3& a_offset, const std::string& a_axis) {
+		return a_axis == "X" ? a_offset.x : a_axis == "Y" ? a_offset.y : a_offset.z;
+	}
+
+	// The old per-actor, per-axis natives took the scene array and the axis name by value
+	float GetOffset(std::monostate, std::vector<Actor*> a_actors, std::uint32_t a_index, std::string a_axis) {
+		return a_index < a_actors.size() ? GetAxis(a_actors[a_index]->offset, a_axis) : 0.0f;
+	}
+
+	bool SetOffset(std::monostate, std::vector<Actor*> a_actors, std::uint32_t a_index, std::string a_axis, float a_value) {
+		if (a_index >= a_actors.size()) {
+			return false;
+		}
+		GetAxis(a_actors[a_index]->offset, a_axis) = a_value;
+		return true;
+	}
+
+	// The scene natives read their arguments through const references and handle every actor in one call
+	std::vector<float> GetSceneOffsets(std::monostate, const std::vector<Actor*>& a_actors) {
+		std::vector<float> result;
+		result.reserve(a_actors.size() * 3);
+		for (auto actor : a_actors) {
+			result.push_back(actor->offset.x);
+			result.push_back(actor->offset.y);
+			result.push_back(actor->offset.z);
+		}
+		return result;
+	}
+
+	bool SetSceneOffsets(std::monostate, const std::vector<Actor*>& a_actors, const std::vector<float>& a_offsets) {
+		if (a_offsets.size() != a_actors.size() * 3) {
+			return false;
+		}
+		for (std::size_t ii = 0; ii < a_actors.size(); ii++) {
+			a_actors[ii]->offset = OffsetMath::Clamp(Vector3{ a_offsets[ii * 3], a_offsets[ii * 3 + 1], a_offsets[ii * 3 + 2] }, 500.0f);
+		}
+		return true;
+	}
+}
+
+// Reading and writing every offset of a 5 actor scene through the old per-axis natives and the scene natives
+static void Binding_SceneOffsets(Bench::State& a_state) {
+	std::vector<Actor> storage(5);
+	std::vector<Actor*> actors;
+	for (std::uint32_t ii = 0; ii < storage.size(); ii++) {
+		storage[ii].formID = 0x100 + ii;
+		actors.push_back(&storage[ii]);
+	}
+
+	const std::string axes[] = { "X", "Y", "Z" };
+	bool scene = a_state.Range() != 0;
+
+	auto getOffset = Bind(GetOffset);
+	auto setOffset = Bind(SetOffset);
+	auto getSceneOffsets = Bind(GetSceneOffsets);
+	auto setSceneOffsets = Bind(SetSceneOffsets);
+
+	std::uint64_t calls = 0;
+	while (a_state.KeepRunning()) {
+		if (scene) {
+			std::vector<float> offsets = getSceneOffsets(actors);
+			for (auto& value : offsets) {
+				value += 1.0f;
+			}
+			Bench::DoNotOptimize(setSceneOffsets(actors, offsets));
+			calls += 2;
+		}
+		else {
+			for (std::uint32_t ii = 0; ii < actors.size(); ii++) {
+				for (const auto& axis : axes) {
+					float value = getOffset(actors, ii, axis);
+					Bench::DoNotOptimize(setOffset(actors, ii, axis, value + 1.0f));
+					calls += 2;
+				}
+			}
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations());
+	a_state.SetCounter("callsPerScene", static_cast<double>(calls) / static_cast<double>(a_state.GetIterations()));
+}
+BENCHMARK(Binding_SceneOffsets, 0, 1);
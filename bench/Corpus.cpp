@@ -0,0 +1,149 @@
+#include "bench/Corpus.h"
+
+#include <array>
+#include <fstream>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+namespace Corpus {
+	constexpr std::array<std::string_view, 8> kPacks = { "Leito", "Atomic_Lust", "BP70", "Crazy", "Gray", "Savage_Cabbage", "ZaZ", "Rufgt" };
+	constexpr std::array<std::string_view, 10> kAnimations = { "Doggy", "Stand", "Sit", "Chair", "Bed", "Wall", "Kneel", "Table", "Couch", "Floor" };
+	constexpr std::array<float, 4> kScaleBuckets = { 0.9f, 0.95f, 1.05f, 1.1f };
+
+	std::uint64_t Random::Next() {
+		state += 0x9E3779B97F4A7C15ull;
+		std::uint64_t z = state;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	std::uint32_t Random::Next(std::uint32_t a_bound) {
+		return a_bound == 0 ? 0 : static_cast<std::uint32_t>(Next() % a_bound);
+	}
+
+	float Random::Next(float a_min, float a_max) {
+		float unit = static_cast<float>(Next() >> 40) / static_cast<float>(1ull << 24);
+		return a_min + (a_max - a_min) * unit;
+	}
+
+	// Names look like the ones animation packs ship and are unique per index
+	std::string GetPositionName(std::size_t a_index) {
+		std::string_view pack = kPacks[a_index % kPacks.size()];
+		std::string_view animation = kAnimations[(a_index / kPacks.size()) % kAnimations.size()];
+		return fmt::format("{}_{}_{:03}", pack, animation, a_index / (kPacks.size() * kAnimations.size()));
+	}
+
+	// Offsets are whole tenths so they survive a save and load unchanged
+	std::vector<PositionFile::Entry> MakeEntries(Random& a_random, std::uint32_t a_maxActors, bool a_scaleBuckets) {
+		std::vector<PositionFile::Entry> entries;
+
+		std::uint32_t actors = 1 + a_random.Next(a_maxActors > 0 ? a_maxActors : 1);
+		for (std::uint32_t ii = 0; ii < actors; ii++) {
+			auto makeOffset = [&]() {
+				auto axis = [&](std::uint32_t a_range) { return static_cast<float>(static_cast<std::int32_t>(a_random.Next(a_range * 2 + 1)) - static_cast<std::int32_t>(a_range)) / 10.0f; };
+				return Vector3{ axis(300), axis(300), axis(100) };
+			};
+
+			entries.push_back(PositionFile::Entry{ ii, makeOffset() });
+
+			// About one file in four has scale buckets
+			if (a_scaleBuckets && a_random.Next(4u) == 0) {
+				for (float scale : kScaleBuckets) {
+					entries.push_back(PositionFile::Entry{ ii, makeOffset(), scale });
+				}
+			}
+		}
+
+		return entries;
+	}
+
+	std::size_t WritePositions(const std::filesystem::path& a_dir, const PositionOptions& a_options) {
+		std::error_code ec;
+		std::filesystem::create_directories(a_dir, ec);
+		if (a_options.player) {
+			std::filesystem::create_directories(a_dir / "Player", ec);
+		}
+
+		Random random(a_options.seed);
+
+		std::size_t written = 0;
+		for (std::size_t ii = 0; ii < a_options.count; ii++) {
+			std::string name = GetPositionName(ii);
+			if (PositionFile::Save((a_dir / (name + ".txt")).string(), MakeEntries(random, a_options.maxActors, a_options.scaleBuckets))) {
+				written++;
+			}
+
+			// Every tenth position also has a player offset
+			if (a_options.player && ii % 10 == 0) {
+				if (PositionFile::Save((a_dir / "Player" / (name + ".txt")).string(), MakeEntries(random, a_options.maxActors, false))) {
+					written++;
+				}
+			}
+		}
+
+		return written;
+	}
+
+	// Generated once per option set under the temp directory and reused by later runs
+	std::filesystem::path GetPositions(const PositionOptions& a_options) {
+		std::filesystem::path dir = std::filesystem::temp_directory_path() / "AAFDynamicPositionerCorpus" /
+			fmt::format("positions-{}-{}-{}-{}-{}", a_options.count, a_options.maxActors, a_options.scaleBuckets, a_options.player, a_options.seed);
+		std::filesystem::path stamp = dir / ".complete";
+
+		std::error_code ec;
+		if (std::filesystem::exists(stamp, ec)) {
+			return dir;
+		}
+
+		std::filesystem::remove_all(dir, ec);
+		spdlog::info("Generating {} positions in {}", a_options.count, dir.string());
+		WritePositions(dir, a_options);
+		std::ofstream(stamp).put('\n');
+		return dir;
+	}
+
+	// Actors of a scene stand within 100 units of its centre, scenes are spread over the radius
+	std::vector<Scene> MakeScenes(const SceneOptions& a_options) {
+		Random random(a_options.seed);
+
+		std::vector<Scene> scenes;
+		scenes.reserve(a_options.count);
+
+		std::uint32_t formID = 0x00100000;
+		for (std::size_t ii = 0; ii < a_options.count; ii++) {
+			Scene scene;
+			scene.sceneID = ii + 1;
+			scene.position = GetPositionName(random.Next(static_cast<std::uint32_t>(a_options.positions > 0 ? a_options.positions : 1)));
+
+			Vector3 centre{ random.Next(-a_options.radius, a_options.radius), random.Next(-a_options.radius, a_options.radius), random.Next(-500.0f, 500.0f) };
+			for (std::uint32_t jj = 0; jj < a_options.actors; jj++) {
+				Actor actor;
+				actor.formID = formID++;
+				actor.position = Vector3{ centre.x + random.Next(-100.0f, 100.0f), centre.y + random.Next(-100.0f, 100.0f), centre.z };
+				actor.rot = random.Next(0.0f, 6.2831853f);
+				actor.scale = random.Next(0.9f, 1.1f);
+				scene.actors.push_back(actor);
+			}
+
+			scenes.push_back(std::move(scene));
+		}
+
+		return scenes;
+	}
+
+	// One scene per line: id|position|formID@x,y,z@rot@scale;...
+	std::string SerializeScenes(const std::vector<Scene>& a_scenes) {
+		std::string result;
+		for (const auto& scene : a_scenes) {
+			fmt::format_to(std::back_inserter(result), "{}|{}|", scene.sceneID, scene.position);
+			for (std::size_t ii = 0; ii < scene.actors.size(); ii++) {
+				const Actor& actor = scene.actors[ii];
+				fmt::format_to(std::back_inserter(result), "{}{:08X}@{},{},{}@{}@{}", ii > 0 ? ";" : "", actor.formID, actor.position.x, actor.position.y, actor.position.z, actor.rot, actor.scale);
+			}
+			result.push_back('\n');
+		}
+		return result;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Core/PositionFile.h"
+#include "Core/Vector3.h"
+
+namespace Corpus {
+	// splitmix64, so the same seed gives the same corpus with every standard library
+	class Random {
+	public:
+		explicit Random(std::uint64_t a_seed) : state(a_seed) {}
+
+		std::uint64_t Next();
+		std::uint32_t Next(std::uint32_t a_bound);
+		float Next(float a_min, float a_max);
+
+	private:
+		std::uint64_t state;
+	};
+
+	struct PositionOptions {
+		std::size_t   count = 50000;
+		std::uint32_t maxActors = 5;
+		bool          scaleBuckets = true;
+		bool          player = true;
+		std::uint64_t seed = 1;
+	};
+
+	struct Actor {
+		std::uint32_t formID;
+		Vector3       position;
+		float         rot;
+		float         scale;
+	};
+
+	struct Scene {
+		std::uint64_t      sceneID;
+		std::string        position;
+		std::vector<Actor> actors;
+	};
+
+	struct SceneOptions {
+		std::size_t   count = 100;
+		std::uint32_t actors = 10;
+		float         radius = 10000.0f;
+		std::size_t   positions = 50000;
+		std::uint64_t seed = 1;
+	};
+
+	std::string GetPositionName(std::size_t a_index);
+	std::vector<PositionFile::Entry> MakeEntries(Random& a_random, std::uint32_t a_maxActors, bool a_scaleBuckets);
+	std::size_t WritePositions(const std::filesystem::path& a_dir, const PositionOptions& a_options);
+	std::filesystem::path GetPositions(const PositionOptions& a_options);
+	std::vector<Scene> MakeScenes(const SceneOptions& a_options);
+	std::string SerializeScenes(const std::vector<Scene>& a_scenes);
+}
@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <spdlog/sinks/stdout_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "Core/Tokenizer.h"
+#include "bench/Corpus.h"
+
+namespace {
+	void PrintUsage() {
+		std::printf(
+			"Usage:\n"
+			"  AAFDynamicPositionerCorpusGenerator positions <dir> [--count <n>] [--actors <n>] [--seed <n>] [--no-buckets] [--no-player]\n"
+			"  AAFDynamicPositionerCorpusGenerator scenes <file> [--count <n>] [--actors <n>] [--radius <units>] [--positions <n>] [--seed <n>]\n");
+	}
+}
+
+int main(int a_argc, char* a_argv[]) {
+	spdlog::set_default_logger(spdlog::stderr_logger_mt("CorpusGenerator"));
+
+	if (a_argc < 3) {
+		PrintUsage();
+		return 2;
+	}
+
+	std::string_view command = a_argv[1];
+	std::string target = a_argv[2];
+
+	Corpus::PositionOptions positionOptions;
+	Corpus::SceneOptions sceneOptions;
+
+	for (int ii = 3; ii < a_argc; ii++) {
+		std::string_view arg = a_argv[ii];
+		bool valid = true;
+		if (arg == "--count" && ii + 1 < a_argc) {
+			valid = Tokenizer::ParseNumber(a_argv[++ii], positionOptions.count);
+			sceneOptions.count = positionOptions.count;
+		}
+		else if (arg == "--actors" && ii + 1 < a_argc) {
+			valid = Tokenizer::ParseNumber(a_argv[++ii], positionOptions.maxActors);
+			sceneOptions.actors = positionOptions.maxActors;
+		}
+		else if (arg == "--seed" && ii + 1 < a_argc) {
+			valid = Tokenizer::ParseNumber(a_argv[++ii], positionOptions.seed);
+			sceneOptions.seed = positionOptions.seed;
+		}
+		else if (arg == "--radius" && ii + 1 < a_argc) {
+			valid = Tokenizer::ParseNumber(a_argv[++ii], sceneOptions.radius);
+		}
+		else if (arg == "--positions" && ii + 1 < a_argc) {
+			valid = Tokenizer::ParseNumber(a_argv[++ii], sceneOptions.positions);
+		}
+		else if (arg == "--no-buckets") {
+			positionOptions.scaleBuckets = false;
+		}
+		else if (arg == "--no-player") {
+			positionOptions.player = false;
+		}
+		else {
+			valid = false;
+		}
+
+		if (!valid) {
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	if (command == "positions") {
+		std::size_t written = Corpus::WritePositions(target, positionOptions);
+		std::printf("%zu files written\n", written);
+		return 0;
+	}
+	else if (command == "scenes") {
+		std::ofstream file(target, std::ios::trunc);
+		if (!file.is_open()) {
+			std::printf("Cannot open %s\n", target.c_str());
+			return 1;
+		}
+
+		std::string buffer = Corpus::SerializeScenes(Corpus::MakeScenes(sceneOptions));
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		std::printf("%zu scenes written\n", sceneOptions.count);
+		return file.good() ? 0 : 1;
+	}
+
+	PrintUsage();
+	return 2;
+}
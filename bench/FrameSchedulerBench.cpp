@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Core/FrameScheduler.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	constexpr float kLODDistance = 4000.0f;
+	constexpr std::uint32_t kFrameBudget = 1000;
+
+	// Stand-in for the apply of one animation change, the spin stands for the engine calls
+	void ApplyAnimationChange() {
+		auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(50);
+		while (std::chrono::steady_clock::now() < end) {}
+	}
+}
+
+// Frame time with hundreds of NPC scenes changing animation at random, reports the 99th percentile and worst frame in microseconds
+static void FrameScheduler_Frame(Bench::State& a_state) {
+	std::size_t sceneCount = static_cast<std::size_t>(a_state.Range());
+	Corpus::Random random(5);
+
+	std::vector<float> distancesSq(sceneCount);
+	for (auto& distanceSq : distancesSq) {
+		float x = random.Next(-8000.0f, 8000.0f);
+		float y = random.Next(-8000.0f, 8000.0f);
+		distanceSq = x * x + y * y;
+	}
+	distancesSq[0] = -1.0f;
+
+	auto getPriority = [&](std::uint64_t a_key) -> std::optional<float> {
+		if (distancesSq[a_key] > kLODDistance * kLODDistance) {
+			return std::nullopt;
+		}
+		return distancesSq[a_key];
+	};
+
+	FrameScheduler::Scheduler scheduler;
+	std::vector<double> frameTimes;
+	while (a_state.KeepRunning()) {
+		// About one scene in twenty changes animation every frame
+		for (std::size_t ii = 0; ii < sceneCount / 20; ii++) {
+			scheduler.Submit(random.Next(static_cast<std::uint32_t>(sceneCount)), ApplyAnimationChange);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		scheduler.Run(kFrameBudget, getPriority);
+		frameTimes.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	a_state.SetItemsProcessed(a_state.GetIterations());
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+	a_state.SetCounter("p99us", frameTimes[frameTimes.size() * 99 / 100]);
+	a_state.SetCounter("maxus", frameTimes.back());
+	a_state.SetCounter("pending", static_cast<double>(scheduler.GetCount()));
+}
+BENCHMARK(FrameScheduler_Frame, 100, 500);
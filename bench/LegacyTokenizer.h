@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+
+// Utils::Trim and Utils::GetNextData as they were before the tokenizer, kept as the reference for conformance and speed
+namespace LegacyTokenizer {
+	inline void Trim(std::string& a_str) {
+		a_str.erase(a_str.begin(), std::find_if(a_str.begin(), a_str.end(), [](int ch) {
+			return !std::isspace(ch);
+		}));
+		a_str.erase(std::find_if(a_str.rbegin(), a_str.rend(), [](int ch) {
+			return !std::isspace(ch);
+		}).base(),
+			a_str.end());
+	}
+
+	inline std::uint8_t GetNextChar(const std::string& a_line, std::uint32_t& a_index) {
+		if (a_index < a_line.length()) {
+			return a_line[a_index++];
+		}
+
+		return 0xFF;
+	}
+
+	inline std::string GetNextData(const std::string& a_line, std::uint32_t& a_index, char a_delimeter) {
+		std::uint8_t ch;
+		std::string retVal = "";
+
+		while ((ch = GetNextChar(a_line, a_index)) != 0xFF) {
+			if (ch == '#') {
+				if (a_index > 0) {
+					a_index--;
+				}
+				break;
+			}
+
+			if (a_delimeter != 0 && ch == a_delimeter) {
+				break;
+			}
+
+			retVal += static_cast<char>(ch);
+		}
+
+		Trim(retVal);
+		return retVal;
+	}
+}
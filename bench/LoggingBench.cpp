@@ -0,0 +1,37 @@
+#include <cstdint>
+#include <filesystem>
+
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include "Core/Logging.h"
+#include "bench/Bench.h"
+
+// Time the game thread spends per log line written to a file, range 0 writes synchronously, range 1 hands the line to the background thread
+static void Logging_Line(Bench::State& a_state) {
+	auto path = std::filesystem::temp_directory_path() / "AAFDynamicPositionerBench.log";
+
+	{
+		Logging::Options options;
+		options.async = a_state.Range() == 1;
+		auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path.string(), true);
+		auto log = Logging::CreateLogger("bench", std::move(sink), options);
+		// The plugin's synchronous mode flushes every line in release builds
+		if (!options.async) {
+			log->flush_on(spdlog::level::trace);
+		}
+
+		std::uint32_t line = 0;
+		while (a_state.KeepRunning()) {
+			log->info("Actor {:08X} moved to {} {} {}", line++, 1.0f, 2.0f, 3.0f);
+		}
+		a_state.SetItemsProcessed(a_state.GetIterations());
+
+		a_state.PauseTiming();
+		log->flush();
+	}
+
+	std::error_code ec;
+	std::filesystem::remove(path, ec);
+	a_state.ResumeTiming();
+}
+BENCHMARK(Logging_Line, 0, 1);
@@ -0,0 +1,33 @@
+#include <cstdint>
+#include <vector>
+
+#include "Core/OffsetBlend.h"
+#include "bench/Bench.h"
+
+// One frame of the blend kernel by number of blending actors, blends restart as they finish so the count stays constant
+static void OffsetBlend_Advance(Bench::State& a_state) {
+	std::uint32_t count = static_cast<std::uint32_t>(a_state.Range());
+
+	OffsetBlend::Blender blender;
+	for (std::uint32_t ii = 0; ii < count; ii++) {
+		blender.Start(ii, Vector3{}, Vector3{ 10.0f, 20.0f, static_cast<float>(ii) }, 0.5f + 0.01f * static_cast<float>(ii));
+	}
+
+	// A finished blend is removed after its callback, so it is restarted once the frame is done
+	std::vector<std::uint32_t> finished;
+	while (a_state.KeepRunning()) {
+		blender.Advance(1.0f / 60.0f, [&](std::uint32_t a_id, const Vector3& a_offset, bool a_finished) {
+			Bench::DoNotOptimize(a_offset);
+			if (a_finished) {
+				finished.push_back(a_id);
+			}
+		});
+
+		for (std::uint32_t id : finished) {
+			blender.Start(id, Vector3{}, Vector3{ 10.0f, 20.0f, 30.0f }, 0.5f);
+		}
+		finished.clear();
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * count);
+}
+BENCHMARK(OffsetBlend_Advance, 8, 64);
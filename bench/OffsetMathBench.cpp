@@ -0,0 +1,35 @@
+#include <vector>
+
+#include "Core/OffsetMath.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+// Goal positions of every actor of a crowd of scenes, as the positioner computes them on a position change
+static void OffsetMath_GetGoalPosition(Bench::State& a_state) {
+	Corpus::SceneOptions options;
+	options.count = 100;
+	options.actors = static_cast<std::uint32_t>(a_state.Range());
+	std::vector<Corpus::Scene> scenes = Corpus::MakeScenes(options);
+
+	Vector3 offset{ 12.5f, -3.0f, 1.5f };
+	while (a_state.KeepRunning()) {
+		for (const auto& scene : scenes) {
+			for (const auto& actor : scene.actors) {
+				Bench::DoNotOptimize(OffsetMath::GetGoalPosition(actor.position, offset, actor.rot, actor.scale, true));
+			}
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * options.count * options.actors);
+}
+BENCHMARK(OffsetMath_GetGoalPosition, 2, 10, 100);
+
+static void OffsetMath_Nudge(Bench::State& a_state) {
+	Vector3 offset{};
+	std::uint32_t axis = 0;
+	while (a_state.KeepRunning()) {
+		offset = OffsetMath::Nudge(offset, axis, 1.0f, 0.5f, 100.0f);
+		axis = (axis + 1) % 3;
+		Bench::DoNotOptimize(offset);
+	}
+}
+BENCHMARK(OffsetMath_Nudge);
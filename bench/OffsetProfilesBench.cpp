@@ -0,0 +1,33 @@
+#include <vector>
+
+#include "Core/OffsetProfiles.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+// Resolves every actor of many scenes against positions with scale buckets
+static void OffsetProfiles_Resolve(Bench::State& a_state) {
+	Corpus::Random random(34);
+
+	std::vector<std::vector<PositionFile::Entry>> positions;
+	for (int ii = 0; ii < 256; ii++) {
+		auto entries = Corpus::MakeEntries(random, static_cast<std::uint32_t>(a_state.Range()), true);
+		OffsetProfiles::Sort(entries);
+		positions.push_back(std::move(entries));
+	}
+
+	Corpus::SceneOptions options;
+	options.count = 256;
+	options.actors = static_cast<std::uint32_t>(a_state.Range());
+	std::vector<Corpus::Scene> scenes = Corpus::MakeScenes(options);
+
+	while (a_state.KeepRunning()) {
+		for (std::size_t ii = 0; ii < scenes.size(); ii++) {
+			const auto& actors = scenes[ii].actors;
+			for (std::uint32_t jj = 0; jj < actors.size(); jj++) {
+				Bench::DoNotOptimize(OffsetProfiles::Resolve(positions[ii], jj, actors[jj].scale, 0.05f));
+			}
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * scenes.size() * options.actors);
+}
+BENCHMARK(OffsetProfiles_Resolve, 2, 5);
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Core/OffsetRules.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	constexpr std::size_t kNameCount = 20000;
+
+	// 5,000 rules: exact names for every fifth position, globs per pack and animation, and regexes per pack, a few with backreferences
+	std::vector<OffsetRules::Rule> MakeRules() {
+		std::vector<OffsetRules::Rule> rules;
+		auto add = [&](OffsetRules::KIND a_kind, std::string a_pattern) {
+			rules.push_back({ a_kind, std::move(a_pattern), { { 0, Vector3{ 1.0f, 2.0f, 3.0f } } } });
+		};
+
+		for (std::size_t ii = 0; ii < 3500; ii++) {
+			std::string name = Corpus::GetPositionName(ii * 5);
+			std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			add(OffsetRules::KIND::kExact, std::move(name));
+		}
+
+		for (std::size_t ii = 0; ii < 1000; ii++) {
+			std::string name = Corpus::GetPositionName(ii * 13 + 1);
+			std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			// Keep the pack and animation, leave the last digits to the wildcard
+			add(OffsetRules::KIND::kGlob, ii % 2 == 0 ? name.substr(0, name.size() - 1) + "*" : "*" + name.substr(name.size() - 6, 4) + "?");
+		}
+
+		for (std::size_t ii = 0; ii < 500; ii++) {
+			std::string name = Corpus::GetPositionName(ii * 7 + 2);
+			std::string prefix = name.substr(0, name.rfind('_'));
+			add(OffsetRules::KIND::kRegex, ii % 50 == 0 ? fmt::format("{}_(\\d)\\1\\d", prefix) : fmt::format("{}_{}\\d{{2}}", prefix, ii % 10));
+		}
+
+		return rules;
+	}
+
+	std::vector<std::string> GetNames() {
+		std::vector<std::string> names;
+		for (std::size_t ii = 0; ii < kNameCount; ii++) {
+			names.push_back(Corpus::GetPositionName(ii * 7919 % kNameCount));
+		}
+		return names;
+	}
+}
+
+// Building the matcher from 5,000 rules, what a game load costs once the rule files are read
+static void OffsetRules_Compile(Bench::State& a_state) {
+	auto rules = MakeRules();
+
+	OffsetRules::Matcher matcher;
+	while (a_state.KeepRunning()) {
+		Bench::DoNotOptimize(matcher.Compile(rules));
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * rules.size());
+}
+BENCHMARK(OffsetRules_Compile);
+
+// Matching a position against 5,000 rules, range 0 looks up every name for the first time, range 1 finds it in the memo
+static void OffsetRules_Match(Bench::State& a_state) {
+	auto rules = MakeRules();
+	auto names = GetNames();
+
+	OffsetRules::Matcher matcher;
+	matcher.Compile(rules);
+	if (a_state.Range() == 1) {
+		OffsetRules::Entries entries;
+		for (const auto& name : names) {
+			matcher.Match(name, entries);
+		}
+	}
+
+	std::size_t next = 0;
+	std::uint64_t matched = 0;
+	OffsetRules::Entries entries;
+	while (a_state.KeepRunning()) {
+		// Compiling again empties the memo once every name was looked up
+		if (next == names.size()) {
+			next = 0;
+			if (a_state.Range() == 0) {
+				a_state.PauseTiming();
+				matcher.Compile(rules);
+				a_state.ResumeTiming();
+			}
+		}
+
+		matched += matcher.Match(names[next++], entries);
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations());
+	a_state.SetCounter("matched", static_cast<double>(matched) / static_cast<double>(a_state.GetIterations()));
+}
+BENCHMARK(OffsetRules_Match, 0, 1);
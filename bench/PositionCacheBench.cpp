@@ -0,0 +1,57 @@
+#include <vector>
+
+#include "Core/PositionCache.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	std::vector<PositionCache::Directory> GetDirectories(std::size_t a_count) {
+		Corpus::PositionOptions options;
+		options.count = a_count;
+
+		std::filesystem::path dir = Corpus::GetPositions(options);
+		return { { dir, false }, { dir / "Player", true } };
+	}
+}
+
+// Wall time of a full prewarm of 20000 files by worker count, the files are in the page cache after the first run
+static void PositionCache_Prewarm(Bench::State& a_state) {
+	std::vector<PositionCache::Directory> directories = GetDirectories(20000);
+	std::uint32_t threads = static_cast<std::uint32_t>(a_state.Range());
+
+	PositionCache::Stats stats;
+	while (a_state.KeepRunning()) {
+		a_state.PauseTiming();
+		PositionCache::Clear();
+		a_state.ResumeTiming();
+
+		stats = PositionCache::Prewarm(directories, threads, 0, {});
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * stats.files);
+	a_state.SetCounter("files", static_cast<double>(stats.files));
+
+	PositionCache::Clear();
+}
+BENCHMARK(PositionCache_Prewarm, 1, 2, 4, 8);
+
+// A lookup served from a prewarmed cache, which replaces the file open on the script thread
+static void PositionCache_Find(Bench::State& a_state) {
+	PositionCache::Clear();
+	PositionCache::Prewarm(GetDirectories(1000), 4, 0, {});
+
+	std::vector<std::string> names;
+	for (std::size_t ii = 0; ii < 1000; ii += 7) {
+		names.push_back(Corpus::GetPositionName(ii));
+	}
+
+	std::vector<PositionFile::Entry> entries;
+	while (a_state.KeepRunning()) {
+		for (const auto& name : names) {
+			Bench::DoNotOptimize(PositionCache::Find(name, false, entries));
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * names.size());
+
+	PositionCache::Clear();
+}
+BENCHMARK(PositionCache_Find);
@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Core/PositionFile.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	std::string MakeBuffer(std::size_t a_files) {
+		Corpus::Random random(1);
+
+		std::string buffer;
+		for (std::size_t ii = 0; ii < a_files; ii++) {
+			buffer += PositionFile::Serialize(Corpus::MakeEntries(random, 5, true));
+		}
+		return buffer;
+	}
+
+	std::vector<std::string> ListFiles(std::size_t a_count) {
+		Corpus::PositionOptions options;
+		options.count = a_count;
+		options.player = false;
+
+		std::vector<std::string> result;
+		for (const auto& entry : std::filesystem::directory_iterator(Corpus::GetPositions(options))) {
+			if (entry.path().extension() == ".txt") {
+				result.push_back(entry.path().string());
+			}
+		}
+		return result;
+	}
+}
+
+static void PositionFile_Parse(Bench::State& a_state) {
+	std::string buffer = MakeBuffer(static_cast<std::size_t>(a_state.Range()));
+	while (a_state.KeepRunning()) {
+		Bench::DoNotOptimize(PositionFile::Parse(buffer));
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * buffer.size());
+}
+BENCHMARK(PositionFile_Parse, 1, 100);
+
+static void PositionFile_Serialize(Bench::State& a_state) {
+	std::vector<PositionFile::Entry> entries = PositionFile::Parse(MakeBuffer(static_cast<std::size_t>(a_state.Range())));
+	while (a_state.KeepRunning()) {
+		Bench::DoNotOptimize(PositionFile::Serialize(entries));
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * entries.size());
+}
+BENCHMARK(PositionFile_Serialize, 1, 100);
+
+// Reads a whole generated position folder, 50000 files is the size of a large library
+static void PositionFile_LoadCorpus(Bench::State& a_state) {
+	std::vector<std::string> files = ListFiles(static_cast<std::size_t>(a_state.Range()));
+	std::vector<PositionFile::Entry> entries;
+	while (a_state.KeepRunning()) {
+		for (const auto& file : files) {
+			PositionFile::Load(file, entries);
+			Bench::DoNotOptimize(entries.data());
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * files.size());
+}
+BENCHMARK(PositionFile_LoadCorpus, 1000, 50000);
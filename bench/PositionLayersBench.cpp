@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Core/PositionLayers.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	constexpr float       kBucketSize = 0.05f;
+	constexpr std::size_t kPositionCount = 10000;
+
+	// Every layer holds a share of the positions, higher layers fewer and with fewer actors, like packs overridden by user edits
+	std::vector<PositionLayers::Positions> MakeLayers(std::size_t a_layerCount) {
+		Corpus::Random random(9);
+		std::vector<PositionLayers::Positions> layers(a_layerCount);
+		for (std::size_t ii = 0; ii < a_layerCount; ii++) {
+			std::size_t stride = ii + 1;
+			for (std::size_t position = 0; position < kPositionCount; position += stride) {
+				PositionLayers::Entries entries;
+				for (std::uint32_t actor = 0; actor < 3; actor++) {
+					if (random.Next(2) == 0) {
+						entries.push_back({ actor, Vector3{ random.Next(-50.0f, 50.0f), random.Next(-50.0f, 50.0f), random.Next(-50.0f, 50.0f) } });
+					}
+				}
+				layers[ii].emplace(PositionLayers::MakeKey(Corpus::GetPositionName(position)), std::move(entries));
+			}
+		}
+		return layers;
+	}
+
+	std::vector<PositionLayers::Layer> GetLayers(std::size_t a_layerCount) {
+		std::vector<PositionLayers::Layer> layers;
+		for (std::size_t ii = 0; ii < a_layerCount; ii++) {
+			layers.push_back({ "Layer" + std::to_string(ii), ii + 1 == a_layerCount });
+		}
+		return layers;
+	}
+}
+
+// Merging 10k positions by number of layers, what a game load costs once the files are read
+static void PositionLayers_Build(Bench::State& a_state) {
+	std::size_t layerCount = static_cast<std::size_t>(a_state.Range());
+	auto contents = MakeLayers(layerCount);
+
+	// Resetting frees the previous merge outside the timed part
+	PositionLayers::Index index;
+	std::vector<PositionLayers::Positions> copy;
+	while (a_state.KeepRunning()) {
+		a_state.PauseTiming();
+		copy = contents;
+		index.Reset(GetLayers(layerCount), kBucketSize);
+		a_state.ResumeTiming();
+
+		for (std::size_t ii = 0; ii < layerCount; ii++) {
+			index.Assign(ii, std::move(copy[ii]));
+		}
+		Bench::DoNotOptimize(index.GetPositionCount());
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * kPositionCount);
+}
+BENCHMARK(PositionLayers_Build, 1, 4);
+
+// A scene's lookup by number of layers, the merged index keeps it a single probe
+static void PositionLayers_Find(Bench::State& a_state) {
+	std::size_t layerCount = static_cast<std::size_t>(a_state.Range());
+	auto contents = MakeLayers(layerCount);
+
+	PositionLayers::Index index;
+	index.Reset(GetLayers(layerCount), kBucketSize);
+	for (std::size_t ii = 0; ii < layerCount; ii++) {
+		index.Assign(ii, std::move(contents[ii]));
+	}
+
+	std::vector<std::string> names;
+	for (std::size_t ii = 0; ii < 1024; ii++) {
+		names.push_back(Corpus::GetPositionName(ii * 7 % kPositionCount));
+	}
+
+	std::size_t next = 0;
+	PositionLayers::Entries entries;
+	while (a_state.KeepRunning()) {
+		std::size_t ii = next++;
+		Bench::DoNotOptimize(index.Find(names[ii % names.size()], ii % 2 == 0, entries));
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations());
+}
+BENCHMARK(PositionLayers_Find, 1, 4);
@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+// Only built with the tools, the path of the tool comes from the build
+#ifdef POSITION_TOOL_PATH
+
+namespace {
+#	if defined(_WIN32)
+	constexpr const char* kNullDevice = "NUL";
+#	else
+	constexpr const char* kNullDevice = "/dev/null";
+#	endif
+
+	// The generated tree holds 100000 positions and a Player copy of every tenth
+	std::filesystem::path GetTree() {
+		Corpus::PositionOptions options;
+		options.count = 100000;
+		return Corpus::GetPositions(options);
+	}
+
+	bool RunTool(const std::string& a_args) {
+		std::string command = fmt::format("\"{}\" {} > {}", POSITION_TOOL_PATH, a_args, kNullDevice);
+		if (std::system(command.c_str()) != 0) {
+			spdlog::error("Command failed: {}", command);
+			return false;
+		}
+		return true;
+	}
+}
+
+// A full scan of the tree by thread count, the files are in the page cache after the first run
+static void PositionTool_Scan(Bench::State& a_state) {
+	std::filesystem::path tree = GetTree();
+	std::string args = fmt::format("scan --threads {} \"{}\"", a_state.Range(), tree.string());
+
+	while (a_state.KeepRunning()) {
+		if (!RunTool(args)) {
+			return;
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * 110000);
+}
+BENCHMARK(PositionTool_Scan, 1, 4, 8);
+
+// The whole tree into one snapshot file
+static void PositionTool_Export(Bench::State& a_state) {
+	std::filesystem::path tree = GetTree();
+	std::filesystem::path output = std::filesystem::temp_directory_path() / "AAFDynamicPositionerCorpus" / "export.txt";
+	std::string args = fmt::format("export --threads {} \"{}\" \"{}\"", a_state.Range(), tree.string(), output.string());
+
+	while (a_state.KeepRunning()) {
+		if (!RunTool(args)) {
+			return;
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * 110000);
+
+	std::error_code ec;
+	std::filesystem::remove(output, ec);
+}
+BENCHMARK(PositionTool_Export, 1, 8);
+
+#endif
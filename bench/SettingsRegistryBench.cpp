@@ -0,0 +1,93 @@
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Core/SettingsRegistry.h"
+#include "Core/Tokenizer.h"
+#include "bench/Bench.h"
+
+using namespace std::literals;
+
+namespace {
+	using Tokenizer::ToLower;
+
+	const std::vector<std::string_view> kNames = { "bSeparatePlayerOffset"sv, "iNPCPositionerType"sv, "fMoveSpeed"sv, "FSTICKDEADZONE"sv, "bPrewarm"sv, "iPrefetchCount"sv, "fOffsetLimit"sv, "iLogIntervalSec"sv, "sUnknownKey"sv };
+}
+
+static void SettingsRegistry_FindID(Bench::State& a_state) {
+	while (a_state.KeepRunning()) {
+		for (std::string_view name : kNames) {
+			Bench::DoNotOptimize(Settings::FindID(name));
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * kNames.size());
+}
+BENCHMARK(SettingsRegistry_FindID);
+
+// Reads of the hot settings that the per frame movement and apply paths do
+static void SettingsRegistry_Get(Bench::State& a_state) {
+	while (a_state.KeepRunning()) {
+		Bench::DoNotOptimize(Settings::GetFloat(Settings::ID::kMoveSpeed));
+		Bench::DoNotOptimize(Settings::GetUInt(Settings::ID::kNPCPositionerType));
+		Bench::DoNotOptimize(Settings::GetBool(Settings::ID::kSeparatePlayerOffset));
+	}
+}
+BENCHMARK(SettingsRegistry_Get);
+
+// The same reads while another thread keeps writing, as when the MCM changes a value during a scene
+static void SettingsRegistry_GetContended(Bench::State& a_state) {
+	std::jthread writer([](std::stop_token a_token) {
+		for (int ii = 0; !a_token.stop_requested(); ii++) {
+			Settings::SetValue(Settings::ID::kMoveSpeed, ii % 2 ? 5.0 : 6.0);
+		}
+	});
+
+	while (a_state.KeepRunning()) {
+		Bench::DoNotOptimize(Settings::GetFloat(Settings::ID::kMoveSpeed));
+		Bench::DoNotOptimize(Settings::GetUInt(Settings::ID::kNPCPositionerType));
+		Bench::DoNotOptimize(Settings::GetBool(Settings::ID::kSeparatePlayerOffset));
+	}
+
+	writer.request_stop();
+	writer.join();
+	Settings::ResetValue(Settings::ID::kMoveSpeed);
+}
+BENCHMARK(SettingsRegistry_GetContended);
+
+// The lookup a plain map would do, lowercasing the name first, for comparison with the perfect hash
+static void SettingsRegistry_FindIDMap(Bench::State& a_state) {
+	std::unordered_map<std::string, Settings::ID> map;
+	for (std::string_view name : kNames) {
+		if (auto id = Settings::FindID(name)) {
+			map.emplace(ToLower(name), *id);
+		}
+	}
+
+	while (a_state.KeepRunning()) {
+		for (std::string_view name : kNames) {
+			auto it = map.find(ToLower(name));
+			Bench::DoNotOptimize(it);
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * kNames.size());
+}
+BENCHMARK(SettingsRegistry_FindIDMap);
+
+// An MCM file padded with unknown keys, parsed in one pass
+static void SettingsRegistry_ParseINI(Bench::State& a_state) {
+	std::string content;
+	for (std::int64_t ii = 0; ii < a_state.Range(); ii++) {
+		content += fmt::format("[Section{}]\nsUnknown{}=1 ; comment\n", ii % 7, ii);
+	}
+	content += "[Movement]\nfMoveSpeed=10\nfNudgeStep=2\n[Settings]\nbSeparatePlayerOffset=1\n";
+
+	while (a_state.KeepRunning()) {
+		Bench::DoNotOptimize(Settings::ParseINI(content));
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * content.size());
+}
+BENCHMARK(SettingsRegistry_ParseINI, 10, 1000);
@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <vector>
+
+#include "Core/ShadowState.h"
+#include "bench/Bench.h"
+
+namespace {
+	struct Spell {};
+
+	struct Reference {
+		std::uint32_t formID = 0;
+		std::uint16_t refScale = 100;
+		float         position[3]{};
+		bool          hasSpell = false;
+	};
+
+	// Stand-in engine whose calls cost a fixed amount of work, roughly a relocated call into the game
+	struct Engine {
+		using Reference = ::Reference;
+		using Spell = ::Spell;
+
+		static void Work() {
+			for (std::uint32_t ii = 0; ii < 64; ii++) {
+				Bench::DoNotOptimize(ii);
+			}
+		}
+
+		std::uint32_t GetID(Reference* a_refr) { return a_refr->formID; }
+		bool HasSpell(Reference* a_actor, Spell*) { Work(); return a_actor->hasSpell; }
+		void AddSpell(Reference* a_actor, Spell*) { Work(); a_actor->hasSpell = true; }
+		void RemoveSpell(Reference* a_actor, Spell*) { Work(); a_actor->hasSpell = false; }
+		void SetRefScale(Reference* a_refr, float a_scale) { Work(); a_refr->refScale = static_cast<std::uint16_t>(a_scale * 100.0f); }
+		std::uint16_t GetRefScale(Reference* a_refr) { return a_refr->refScale; }
+		void ModPos(Reference* a_refr, char a_axis, float a_value) { Work(); a_refr->position[a_axis - 'X'] = a_value; }
+		float GetPosition(Reference* a_refr, std::size_t a_axis) { return a_refr->position[a_axis]; }
+	};
+
+	// One animation change of a scene: scale, cleared highlight and a position per axis for every actor, then the selection's highlight
+	template <class Mutator>
+	void ChangeAnimation(Mutator& a_mutator, std::vector<Reference>& a_actors, Spell* a_spell) {
+		for (auto& actor : a_actors) {
+			a_mutator.SetRefScale(&actor, 1.0f);
+			a_mutator.RemoveSpell(&actor, a_spell);
+			a_mutator.ModPos(&actor, 'X', 10.0f);
+			a_mutator.ModPos(&actor, 'Y', 20.0f);
+			a_mutator.ModPos(&actor, 'Z', 0.0f);
+		}
+		a_mutator.AddSpell(&a_actors[0], a_spell);
+	}
+}
+
+// Animation changes of a 5 actor scene calling the engine directly and through the shadow state
+static void ShadowState_ChangeAnimation(Bench::State& a_state) {
+	std::vector<Reference> actors(5);
+	for (std::uint32_t ii = 0; ii < actors.size(); ii++) {
+		actors[ii].formID = ii + 1;
+	}
+
+	Spell spell;
+	Engine engine;
+	ShadowState::Tracker<Engine> tracker;
+	bool tracked = a_state.Range() != 0;
+
+	while (a_state.KeepRunning()) {
+		if (tracked) {
+			ChangeAnimation(tracker, actors, &spell);
+		}
+		else {
+			ChangeAnimation(engine, actors, &spell);
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * actors.size());
+
+	if (tracked) {
+		std::uint64_t requested = 0;
+		std::uint64_t elided = 0;
+		for (std::uint32_t ii = 0; ii < ShadowState::kTotal; ii++) {
+			requested += tracker.GetCounter(static_cast<ShadowState::MUTATOR>(ii)).requested;
+			elided += tracker.GetCounter(static_cast<ShadowState::MUTATOR>(ii)).elided;
+		}
+		a_state.SetCounter("elided", requested ? static_cast<double>(elided) / static_cast<double>(requested) : 0.0);
+	}
+}
+BENCHMARK(ShadowState_ChangeAnimation, 0, 1);
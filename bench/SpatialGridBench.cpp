@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "Core/SpatialGrid.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	constexpr float kCellSize = 512.0f;
+
+	// 1,000 actors spread over 100 scenes, the size of a busy settlement save
+	const std::vector<Corpus::Actor>& GetActors() {
+		static const std::vector<Corpus::Actor> actors = []() {
+			Corpus::SceneOptions options;
+			options.count = 100;
+			options.actors = 10;
+
+			std::vector<Corpus::Actor> result;
+			for (const auto& scene : Corpus::MakeScenes(options)) {
+				result.insert(result.end(), scene.actors.begin(), scene.actors.end());
+			}
+			return result;
+		}();
+		return actors;
+	}
+
+	// Where the player stands when picking an actor, somewhere around one of the scenes
+	std::vector<Vector3> GetQueries(std::size_t a_count) {
+		const auto& actors = GetActors();
+		Corpus::Random random(3);
+		std::vector<Vector3> queries;
+		for (std::size_t ii = 0; ii < a_count; ii++) {
+			const Vector3& position = actors[random.Next(static_cast<std::uint32_t>(actors.size()))].position;
+			queries.push_back(Vector3{ position.x + random.Next(-1000.0f, 1000.0f), position.y + random.Next(-1000.0f, 1000.0f), position.z + random.Next(-100.0f, 100.0f) });
+		}
+		return queries;
+	}
+
+	SpatialGrid::Grid MakeGrid() {
+		SpatialGrid::Grid grid(kCellSize);
+		for (const auto& actor : GetActors()) {
+			grid.Update(actor.formID, actor.position);
+		}
+		return grid;
+	}
+}
+
+// Nearest actor to a point, range 0 scans every actor like the lookup did before the grid, range 1 uses the grid
+static void SpatialGrid_FindNearest(Bench::State& a_state) {
+	const auto& actors = GetActors();
+	auto grid = MakeGrid();
+	auto queries = GetQueries(1024);
+
+	std::size_t index = 0;
+	while (a_state.KeepRunning()) {
+		const Vector3& query = queries[index++ % queries.size()];
+		if (a_state.Range() == 0) {
+			std::optional<std::uint32_t> result;
+			float bestDistanceSq = std::numeric_limits<float>::max();
+			for (const auto& actor : actors) {
+				float dx = actor.position.x - query.x;
+				float dy = actor.position.y - query.y;
+				float dz = actor.position.z - query.z;
+				float distanceSq = dx * dx + dy * dy + dz * dz;
+				if (distanceSq < bestDistanceSq) {
+					bestDistanceSq = distanceSq;
+					result = actor.formID;
+				}
+			}
+			Bench::DoNotOptimize(result);
+		}
+		else {
+			Bench::DoNotOptimize(grid.FindNearest(query));
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations());
+}
+BENCHMARK(SpatialGrid_FindNearest, 0, 1);
+
+// Crosshair pick along a ray by maximum distance
+static void SpatialGrid_FindNearestToRay(Bench::State& a_state) {
+	auto grid = MakeGrid();
+	auto queries = GetQueries(1024);
+	float maxDistance = static_cast<float>(a_state.Range());
+
+	std::size_t index = 0;
+	while (a_state.KeepRunning()) {
+		const Vector3& origin = queries[index % queries.size()];
+		const Vector3& target = queries[(index + 1) % queries.size()];
+		index++;
+		Bench::DoNotOptimize(grid.FindNearestToRay(origin, Vector3{ target.x - origin.x, target.y - origin.y, 0.0f }, 100.0f, maxDistance));
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations());
+}
+BENCHMARK(SpatialGrid_FindNearestToRay, 1000, 5000);
+
+// An animation change moving every actor of one scene, most moves stay inside their cell
+static void SpatialGrid_Update(Bench::State& a_state) {
+	const auto& actors = GetActors();
+	auto grid = MakeGrid();
+	Corpus::Random random(5);
+
+	std::size_t scene = 0;
+	while (a_state.KeepRunning()) {
+		std::size_t first = (scene++ % 100) * 10;
+		for (std::size_t ii = first; ii < first + 10; ii++) {
+			const Vector3& position = actors[ii].position;
+			grid.Update(actors[ii].formID, Vector3{ position.x + random.Next(-50.0f, 50.0f), position.y + random.Next(-50.0f, 50.0f), position.z });
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * 10);
+}
+BENCHMARK(SpatialGrid_Update);
@@ -0,0 +1,20 @@
+#include "Core/Telemetry.h"
+#include "bench/Bench.h"
+
+// The cost a game thread pays per event, with telemetry off and on
+static void Telemetry_Push(Bench::State& a_state) {
+	bool enabled = a_state.Range() != 0;
+	if (enabled && !Telemetry::Start()) {
+		return;
+	}
+
+	std::uint32_t formID = 0;
+	while (a_state.KeepRunning()) {
+		Telemetry::Push(Telemetry::EVENT::kApplyOffset, 1, formID++, Vector3{ 1.0f, 2.0f, 3.0f }, 12, "Leito_Doggy_001");
+	}
+
+	if (enabled) {
+		Telemetry::Stop();
+	}
+}
+BENCHMARK(Telemetry_Push, 0, 1);
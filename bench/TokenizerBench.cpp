@@ -0,0 +1,83 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/PositionFile.h"
+#include "Core/Tokenizer.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+#include "bench/LegacyTokenizer.h"
+
+namespace {
+	const std::string& GetBuffer() {
+		static const std::string buffer = [] {
+			Corpus::Random random(1);
+
+			std::string result;
+			for (std::size_t ii = 0; ii < 1000; ii++) {
+				result += "# " + Corpus::GetPositionName(ii) + "\r\n";
+				result += PositionFile::Serialize(Corpus::MakeEntries(random, 5, true));
+			}
+			return result;
+		}();
+		return buffer;
+	}
+}
+
+static void Tokenizer_LineReader(Bench::State& a_state) {
+	const std::string& buffer = GetBuffer();
+	while (a_state.KeepRunning()) {
+		Tokenizer::LineReader reader(buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			Bench::DoNotOptimize(line);
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * buffer.size());
+}
+BENCHMARK(Tokenizer_LineReader);
+
+static void Tokenizer_GetNextData(Bench::State& a_state) {
+	const std::string& buffer = GetBuffer();
+	while (a_state.KeepRunning()) {
+		Tokenizer::LineReader reader(buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			std::size_t index = 0;
+			while (index < line.size()) {
+				Bench::DoNotOptimize(Tokenizer::GetNextData(line, index, ','));
+				if (index < line.size() && line[index] == '#') {
+					break;
+				}
+			}
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * buffer.size());
+}
+BENCHMARK(Tokenizer_GetNextData);
+
+// The same fields read with the string building GetNextData the tokenizer replaced
+static void Tokenizer_LegacyGetNextData(Bench::State& a_state) {
+	const std::string& buffer = GetBuffer();
+
+	std::vector<std::string> lines;
+	Tokenizer::LineReader reader(buffer);
+	std::string_view view;
+	while (reader.Next(view)) {
+		lines.emplace_back(view);
+	}
+
+	while (a_state.KeepRunning()) {
+		for (const auto& line : lines) {
+			std::uint32_t index = 0;
+			while (index < line.size()) {
+				Bench::DoNotOptimize(LegacyTokenizer::GetNextData(line, index, ','));
+				if (index < line.size() && line[index] == '#') {
+					break;
+				}
+			}
+		}
+	}
+	a_state.SetItemsProcessed(a_state.GetIterations() * buffer.size());
+}
+BENCHMARK(Tokenizer_LegacyGetNextData);
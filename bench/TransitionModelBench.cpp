@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Core/TransitionModel.h"
+#include "bench/Bench.h"
+#include "bench/Corpus.h"
+
+namespace {
+	// Each position mostly moves on to the next stage of its animation pack and sometimes jumps to another pack
+	std::vector<std::string> MakeSequence(std::size_t a_length, std::size_t a_packs) {
+		Corpus::Random random(1);
+
+		std::vector<std::string> sequence;
+		std::size_t pack = 0;
+		std::size_t stage = 0;
+		for (std::size_t ii = 0; ii < a_length; ii++) {
+			// The model keeps names in lower case
+			std::string name = Corpus::GetPositionName(pack * 4 + stage);
+			std::transform(name.begin(), name.end(), name.begin(), [](unsigned char a_ch) { return static_cast<char>(std::tolower(a_ch)); });
+			sequence.push_back(std::move(name));
+
+			std::uint32_t roll = random.Next(100u);
+			if (roll < 70) {
+				stage = (stage + 1) % 4;
+			}
+			else if (roll < 85) {
+				stage = random.Next(4u);
+			}
+			else {
+				pack = random.Next(static_cast<std::uint32_t>(a_packs));
+				stage = 0;
+			}
+		}
+		return sequence;
+	}
+}
+
+// Share of animation changes whose position was prefetched, by prefetch count, with the model learning as the session goes
+static void TransitionModel_HitRate(Bench::State& a_state) {
+	std::vector<std::string> sequence = MakeSequence(20000, 50);
+	std::size_t count = static_cast<std::size_t>(a_state.Range());
+
+	std::uint64_t hits = 0;
+	std::uint64_t total = 0;
+	while (a_state.KeepRunning()) {
+		a_state.PauseTiming();
+		TransitionModel::Clear();
+		a_state.ResumeTiming();
+
+		std::unordered_set<std::string> prefetched;
+		for (std::size_t ii = 1; ii < sequence.size(); ii++) {
+			if (prefetched.contains(sequence[ii])) {
+				hits++;
+			}
+			total++;
+
+			TransitionModel::Observe(sequence[ii - 1], sequence[ii]);
+			prefetched.clear();
+			for (auto& prediction : TransitionModel::Predict(sequence[ii], count)) {
+				prefetched.insert(std::move(prediction));
+			}
+		}
+	}
+	a_state.SetItemsProcessed(total);
+	a_state.SetCounter("hitRate", total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0);
+
+	TransitionModel::Clear();
+}
+BENCHMARK(TransitionModel_HitRate, 1, 2, 4);
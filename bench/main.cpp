@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+#include "Core/Tokenizer.h"
+#include "bench/Bench.h"
+
+namespace {
+	constexpr double kDefaultMinTime = 0.5;
+	constexpr double kDefaultTolerance = 4.0;
+
+	// Baselines are name|nanoseconds per iteration lines, written with --write-baseline
+	bool LoadBaselines(const std::string& a_path, std::map<std::string, double>& a_baselines) {
+		std::string buffer;
+		if (!Tokenizer::ReadFile(a_path, buffer)) {
+			return false;
+		}
+
+		Tokenizer::LineReader reader(buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			line = Tokenizer::Trim(line);
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+
+			std::size_t index = 0;
+			std::string_view name = Tokenizer::GetNextData(line, index, '|');
+			std::string_view time = Tokenizer::GetNextData(line, index, 0);
+
+			double ns;
+			if (name.empty() || !Tokenizer::ParseNumber(time, ns)) {
+				spdlog::error("Cannot read the baseline: {}", line);
+				continue;
+			}
+
+			a_baselines[std::string(name)] = ns;
+		}
+
+		return true;
+	}
+
+	std::string MakeFilter(const std::map<std::string, double>& a_baselines) {
+		std::string filter = "^(";
+		bool first = true;
+		for (const auto& [name, ns] : a_baselines) {
+			if (!first) {
+				filter.push_back('|');
+			}
+			first = false;
+
+			for (char ch : name) {
+				if (std::string_view("\\^$.|?*+()[]{}").find(ch) != std::string_view::npos) {
+					filter.push_back('\\');
+				}
+				filter.push_back(ch);
+			}
+		}
+		filter += ")$";
+		return filter;
+	}
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: AAFDynamicPositionerBench [--filter <regex>] [--min-time <sec>] [--list]\n"
+			"                                 [--baseline <file> [--tolerance <factor>]] [--write-baseline <file>]\n");
+	}
+}
+
+// --baseline runs only the listed benchmarks and fails when one is slower than its baseline times the tolerance
+int main(int a_argc, char* a_argv[]) {
+	std::string filter;
+	std::string baselinePath;
+	std::string writePath;
+	double minTime = kDefaultMinTime;
+	double tolerance = kDefaultTolerance;
+
+	for (int ii = 1; ii < a_argc; ii++) {
+		std::string_view arg = a_argv[ii];
+		bool valid = true;
+		if (arg == "--filter" && ii + 1 < a_argc) {
+			filter = a_argv[++ii];
+		}
+		else if (arg == "--min-time" && ii + 1 < a_argc) {
+			valid = Tokenizer::ParseNumber(a_argv[++ii], minTime) && minTime > 0.0;
+		}
+		else if (arg == "--baseline" && ii + 1 < a_argc) {
+			baselinePath = a_argv[++ii];
+		}
+		else if (arg == "--tolerance" && ii + 1 < a_argc) {
+			valid = Tokenizer::ParseNumber(a_argv[++ii], tolerance) && tolerance > 0.0;
+		}
+		else if (arg == "--write-baseline" && ii + 1 < a_argc) {
+			writePath = a_argv[++ii];
+		}
+		else if (arg == "--list") {
+			for (const auto& name : Bench::List()) {
+				std::printf("%s\n", name.c_str());
+			}
+			return 0;
+		}
+		else {
+			valid = false;
+		}
+
+		if (!valid) {
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	std::map<std::string, double> baselines;
+	if (!baselinePath.empty()) {
+		if (!LoadBaselines(baselinePath, baselines) || baselines.empty()) {
+			std::printf("Cannot read the baselines: %s\n", baselinePath.c_str());
+			return 2;
+		}
+
+		if (filter.empty()) {
+			filter = MakeFilter(baselines);
+		}
+	}
+
+	std::vector<Bench::Result> results = Bench::Run(filter, minTime);
+
+	if (!writePath.empty()) {
+		std::ofstream file(writePath, std::ios::trunc);
+		file << "# name|ns per iteration\n";
+		for (const auto& result : results) {
+			file << result.name << '|' << static_cast<std::uint64_t>(result.ns + 0.5) << '\n';
+		}
+	}
+
+	std::size_t failed = 0;
+	for (const auto& [name, ns] : baselines) {
+		auto it = std::find_if(results.begin(), results.end(), [&](const Bench::Result& a_result) { return a_result.name == name; });
+		if (it == results.end()) {
+			std::printf("MISSING %s\n", name.c_str());
+			failed++;
+		}
+		else if (it->ns > ns * tolerance) {
+			std::printf("SLOWER  %s: %.0f ns, baseline %.0f ns\n", name.c_str(), it->ns, ns);
+			failed++;
+		}
+	}
+
+	if (!baselines.empty()) {
+		std::printf("%zu of %zu benchmarks within %.1fx of the baseline\n", baselines.size() - failed, baselines.size(), tolerance);
+	}
+
+	return failed > 0 ? 1 : 0;
+}
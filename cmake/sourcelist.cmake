@@ -1,14 +1,142 @@
-set(SOURCES
-	src/Positioners.h
-	src/Positioners.cpp
-	src/PositionData.h
-	src/PositionData.cpp
-	src/Scaleforms.h
-	src/Scaleforms.cpp
-	src/Inputs.h
-	src/Inputs.cpp
-	src/Utils.h
-	src/Utils.cpp
-	src/PCH.h
-	src/main.cpp
-)
+set(CORE_SOURCES
+	src/Core/Async.h
+	src/Core/Async.cpp
+	src/Core/FormTable.h
+	src/Core/FormTable.cpp
+	src/Core/FrameScheduler.h
+	src/Core/FrameScheduler.cpp
+	src/Core/InputSnapshot.h
+	src/Core/Logging.h
+	src/Core/Logging.cpp
+	src/Core/MemoryTracker.h
+	src/Core/MemoryTracker.cpp
+	src/Core/MenuArgs.h
+	src/Core/MenuArgs.cpp
+	src/Core/MovementCurve.h
+	src/Core/MovementCurve.cpp
+	src/Core/OffsetBlend.h
+	src/Core/OffsetBlend.cpp
+	src/Core/OffsetMath.h
+	src/Core/OffsetMath.cpp
+	src/Core/OffsetProfiles.h
+	src/Core/OffsetProfiles.cpp
+	src/Core/OffsetRules.h
+	src/Core/OffsetRules.cpp
+	src/Core/PathCache.h
+	src/Core/PositionBaker.h
+	src/Core/PositionBaker.cpp
+	src/Core/PositionCache.h
+	src/Core/PositionCache.cpp
+	src/Core/PositionFile.h
+	src/Core/PositionFile.cpp
+	src/Core/PositionLayers.h
+	src/Core/PositionLayers.cpp
+	src/Core/SettingsRegistry.h
+	src/Core/SettingsRegistry.cpp
+	src/Core/ShadowState.h
+	src/Core/SpatialGrid.h
+	src/Core/SpatialGrid.cpp
+	src/Core/Telemetry.h
+	src/Core/Telemetry.cpp
+	src/Core/Tokenizer.h
+	src/Core/Tokenizer.cpp
+	src/Core/TransitionModel.h
+	src/Core/TransitionModel.cpp
+	src/Core/Vector3.h
+)
+
+set(SOURCES
+	src/Positioners.h
+	src/Positioners.cpp
+	src/PositionData.h
+	src/PositionData.cpp
+	src/Scaleforms.h
+	src/Scaleforms.cpp
+	src/Settings.h
+	src/Settings.cpp
+	src/Executors.h
+	src/Executors.cpp
+	src/Forms.h
+	src/Forms.cpp
+	src/Inputs.h
+	src/Inputs.cpp
+	src/Movements.h
+	src/Movements.cpp
+	src/Mutators.h
+	src/Mutators.cpp
+	src/Prefetchers.h
+	src/Prefetchers.cpp
+	src/Utils.h
+	src/Utils.cpp
+	src/PCH.h
+	src/main.cpp
+)
+
+set(TELEMETRY_READER_SOURCES
+	tools/TelemetryReader/main.cpp
+)
+
+set(POSITION_TOOL_SOURCES
+	tools/PositionTool/main.cpp
+)
+
+set(CORPUS_SOURCES
+	bench/Corpus.h
+	bench/Corpus.cpp
+	bench/LegacyTokenizer.h
+)
+
+set(CORPUS_GENERATOR_SOURCES
+	bench/CorpusGenerator.cpp
+)
+
+set(TEST_SOURCES
+	tests/TestUtils.h
+	tests/AsyncTests.cpp
+	tests/FormTableTests.cpp
+	tests/FrameSchedulerTests.cpp
+	tests/InputSnapshotTests.cpp
+	tests/LoggingTests.cpp
+	tests/MemoryTrackerTests.cpp
+	tests/MenuArgsTests.cpp
+	tests/MovementCurveTests.cpp
+	tests/OffsetBlendTests.cpp
+	tests/OffsetMathTests.cpp
+	tests/OffsetProfilesTests.cpp
+	tests/OffsetRulesTests.cpp
+	tests/PathCacheTests.cpp
+	tests/PositionBakerTests.cpp
+	tests/PositionCacheTests.cpp
+	tests/PositionFileTests.cpp
+	tests/PositionLayersTests.cpp
+	tests/SettingsRegistryTests.cpp
+	tests/ShadowStateTests.cpp
+	tests/SpatialGridTests.cpp
+	tests/TelemetryTests.cpp
+	tests/TokenizerTests.cpp
+	tests/TransitionModelTests.cpp
+)
+
+set(BENCH_SOURCES
+	bench/Bench.h
+	bench/Bench.cpp
+	bench/main.cpp
+	bench/AsyncBench.cpp
+	bench/BindingBench.cpp
+	bench/FrameSchedulerBench.cpp
+	bench/LoggingBench.cpp
+	bench/OffsetBlendBench.cpp
+	bench/OffsetMathBench.cpp
+	bench/OffsetProfilesBench.cpp
+	bench/OffsetRulesBench.cpp
+	bench/PositionCacheBench.cpp
+	bench/PositionFileBench.cpp
+	bench/PositionLayersBench.cpp
+	bench/PositionToolBench.cpp
+	bench/SettingsRegistryBench.cpp
+	bench/ShadowStateBench.cpp
+	bench/SpatialGridBench.cpp
+	bench/TelemetryBench.cpp
+	bench/TokenizerBench.cpp
+	bench/TransitionModelBench.cpp
+)
@@ -0,0 +1,37 @@
+#include "Core/Async.h"
+
+namespace Async {
+	ThreadExecutor::ThreadExecutor() :
+		thread([this](std::stop_token a_token) { Run(a_token); }) {}
+
+	ThreadExecutor::~ThreadExecutor() {
+		thread.request_stop();
+		condition.notify_all();
+		thread.join();
+	}
+
+	void ThreadExecutor::Post(std::function<void()> a_work) {
+		{
+			std::lock_guard guard(lock);
+			queue.push_back(std::move(a_work));
+		}
+		condition.notify_one();
+	}
+
+	void ThreadExecutor::Run(std::stop_token a_token) {
+		std::unique_lock guard(lock);
+		for (;;) {
+			condition.wait(guard, a_token, [this]() { return !queue.empty(); });
+			if (queue.empty()) {
+				return;
+			}
+
+			std::function<void()> work = std::move(queue.front());
+			queue.pop_front();
+
+			guard.unlock();
+			work();
+			guard.lock();
+		}
+	}
+}
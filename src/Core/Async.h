@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Async {
+	class Executor {
+	public:
+		virtual ~Executor() = default;
+
+		virtual void Post(std::function<void()> a_work) = 0;
+	};
+
+	// Runs posted work in FIFO order on one dedicated thread, work still queued at destruction is run before the thread exits
+	class ThreadExecutor : public Executor {
+	public:
+		ThreadExecutor();
+		~ThreadExecutor() override;
+
+		ThreadExecutor(const ThreadExecutor&) = delete;
+		ThreadExecutor& operator=(const ThreadExecutor&) = delete;
+
+		void Post(std::function<void()> a_work) override;
+
+	private:
+		void Run(std::stop_token a_token);
+
+		std::mutex                        lock;
+		std::condition_variable_any       condition;
+		std::deque<std::function<void()>> queue;
+		std::jthread                      thread;
+	};
+
+	// Fire and forget coroutine, the frame is destroyed when the body finishes
+	struct Task {
+		struct promise_type {
+			Task get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+	};
+
+	struct ResumeOn {
+		Executor& executor;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> a_handle) const { executor.Post([a_handle]() { a_handle.resume(); }); }
+		void await_resume() const noexcept {}
+	};
+}
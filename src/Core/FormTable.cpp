@@ -0,0 +1,21 @@
+#include "Core/FormTable.h"
+
+#include <charconv>
+
+using namespace std::literals;
+
+namespace FormTable {
+	// Hex with an optional 0x prefix, the load order byte is dropped and malformed input gives 0
+	std::uint32_t ParseFormID(std::string_view a_formID) {
+		if (a_formID.starts_with("0x"sv) || a_formID.starts_with("0X"sv)) {
+			a_formID.remove_prefix(2);
+		}
+
+		std::uint32_t retID = 0;
+		auto [ptr, ec] = std::from_chars(a_formID.data(), a_formID.data() + a_formID.size(), retID, 16);
+		if (ec != std::errc()) {
+			return 0;
+		}
+		return retID & 0xFFFFFF;
+	}
+}
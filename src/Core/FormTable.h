@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+namespace FormTable {
+	struct Identifier {
+		std::string_view pluginName;
+		std::uint32_t    formID;
+	};
+
+	std::uint32_t ParseFormID(std::string_view a_formID);
+
+	// Forms indexed like their identifiers, resolved in one pass through a lookup of (formID, pluginName) to Form*
+	template <class Form, std::size_t N>
+	class Table {
+	public:
+		explicit constexpr Table(const std::array<Identifier, N>& a_identifiers) : identifiers(a_identifiers) {}
+
+		template <class Lookup>
+		std::size_t Resolve(Lookup&& a_lookup) {
+			std::size_t missing = 0;
+			for (std::size_t ii = 0; ii < N; ii++) {
+				forms[ii] = a_lookup(identifiers[ii].formID, identifiers[ii].pluginName);
+				if (!forms[ii]) {
+					spdlog::error("Cannot find the form {:08X} in {}", identifiers[ii].formID, identifiers[ii].pluginName);
+					missing++;
+				}
+			}
+
+			resolved = true;
+			return missing;
+		}
+
+		bool IsResolved() const { return resolved; }
+		Form* Get(std::size_t a_index) const { return a_index < N ? forms[a_index] : nullptr; }
+
+	private:
+		std::array<Identifier, N> identifiers;
+		std::array<Form*, N>      forms{};
+		bool                      resolved = false;
+	};
+}
@@ -0,0 +1,54 @@
+#include "Core/FrameScheduler.h"
+
+#include <algorithm>
+
+namespace FrameScheduler {
+	void Scheduler::Submit(std::uint64_t a_key, std::function<void()> a_work) {
+		auto it = std::find_if(jobs.begin(), jobs.end(), [a_key](const Job& a_job) { return a_job.key == a_key; });
+		if (it != jobs.end()) {
+			it->work = std::move(a_work);
+			return;
+		}
+
+		jobs.push_back({ a_key, std::move(a_work) });
+	}
+
+	void Scheduler::Cancel(std::uint64_t a_key) {
+		std::erase_if(jobs, [a_key](const Job& a_job) { return a_job.key == a_key; });
+	}
+
+	void Scheduler::Clear() {
+		jobs.clear();
+		order.clear();
+	}
+
+	std::size_t Scheduler::RunOrdered(std::uint32_t a_budget) {
+		std::sort(order.begin(), order.end(), [](const Entry& a_lhs, const Entry& a_rhs) {
+			return a_lhs.priority < a_rhs.priority;
+		});
+
+		auto startTime = std::chrono::steady_clock::now();
+		auto budget = std::chrono::microseconds(a_budget);
+
+		std::size_t ranCount = 0;
+		for (const auto& entry : order) {
+			if (ranCount > 0 && a_budget > 0 && std::chrono::steady_clock::now() - startTime >= budget) {
+				break;
+			}
+
+			// The job is taken out first, it may submit or cancel jobs itself
+			auto it = std::find_if(jobs.begin(), jobs.end(), [&entry](const Job& a_job) { return a_job.key == entry.key; });
+			if (it == jobs.end()) {
+				continue;
+			}
+
+			std::function<void()> work = std::move(it->work);
+			jobs.erase(it);
+
+			work();
+			ranCount++;
+		}
+
+		return ranCount;
+	}
+}
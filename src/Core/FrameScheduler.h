@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace FrameScheduler {
+	// Holds at most one pending job per key, newer work for a key replaces the older one
+	class Scheduler {
+	public:
+		void Submit(std::uint64_t a_key, std::function<void()> a_work);
+		void Cancel(std::uint64_t a_key);
+		void Clear();
+		bool IsEmpty() const { return jobs.empty(); }
+		std::size_t GetCount() const { return jobs.size(); }
+
+		// a_getPriority(key) returns the priority of a job, lower runs first, or nullopt to defer it to a later frame.
+		// Jobs run in priority order until the budget in microseconds is used up, at least one job runs per call and a budget of 0 is unlimited.
+		template <class F>
+		std::size_t Run(std::uint32_t a_budget, F&& a_getPriority) {
+			order.clear();
+			for (const auto& job : jobs) {
+				std::optional<float> priority = a_getPriority(job.key);
+				if (priority) {
+					order.push_back({ *priority, job.key });
+				}
+			}
+
+			return RunOrdered(a_budget);
+		}
+
+	private:
+		struct Job {
+			std::uint64_t         key;
+			std::function<void()> work;
+		};
+
+		struct Entry {
+			float         priority;
+			std::uint64_t key;
+		};
+
+		std::size_t RunOrdered(std::uint32_t a_budget);
+
+		std::vector<Job>   jobs;
+		std::vector<Entry> order;
+	};
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace InputSnapshot {
+	// Remembers whether each input handler was enabled when a menu took over the input, so closing it restores them as they were.
+	// The items are kept between uses, a take over after the first one only overwrites them in place without allocating.
+	template <class Handler>
+	class Snapshot {
+	public:
+		// Disables every handler from a_first on and records its previous state, taking over twice keeps the first record
+		template <class Handlers>
+		void Disable(const Handlers& a_handlers, std::size_t a_first) {
+			if (active) {
+				return;
+			}
+
+			std::size_t count = a_handlers.size() > a_first ? a_handlers.size() - a_first : 0;
+			items.resize(count);
+			for (std::size_t ii = 0; ii < count; ii++) {
+				Handler* handler = a_handlers[a_first + ii];
+				items[ii] = { handler, handler && handler->inputEventHandlingEnabled };
+				if (handler) {
+					handler->inputEventHandlingEnabled = false;
+				}
+			}
+
+			active = true;
+		}
+
+		// Handlers added while disabled are left as they are, a list that changed in between falls back to a search
+		template <class Handlers>
+		void Restore(const Handlers& a_handlers, std::size_t a_first) {
+			if (!active) {
+				return;
+			}
+
+			for (std::size_t ii = a_first; ii < a_handlers.size(); ii++) {
+				Handler* handler = a_handlers[ii];
+				if (!handler) {
+					continue;
+				}
+
+				std::size_t index = ii - a_first;
+				if (index < items.size() && items[index].handler == handler) {
+					handler->inputEventHandlingEnabled = items[index].enabled;
+					continue;
+				}
+
+				auto it = std::find_if(items.begin(), items.end(), [&](const Item& a_item) { return a_item.handler == handler; });
+				if (it != items.end()) {
+					handler->inputEventHandlingEnabled = it->enabled;
+				}
+			}
+
+			active = false;
+		}
+
+		bool IsActive() const { return active; }
+		std::size_t GetCount() const { return items.size(); }
+
+	private:
+		struct Item {
+			Handler* handler;
+			bool     enabled;
+		};
+
+		std::vector<Item> items;
+		bool              active = false;
+	};
+}
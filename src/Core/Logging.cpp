@@ -0,0 +1,206 @@
+#include "Core/Logging.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/dup_filter_sink.h>
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#endif
+
+namespace Logging {
+	// Drops lines over the per second limit and reports how many were dropped once the next second starts
+	class RateLimitSink : public spdlog::sinks::base_sink<std::mutex> {
+	public:
+		RateLimitSink(spdlog::sink_ptr a_sink, std::uint32_t a_limit) :
+			sink(std::move(a_sink)), limit(a_limit) {}
+
+	protected:
+		void sink_it_(const spdlog::details::log_msg& a_msg) override {
+			auto now = std::chrono::steady_clock::now();
+			if (now - windowStart >= std::chrono::seconds(1)) {
+				windowStart = now;
+				count = 0;
+
+				if (dropped > 0) {
+					auto message = fmt::format("Dropped {} log lines over the rate limit", dropped);
+					sink->log(spdlog::details::log_msg(a_msg.logger_name, spdlog::level::warn, message));
+					dropped = 0;
+				}
+			}
+
+			if (a_msg.level < spdlog::level::critical && count >= limit) {
+				dropped++;
+				return;
+			}
+
+			count++;
+			sink->log(a_msg);
+		}
+
+		void flush_() override {
+			sink->flush();
+		}
+
+		void set_pattern_(const std::string& a_pattern) override {
+			sink->set_pattern(a_pattern);
+		}
+
+		void set_formatter_(std::unique_ptr<spdlog::formatter> a_formatter) override {
+			sink->set_formatter(std::move(a_formatter));
+		}
+
+	private:
+		spdlog::sink_ptr                      sink;
+		std::uint32_t                         limit;
+		std::uint32_t                         count = 0;
+		std::uint64_t                         dropped = 0;
+		std::chrono::steady_clock::time_point windowStart{};
+	};
+
+	std::atomic<std::uint64_t> g_flushCount = 0;
+
+	// Counts the flushes the writer thread finished, so the crash path can wait for its own without joining the thread
+	class FlushCountSink : public spdlog::sinks::sink {
+	public:
+		explicit FlushCountSink(spdlog::sink_ptr a_sink) :
+			sink(std::move(a_sink)) {}
+
+		void log(const spdlog::details::log_msg& a_msg) override {
+			sink->log(a_msg);
+		}
+
+		void flush() override {
+			sink->flush();
+			g_flushCount.fetch_add(1, std::memory_order_release);
+		}
+
+		void set_pattern(const std::string& a_pattern) override {
+			sink->set_pattern(a_pattern);
+		}
+
+		void set_formatter(std::unique_ptr<spdlog::formatter> a_formatter) override {
+			sink->set_formatter(std::move(a_formatter));
+		}
+
+	private:
+		spdlog::sink_ptr sink;
+	};
+
+	constexpr std::chrono::milliseconds kCrashFlushTimeout{ 1000 };
+
+	std::atomic_flag g_shutdown = ATOMIC_FLAG_INIT;
+	std::atomic_flag g_crashed = ATOMIC_FLAG_INIT;
+	std::terminate_handler g_prevTerminateHandler = nullptr;
+
+	std::shared_ptr<spdlog::logger> CreateLogger(const std::string& a_name, spdlog::sink_ptr a_sink, const Options& a_options) {
+		spdlog::sink_ptr sink = std::move(a_sink);
+		if (a_options.rateLimit > 0) {
+			sink = std::make_shared<RateLimitSink>(std::move(sink), a_options.rateLimit);
+		}
+
+		if (a_options.duplicateWindow.count() > 0) {
+			auto dupFilter = std::make_shared<spdlog::sinks::dup_filter_sink_mt>(a_options.duplicateWindow);
+			dupFilter->add_sink(std::move(sink));
+			sink = std::move(dupFilter);
+		}
+
+		if (!a_options.async) {
+			return std::make_shared<spdlog::logger>(a_name, std::move(sink));
+		}
+
+		spdlog::init_thread_pool(a_options.queueSize, 1);
+		sink = std::make_shared<FlushCountSink>(std::move(sink));
+		auto log = std::make_shared<spdlog::async_logger>(a_name, std::move(sink), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+
+		// Errors are written out right behind the line, everything else at least once a second
+		log->flush_on(spdlog::level::err);
+		spdlog::flush_every(std::chrono::seconds(1));
+		return log;
+	}
+
+	// Drains the queue and stops the background thread, safe to call more than once
+	void Shutdown() {
+		if (g_shutdown.test_and_set()) {
+			return;
+		}
+
+		if (auto log = spdlog::default_logger()) {
+			log->flush();
+		}
+		spdlog::shutdown();
+	}
+
+	// Hands the pending lines of the default logger to the writer thread and waits at most a_timeout for them to be written.
+	// Nothing is joined or torn down, a writer that is stuck or was the crashing thread only costs the timeout.
+	bool FlushPending(std::chrono::milliseconds a_timeout) {
+		auto* log = spdlog::default_logger_raw();
+		if (!log) {
+			return true;
+		}
+
+		if (!dynamic_cast<spdlog::async_logger*>(log)) {
+			log->flush();
+			return true;
+		}
+
+		// The queue drops the oldest lines when full, so posting the flush never blocks
+		std::uint64_t before = g_flushCount.load(std::memory_order_acquire);
+		log->flush();
+
+		auto deadline = std::chrono::steady_clock::now() + a_timeout;
+		while (g_flushCount.load(std::memory_order_acquire) == before) {
+			if (std::chrono::steady_clock::now() >= deadline) {
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	}
+
+	void FlushOnCrash() {
+		if (!g_crashed.test_and_set()) {
+			FlushPending(kCrashFlushTimeout);
+		}
+	}
+
+	void OnTerminate() {
+		FlushOnCrash();
+
+		if (g_prevTerminateHandler) {
+			g_prevTerminateHandler();
+		}
+		std::abort();
+	}
+
+#ifdef _WIN32
+	LPTOP_LEVEL_EXCEPTION_FILTER g_prevExceptionFilter = nullptr;
+
+	LONG WINAPI OnUnhandledException(EXCEPTION_POINTERS* a_info) {
+		FlushOnCrash();
+
+		return g_prevExceptionFilter ? g_prevExceptionFilter(a_info) : EXCEPTION_CONTINUE_SEARCH;
+	}
+#endif
+
+	// Pending lines are written out before the process goes down. A synchronous logger has nothing queued, so the
+	// unhandled exception filter of the game and other plugins is only replaced for the async one.
+	void InstallCrashHandler(const Options& a_options) {
+		g_prevTerminateHandler = std::set_terminate(OnTerminate);
+
+#ifdef _WIN32
+		if (a_options.async) {
+			g_prevExceptionFilter = SetUnhandledExceptionFilter(OnUnhandledException);
+		}
+#else
+		(void)a_options;
+#endif
+	}
+}
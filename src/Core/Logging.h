@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+namespace Logging {
+	struct Options {
+		// Hands lines to a background thread through a bounded queue that drops the oldest lines when full
+		bool                      async = false;
+		std::size_t               queueSize = 8192;
+		// Identical consecutive lines within the window are collapsed into one
+		std::chrono::milliseconds duplicateWindow{ 5000 };
+		// Lines per second below critical, 0 disables the limit
+		std::uint32_t             rateLimit = 0;
+	};
+
+	std::shared_ptr<spdlog::logger> CreateLogger(const std::string& a_name, spdlog::sink_ptr a_sink, const Options& a_options);
+	void InstallCrashHandler(const Options& a_options);
+	bool FlushPending(std::chrono::milliseconds a_timeout);
+	void Shutdown();
+}
@@ -0,0 +1,86 @@
+#include "Core/MemoryTracker.h"
+
+#include <array>
+
+namespace MemoryTracker {
+	constexpr std::size_t kCategoryCount = static_cast<std::size_t>(CATEGORY::kTotal);
+
+	constexpr std::array<std::string_view, kCategoryCount> kNames{
+		"Actors",
+		"Scenes",
+		"Localizations",
+		"PositionCache",
+		"RuleMemo"
+	};
+
+	std::array<std::atomic<std::size_t>, kCategoryCount> g_budgets{};
+
+	std::array<CountingResource, kCategoryCount>& GetResources() {
+		// Never destroyed, so containers with static storage can still free into it while the process exits
+		static auto* resources = new std::array<CountingResource, kCategoryCount>();
+		return *resources;
+	}
+
+	Usage CountingResource::GetUsage() const {
+		return { current.load(std::memory_order_relaxed), peak.load(std::memory_order_relaxed), allocations.load(std::memory_order_relaxed) };
+	}
+
+	std::size_t CountingResource::GetCurrent() const {
+		return current.load(std::memory_order_relaxed);
+	}
+
+	void CountingResource::ResetPeak() {
+		peak.store(current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	void* CountingResource::do_allocate(std::size_t a_bytes, std::size_t a_alignment) {
+		void* result = upstream->allocate(a_bytes, a_alignment);
+
+		std::size_t now = current.fetch_add(a_bytes, std::memory_order_relaxed) + a_bytes;
+		std::size_t highest = peak.load(std::memory_order_relaxed);
+		while (now > highest && !peak.compare_exchange_weak(highest, now, std::memory_order_relaxed)) {}
+
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return result;
+	}
+
+	void CountingResource::do_deallocate(void* a_ptr, std::size_t a_bytes, std::size_t a_alignment) {
+		upstream->deallocate(a_ptr, a_bytes, a_alignment);
+		current.fetch_sub(a_bytes, std::memory_order_relaxed);
+	}
+
+	bool CountingResource::do_is_equal(const std::pmr::memory_resource& a_other) const noexcept {
+		return this == &a_other;
+	}
+
+	std::pmr::memory_resource* GetResource(CATEGORY a_category) {
+		return &GetResources()[static_cast<std::size_t>(a_category)];
+	}
+
+	Usage GetUsage(CATEGORY a_category) {
+		return GetResources()[static_cast<std::size_t>(a_category)].GetUsage();
+	}
+
+	std::string_view GetName(CATEGORY a_category) {
+		return a_category < CATEGORY::kTotal ? kNames[static_cast<std::size_t>(a_category)] : std::string_view{};
+	}
+
+	void ResetPeaks() {
+		for (auto& resource : GetResources()) {
+			resource.ResetPeak();
+		}
+	}
+
+	void SetBudget(CATEGORY a_category, std::size_t a_bytes) {
+		g_budgets[static_cast<std::size_t>(a_category)].store(a_bytes, std::memory_order_relaxed);
+	}
+
+	std::size_t GetBudget(CATEGORY a_category) {
+		return g_budgets[static_cast<std::size_t>(a_category)].load(std::memory_order_relaxed);
+	}
+
+	bool IsOverBudget(CATEGORY a_category) {
+		std::size_t budget = GetBudget(a_category);
+		return budget > 0 && GetResources()[static_cast<std::size_t>(a_category)].GetCurrent() > budget;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+
+namespace MemoryTracker {
+	enum class CATEGORY : std::uint32_t {
+		kActors,
+		kScenes,
+		kLocalizations,
+		kPositionCache,
+		kRuleMemo,
+		kTotal
+	};
+
+	struct Usage {
+		std::size_t   current = 0;
+		std::size_t   peak = 0;
+		std::uint64_t allocations = 0;
+	};
+
+	// Forwards to the upstream resource and counts the bytes it hands out
+	class CountingResource : public std::pmr::memory_resource {
+	public:
+		explicit CountingResource(std::pmr::memory_resource* a_upstream = std::pmr::new_delete_resource()) : upstream(a_upstream) {}
+
+		Usage GetUsage() const;
+		std::size_t GetCurrent() const;
+		void ResetPeak();
+
+	private:
+		void* do_allocate(std::size_t a_bytes, std::size_t a_alignment) override;
+		void do_deallocate(void* a_ptr, std::size_t a_bytes, std::size_t a_alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& a_other) const noexcept override;
+
+		std::pmr::memory_resource* upstream;
+		std::atomic<std::size_t>   current = 0;
+		std::atomic<std::size_t>   peak = 0;
+		std::atomic<std::uint64_t> allocations = 0;
+	};
+
+	// Containers of a category allocate through its resource, which lives for the whole process
+	std::pmr::memory_resource* GetResource(CATEGORY a_category);
+	Usage GetUsage(CATEGORY a_category);
+	std::string_view GetName(CATEGORY a_category);
+	void ResetPeaks();
+
+	// A budget of 0 is unlimited, containers check it after they grow and evict what they can
+	void SetBudget(CATEGORY a_category, std::size_t a_bytes);
+	std::size_t GetBudget(CATEGORY a_category);
+	bool IsOverBudget(CATEGORY a_category);
+}
@@ -0,0 +1,79 @@
+#include "Core/MenuArgs.h"
+
+#include <cmath>
+
+#include "Core/MovementCurve.h"
+
+namespace MenuArgs {
+	std::optional<float> GetNumber(const Value& a_value) {
+		if (a_value.type != TYPE::kNumber) {
+			return std::nullopt;
+		}
+
+		float number = static_cast<float>(a_value.number);
+		if (!std::isfinite(number)) {
+			return std::nullopt;
+		}
+
+		return number;
+	}
+
+	std::uint32_t GetAxis(const Value& a_value) {
+		if (a_value.type != TYPE::kString) {
+			return MovementCurve::kAxis_None;
+		}
+
+		if (a_value.string == "X") {
+			return MovementCurve::kAxis_X;
+		}
+		else if (a_value.string == "Y") {
+			return MovementCurve::kAxis_Y;
+		}
+		else if (a_value.string == "Z") {
+			return MovementCurve::kAxis_Z;
+		}
+
+		return MovementCurve::kAxis_None;
+	}
+
+	std::optional<AxisValue> ParseSetPosition(std::span<const Value> a_args) {
+		if (a_args.size() != 2) {
+			return std::nullopt;
+		}
+
+		std::uint32_t axis = GetAxis(a_args[0]);
+		std::optional<float> value = GetNumber(a_args[1]);
+		if (axis == MovementCurve::kAxis_None || !value) {
+			return std::nullopt;
+		}
+
+		return AxisValue{ axis, *value };
+	}
+
+	std::optional<Vector3> ParseSetOffsets(std::span<const Value> a_args) {
+		if (a_args.size() != 3) {
+			return std::nullopt;
+		}
+
+		std::optional<float> x = GetNumber(a_args[0]);
+		std::optional<float> y = GetNumber(a_args[1]);
+		std::optional<float> z = GetNumber(a_args[2]);
+		if (!x || !y || !z) {
+			return std::nullopt;
+		}
+
+		return Vector3{ *x, *y, *z };
+	}
+
+	std::optional<AxisValue> ParseNudgeOffset(std::span<const Value> a_args) {
+		return ParseSetPosition(a_args);
+	}
+
+	std::uint32_t ParseActiveAxis(std::span<const Value> a_args) {
+		if (a_args.empty()) {
+			return MovementCurve::kAxis_None;
+		}
+
+		return GetAxis(a_args[0]);
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "Core/Vector3.h"
+
+namespace MenuArgs {
+	// At most this many arguments are looked at, none of the menu functions takes more
+	constexpr std::size_t kMaxArgs = 4;
+
+	enum class TYPE : std::uint32_t {
+		kUndefined,
+		kNumber,
+		kString,
+		kOther
+	};
+
+	// A Scaleform argument reduced to what the handlers check, ints and uints are numbers
+	struct Value {
+		TYPE             type = TYPE::kUndefined;
+		double           number = 0.0;
+		std::string_view string;
+	};
+
+	struct AxisValue {
+		std::uint32_t axis;
+		float         value;
+	};
+
+	// Each function returns nullopt when the arguments are invalid, numbers must be finite
+	std::uint32_t GetAxis(const Value& a_value);
+	std::optional<AxisValue> ParseSetPosition(std::span<const Value> a_args);
+	std::optional<Vector3> ParseSetOffsets(std::span<const Value> a_args);
+	std::optional<AxisValue> ParseNudgeOffset(std::span<const Value> a_args);
+	// No argument clears the active axis, anything but an axis name clears it as well
+	std::uint32_t ParseActiveAxis(std::span<const Value> a_args);
+}
@@ -0,0 +1,113 @@
+#include "Core/MovementCurve.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MovementCurve {
+	float CoalesceInput(bool a_leftHeld, bool a_rightHeld, float a_stick, float a_deadzone) {
+		float input = 0.0f;
+		if (a_rightHeld) {
+			input += 1.0f;
+		}
+		if (a_leftHeld) {
+			input -= 1.0f;
+		}
+
+		// Rescale the stick past the deadzone so that the curve starts from zero instead of jumping
+		float stickAbs = std::fabs(a_stick);
+		if (stickAbs > a_deadzone && a_deadzone < 1.0f) {
+			float stickInput = (std::min(stickAbs, 1.0f) - a_deadzone) / (1.0f - a_deadzone);
+			input += std::copysign(stickInput * stickInput, a_stick);
+		}
+
+		return std::clamp(input, -1.0f, 1.0f);
+	}
+
+	// Integrates v(t) = min(speed + accel * t, maxSpeed) over the interval instead of sampling it at the end
+	float Integrate(const Config& a_config, float a_startTime, float a_interval) {
+		float maxSpeed = std::max(a_config.maxSpeed, a_config.speed);
+		float endTime = a_startTime + a_interval;
+		if (a_config.acceleration <= 0.0f) {
+			return a_config.speed * a_interval;
+		}
+
+		float rampEnd = (maxSpeed - a_config.speed) / a_config.acceleration;
+		float rampStop = std::min(endTime, rampEnd);
+		float distance = 0.0f;
+		if (a_startTime < rampStop) {
+			distance += a_config.speed * (rampStop - a_startTime) + 0.5f * a_config.acceleration * (rampStop * rampStop - a_startTime * a_startTime);
+		}
+		if (endTime > rampEnd) {
+			distance += maxSpeed * (endTime - std::max(a_startTime, rampEnd));
+		}
+
+		return distance;
+	}
+
+	void Integrator::SetAxis(std::uint32_t a_axis) {
+		if (a_axis == axis) {
+			return;
+		}
+
+		// Axis changes restart the acceleration curve so the new axis does not inherit the old speed
+		axis = a_axis < kAxis_None ? a_axis : kAxis_None;
+		heldTime = 0.0f;
+		lastInput = 0.0f;
+	}
+
+	bool Integrator::Update(const Config& a_config, float a_interval, Vector3& a_delta) {
+		if (!IsEnabled() || a_interval <= 0.0f) {
+			return false;
+		}
+
+		float input = CoalesceInput(leftHeld, rightHeld, stick, a_config.deadzone);
+		if (input == 0.0f) {
+			heldTime = 0.0f;
+			lastInput = 0.0f;
+			return false;
+		}
+
+		if ((input > 0.0f) != (lastInput > 0.0f) || lastInput == 0.0f) {
+			heldTime = 0.0f;
+		}
+
+		float step = Integrate(a_config, heldTime, a_interval) * input;
+		heldTime += a_interval;
+		lastInput = input;
+
+		a_delta = Vector3{};
+		switch (axis) {
+		case kAxis_X:
+			a_delta.x = step;
+			break;
+		case kAxis_Y:
+			a_delta.y = step;
+			break;
+		case kAxis_Z:
+			a_delta.z = step;
+			break;
+		}
+
+		pendingSave = true;
+		return true;
+	}
+
+	// The offset is saved once the input is released rather than on every frame of the movement
+	bool Integrator::ConsumePendingSave() {
+		if (!pendingSave || lastInput != 0.0f) {
+			return false;
+		}
+
+		pendingSave = false;
+		return true;
+	}
+
+	void Integrator::Reset() {
+		axis = kAxis_None;
+		leftHeld = false;
+		rightHeld = false;
+		stick = 0.0f;
+		heldTime = 0.0f;
+		lastInput = 0.0f;
+	}
+}
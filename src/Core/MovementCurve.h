@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Core/Vector3.h"
+
+namespace MovementCurve {
+	enum AXIS : std::uint32_t {
+		kAxis_X = 0,
+		kAxis_Y,
+		kAxis_Z,
+		kAxis_None
+	};
+
+	struct Config {
+		float speed = 5.0f;
+		float acceleration = 20.0f;
+		float maxSpeed = 40.0f;
+		float deadzone = 0.2f;
+	};
+
+	float CoalesceInput(bool a_leftHeld, bool a_rightHeld, float a_stick, float a_deadzone);
+	float Integrate(const Config& a_config, float a_startTime, float a_interval);
+
+	// Input events only record the latest state, Update turns whatever is held at the end of a frame into one delta
+	class Integrator {
+	public:
+		bool IsEnabled() const { return axis != kAxis_None; }
+		std::uint32_t GetAxis() const { return axis; }
+
+		void SetAxis(std::uint32_t a_axis);
+		void SetLeftHeld(bool a_isDown) { leftHeld = a_isDown; }
+		void SetRightHeld(bool a_isDown) { rightHeld = a_isDown; }
+		void SetStick(float a_value) { stick = a_value; }
+
+		bool Update(const Config& a_config, float a_interval, Vector3& a_delta);
+		bool ConsumePendingSave();
+		void Reset();
+
+	private:
+		std::uint32_t axis = kAxis_None;
+		bool          leftHeld = false;
+		bool          rightHeld = false;
+		float         stick = 0.0f;
+		float         heldTime = 0.0f;
+		float         lastInput = 0.0f;
+		bool          pendingSave = false;
+	};
+}
@@ -0,0 +1,81 @@
+#include "Core/OffsetBlend.h"
+
+#include <algorithm>
+
+namespace OffsetBlend {
+	// Smoothstep, starts and ends with zero velocity
+	float Ease(float a_t) {
+		a_t = std::clamp(a_t, 0.0f, 1.0f);
+		return a_t * a_t * (3.0f - 2.0f * a_t);
+	}
+
+	// A running blend of the same id restarts from the given offset, returns false when there is no room left
+	bool Blender::Start(std::uint32_t a_id, const Vector3& a_from, const Vector3& a_to, float a_duration) {
+		std::size_t index = std::find(ids.begin(), ids.begin() + count, a_id) - ids.begin();
+		if (index == count) {
+			if (count >= kCapacity) {
+				return false;
+			}
+			count++;
+		}
+
+		ids[index] = a_id;
+		elapsed[index] = 0.0f;
+		duration[index] = std::max(a_duration, 0.0f);
+		fromX[index] = a_from.x;
+		fromY[index] = a_from.y;
+		fromZ[index] = a_from.z;
+		toX[index] = a_to.x;
+		toY[index] = a_to.y;
+		toZ[index] = a_to.z;
+		currentX[index] = a_from.x;
+		currentY[index] = a_from.y;
+		currentZ[index] = a_from.z;
+		return true;
+	}
+
+	void Blender::Cancel(std::uint32_t a_id) {
+		std::size_t index = std::find(ids.begin(), ids.begin() + count, a_id) - ids.begin();
+		if (index < count) {
+			Remove(index);
+		}
+	}
+
+	// One pass over the arrays, finished blends are then set to their target so they settle exactly
+	void Blender::Step(float a_interval) {
+		for (std::size_t ii = 0; ii < count; ii++) {
+			elapsed[ii] += a_interval;
+			float t = duration[ii] > 0.0f ? elapsed[ii] / duration[ii] : 1.0f;
+			float w = Ease(t);
+			currentX[ii] = fromX[ii] + (toX[ii] - fromX[ii]) * w;
+			currentY[ii] = fromY[ii] + (toY[ii] - fromY[ii]) * w;
+			currentZ[ii] = fromZ[ii] + (toZ[ii] - fromZ[ii]) * w;
+		}
+
+		for (std::size_t ii = 0; ii < count; ii++) {
+			if (elapsed[ii] >= duration[ii]) {
+				currentX[ii] = toX[ii];
+				currentY[ii] = toY[ii];
+				currentZ[ii] = toZ[ii];
+			}
+		}
+	}
+
+	// The last blend takes the removed slot, the order of blends does not matter
+	void Blender::Remove(std::size_t a_index) {
+		std::size_t last = count - 1;
+		ids[a_index] = ids[last];
+		elapsed[a_index] = elapsed[last];
+		duration[a_index] = duration[last];
+		fromX[a_index] = fromX[last];
+		fromY[a_index] = fromY[last];
+		fromZ[a_index] = fromZ[last];
+		toX[a_index] = toX[last];
+		toY[a_index] = toY[last];
+		toZ[a_index] = toZ[last];
+		currentX[a_index] = currentX[last];
+		currentY[a_index] = currentY[last];
+		currentZ[a_index] = currentZ[last];
+		count--;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Core/Vector3.h"
+
+namespace OffsetBlend {
+	constexpr std::size_t kCapacity = 64;
+
+	float Ease(float a_t);
+
+	// Blends are kept as structure of arrays in fixed storage, so advancing them never allocates
+	class Blender {
+	public:
+		bool Start(std::uint32_t a_id, const Vector3& a_from, const Vector3& a_to, float a_duration);
+		void Cancel(std::uint32_t a_id);
+		void Clear() { count = 0; }
+		bool IsEmpty() const { return count == 0; }
+		std::size_t GetCount() const { return count; }
+
+		// Calls a_func(id, offset, finished) for every blend, a finished blend reports exactly its target and is removed
+		template <class F>
+		void Advance(float a_interval, F&& a_func) {
+			Step(a_interval);
+
+			for (std::size_t ii = 0; ii < count;) {
+				bool finished = elapsed[ii] >= duration[ii];
+				a_func(ids[ii], Vector3{ currentX[ii], currentY[ii], currentZ[ii] }, finished);
+
+				if (finished) {
+					Remove(ii);
+				}
+				else {
+					ii++;
+				}
+			}
+		}
+
+	private:
+		void Step(float a_interval);
+		void Remove(std::size_t a_index);
+
+		std::size_t                          count = 0;
+		std::array<std::uint32_t, kCapacity> ids{};
+		std::array<float, kCapacity>         elapsed{};
+		std::array<float, kCapacity>         duration{};
+		std::array<float, kCapacity>         fromX{};
+		std::array<float, kCapacity>         fromY{};
+		std::array<float, kCapacity>         fromZ{};
+		std::array<float, kCapacity>         toX{};
+		std::array<float, kCapacity>         toY{};
+		std::array<float, kCapacity>         toZ{};
+		std::array<float, kCapacity>         currentX{};
+		std::array<float, kCapacity>         currentY{};
+		std::array<float, kCapacity>         currentZ{};
+	};
+}
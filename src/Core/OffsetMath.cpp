@@ -0,0 +1,65 @@
+#include "Core/OffsetMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OffsetMath {
+	// Axis 0, 1 and 2 are x, y and z, any other axis has no component
+	float* GetComponent(Vector3& a_offset, std::uint32_t a_axis) {
+		switch (a_axis) {
+		case 0:
+			return &a_offset.x;
+		case 1:
+			return &a_offset.y;
+		case 2:
+			return &a_offset.z;
+		default:
+			return nullptr;
+		}
+	}
+
+	Vector3 Rotate(const Vector3& a_offset, float a_rot) {
+		float cosRot = std::cos(a_rot);
+		float sinRot = std::sin(a_rot);
+		return Vector3{ a_offset.x * cosRot + a_offset.y * sinRot, -a_offset.x * sinRot + a_offset.y * cosRot, a_offset.z };
+	}
+
+	// In relative mode the offset is scaled by how far the actor is from scale 1
+	Vector3 GetGoalPosition(const Vector3& a_originalPosition, const Vector3& a_offset, float a_rot, float a_scale, bool a_isRelative) {
+		Vector3 rotatedOffset = Rotate(a_offset, a_rot);
+		float factor = a_isRelative ? 1.0f - a_scale : 1.0f;
+		return Vector3{ a_originalPosition.x + rotatedOffset.x * factor, a_originalPosition.y + rotatedOffset.y * factor, a_originalPosition.z + rotatedOffset.z * factor };
+	}
+
+	// Each axis is clamped to [-limit, limit], a limit of 0 or less disables clamping
+	Vector3 Clamp(const Vector3& a_offset, float a_limit) {
+		if (a_limit <= 0.0f) {
+			return a_offset;
+		}
+
+		return Vector3{ std::clamp(a_offset.x, -a_limit, a_limit), std::clamp(a_offset.y, -a_limit, a_limit), std::clamp(a_offset.z, -a_limit, a_limit) };
+	}
+
+	// An axis other than x, y and z leaves the offset unchanged
+	Vector3 Nudge(const Vector3& a_offset, std::uint32_t a_axis, float a_steps, float a_stepSize, float a_limit) {
+		Vector3 result = a_offset;
+		float* component = GetComponent(result, a_axis);
+		if (!component) {
+			return a_offset;
+		}
+
+		*component += a_steps * a_stepSize;
+		return Clamp(result, a_limit);
+	}
+
+	Vector3 SetAxis(const Vector3& a_offset, std::uint32_t a_axis, float a_value, float a_limit) {
+		Vector3 result = a_offset;
+		float* component = GetComponent(result, a_axis);
+		if (!component) {
+			return a_offset;
+		}
+
+		*component = a_value;
+		return Clamp(result, a_limit);
+	}
+}
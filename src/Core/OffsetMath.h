@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Core/Vector3.h"
+
+namespace OffsetMath {
+	Vector3 Rotate(const Vector3& a_offset, float a_rot);
+	Vector3 GetGoalPosition(const Vector3& a_originalPosition, const Vector3& a_offset, float a_rot, float a_scale, bool a_isRelative);
+	Vector3 Clamp(const Vector3& a_offset, float a_limit);
+	Vector3 Nudge(const Vector3& a_offset, std::uint32_t a_axis, float a_steps, float a_stepSize, float a_limit);
+	Vector3 SetAxis(const Vector3& a_offset, std::uint32_t a_axis, float a_value, float a_limit);
+}
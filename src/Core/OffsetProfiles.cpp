@@ -0,0 +1,106 @@
+#include "Core/OffsetProfiles.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OffsetProfiles {
+	using Entry = PositionFile::Entry;
+
+	bool IsLess(const Entry& a_lhs, const Entry& a_rhs) {
+		return a_lhs.index != a_rhs.index ? a_lhs.index < a_rhs.index : a_lhs.scale < a_rhs.scale;
+	}
+
+	float GetBucketScale(float a_scale, float a_bucketSize) {
+		if (a_bucketSize <= 0.0f || a_scale <= 0.0f) {
+			return a_scale;
+		}
+
+		return std::max(std::round(a_scale / a_bucketSize), 1.0f) * a_bucketSize;
+	}
+
+	// Entries are ordered by index and then by scale, so the entries of one actor are contiguous with the unscaled one first
+	void Sort(std::vector<Entry>& a_entries) {
+		std::sort(a_entries.begin(), a_entries.end(), IsLess);
+	}
+
+	bool IsSameBucket(float a_lhs, float a_rhs, float a_bucketSize) {
+		if (a_lhs == PositionFile::kNoScale || a_rhs == PositionFile::kNoScale) {
+			return a_lhs == a_rhs;
+		}
+		return std::abs(a_lhs - a_rhs) < a_bucketSize * 0.5f;
+	}
+
+	// Updates replace the entry of the same index and bucket, scales written by hand only have to fall into the bucket
+	void Merge(std::vector<Entry>& a_entries, const std::vector<Entry>& a_updates, float a_bucketSize) {
+		for (const auto& update : a_updates) {
+			auto it = std::find_if(a_entries.begin(), a_entries.end(), [&update, a_bucketSize](const Entry& a_entry) {
+				return a_entry.index == update.index && IsSameBucket(a_entry.scale, update.scale, a_bucketSize);
+			});
+
+			if (it != a_entries.end()) {
+				it->offset = update.offset;
+			}
+			else {
+				a_entries.push_back(update);
+			}
+		}
+
+		Sort(a_entries);
+	}
+
+	// The bucket of the scale wins, otherwise the offset is interpolated between the neighboring buckets and clamped to the outermost ones.
+	// Actors without any bucket, or a scale of kNoScale, use the unscaled entry.
+	std::optional<Vector3> Resolve(const std::vector<Entry>& a_entries, std::uint32_t a_index, float a_scale, float a_bucketSize) {
+		auto first = std::lower_bound(a_entries.begin(), a_entries.end(), a_index, [](const Entry& a_entry, std::uint32_t a_value) {
+			return a_entry.index < a_value;
+		});
+
+		auto last = first;
+		while (last != a_entries.end() && last->index == a_index) {
+			last++;
+		}
+
+		if (first == last) {
+			return std::nullopt;
+		}
+
+		std::optional<Vector3> unscaled;
+		if (first->scale == PositionFile::kNoScale) {
+			unscaled = first->offset;
+			first++;
+		}
+
+		if (a_scale == PositionFile::kNoScale || first == last) {
+			return unscaled;
+		}
+
+		float bucketScale = GetBucketScale(a_scale, a_bucketSize);
+		auto upper = std::upper_bound(first, last, bucketScale, [](float a_value, const Entry& a_entry) {
+			return a_value < a_entry.scale;
+		});
+
+		if (upper != first && IsSameBucket((upper - 1)->scale, bucketScale, a_bucketSize)) {
+			return (upper - 1)->offset;
+		}
+
+		if (upper != last && IsSameBucket(upper->scale, bucketScale, a_bucketSize)) {
+			return upper->offset;
+		}
+
+		if (upper == first) {
+			return first->offset;
+		}
+
+		if (upper == last) {
+			return (last - 1)->offset;
+		}
+
+		const Entry& lower = *(upper - 1);
+		float t = std::clamp((a_scale - lower.scale) / (upper->scale - lower.scale), 0.0f, 1.0f);
+		return Vector3{
+			lower.offset.x + (upper->offset.x - lower.offset.x) * t,
+			lower.offset.y + (upper->offset.y - lower.offset.y) * t,
+			lower.offset.z + (upper->offset.z - lower.offset.z) * t
+		};
+	}
+}
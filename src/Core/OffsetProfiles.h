@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Core/PositionFile.h"
+#include "Core/Vector3.h"
+
+namespace OffsetProfiles {
+	float GetBucketScale(float a_scale, float a_bucketSize);
+	void Sort(std::vector<PositionFile::Entry>& a_entries);
+	void Merge(std::vector<PositionFile::Entry>& a_entries, const std::vector<PositionFile::Entry>& a_updates, float a_bucketSize);
+	std::optional<Vector3> Resolve(const std::vector<PositionFile::Entry>& a_entries, std::uint32_t a_index, float a_scale, float a_bucketSize);
+}
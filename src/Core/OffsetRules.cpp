@@ -0,0 +1,413 @@
+#include "Core/OffsetRules.h"
+
+#include <algorithm>
+
+#if __has_include(<srell.hpp>)
+#	include <srell.hpp>
+namespace re = srell;
+#else
+#	include <regex>
+namespace re = std;
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "Core/MemoryTracker.h"
+#include "Core/Tokenizer.h"
+
+namespace OffsetRules {
+	constexpr std::string_view kRegexPrefix = "re:";
+
+	struct Matcher::Regex {
+		re::regex                  combined;
+		std::vector<std::size_t>   groups;
+		std::vector<std::uint32_t> indices;
+	};
+
+	bool IsWildcard(char a_ch) {
+		return a_ch == '*' || a_ch == '?';
+	}
+
+	// Backreferences count groups from the start of the whole expression, so they break once the pattern is combined with others
+	bool HasBackreference(std::string_view a_pattern) {
+		for (std::size_t ii = 0; ii + 1 < a_pattern.size(); ii++) {
+			if (a_pattern[ii] != '\\') {
+				continue;
+			}
+
+			char next = a_pattern[++ii];
+			if ((next >= '1' && next <= '9') || next == 'k') {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Backtracks only to the last star, which keeps the match linear for patterns without nested ambiguity
+	bool MatchGlob(std::string_view a_pattern, std::string_view a_name) {
+		std::size_t p = 0, n = 0;
+		std::size_t starP = std::string_view::npos, starN = 0;
+
+		while (n < a_name.size()) {
+			if (p < a_pattern.size() && (a_pattern[p] == '?' || a_pattern[p] == a_name[n])) {
+				p++;
+				n++;
+			}
+			else if (p < a_pattern.size() && a_pattern[p] == '*') {
+				starP = p++;
+				starN = n;
+			}
+			else if (starP != std::string_view::npos) {
+				p = starP + 1;
+				n = ++starN;
+			}
+			else {
+				return false;
+			}
+		}
+
+		while (p < a_pattern.size() && a_pattern[p] == '*') {
+			p++;
+		}
+		return p == a_pattern.size();
+	}
+
+	std::vector<Rule> Parse(std::string_view a_buffer) {
+		std::vector<Rule> result;
+		std::string body;
+		bool hasRule = false;
+
+		auto flush = [&]() {
+			if (hasRule) {
+				result.back().entries = PositionFile::Parse(body);
+			}
+			body.clear();
+		};
+
+		Tokenizer::LineReader reader(a_buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			std::string_view trimmed = Tokenizer::Trim(line);
+			if (trimmed.empty() || trimmed[0] == '#') {
+				continue;
+			}
+
+			if (trimmed.front() != '[') {
+				if (!hasRule) {
+					spdlog::error("Offset outside of a rule: {}", trimmed);
+					continue;
+				}
+
+				body.append(trimmed);
+				body.push_back('\n');
+				continue;
+			}
+
+			flush();
+
+			if (trimmed.back() != ']' || trimmed.size() < 3) {
+				spdlog::error("Cannot read the rule pattern: {}", trimmed);
+				hasRule = false;
+				continue;
+			}
+
+			std::string_view pattern = Tokenizer::Trim(trimmed.substr(1, trimmed.size() - 2));
+
+			Rule rule;
+			if (pattern.substr(0, kRegexPrefix.size()) == kRegexPrefix) {
+				rule.kind = KIND::kRegex;
+				rule.pattern = std::string(pattern.substr(kRegexPrefix.size()));
+			}
+			else {
+				rule.kind = std::any_of(pattern.begin(), pattern.end(), IsWildcard) ? KIND::kGlob : KIND::kExact;
+				rule.pattern = Tokenizer::ToLower(pattern);
+			}
+
+			result.push_back(std::move(rule));
+			hasRule = true;
+		}
+
+		flush();
+		return result;
+	}
+
+	// The literal characters a regex must start with, so it can share the prefix trie with the globs
+	std::string GetRegexPrefix(std::string_view a_pattern) {
+		constexpr std::string_view kMeta = "\\^$.|?*+()[]{}";
+		constexpr std::string_view kQuantifiers = "?*+{";
+
+		if (a_pattern.find('|') != std::string_view::npos) {
+			return {};
+		}
+
+		std::size_t length = 0;
+		while (length < a_pattern.size() && kMeta.find(a_pattern[length]) == std::string_view::npos) {
+			length++;
+		}
+
+		// A quantifier makes the character before it optional
+		if (length > 0 && length < a_pattern.size() && kQuantifiers.find(a_pattern[length]) != std::string_view::npos) {
+			length--;
+		}
+
+		return Tokenizer::ToLower(a_pattern.substr(0, length));
+	}
+
+	Matcher::Matcher() :
+		trie(1),
+		memo(MemoryTracker::GetResource(MemoryTracker::CATEGORY::kRuleMemo)) {}
+
+	Matcher::~Matcher() = default;
+
+	std::uint32_t Matcher::AddNode(std::vector<Node>& a_trie, std::string_view a_prefix) {
+		std::uint32_t node = 0;
+		for (char ch : a_prefix) {
+			auto& children = a_trie[node].children;
+			auto it = std::find_if(children.begin(), children.end(), [&](const auto& a_child) { return a_child.first == ch; });
+			if (it != children.end()) {
+				node = it->second;
+				continue;
+			}
+
+			std::uint32_t child = static_cast<std::uint32_t>(a_trie.size());
+			children.emplace_back(ch, child);
+			a_trie.emplace_back();
+			node = child;
+		}
+		return node;
+	}
+
+	// Returns the number of rules kept, regexes that fail to compile are logged and dropped
+	std::size_t Matcher::Compile(std::vector<Rule> a_rules) {
+		std::vector<Rule> kept;
+		kept.reserve(a_rules.size());
+
+		// Group counts by kept rule, a combined regex needs them to find each rule's group
+		std::vector<std::size_t> markCounts;
+		for (auto& rule : a_rules) {
+			if (rule.pattern.empty()) {
+				continue;
+			}
+
+			std::size_t markCount = 0;
+			if (rule.kind == KIND::kRegex) {
+				try {
+					re::regex compiled(rule.pattern, re::regex::ECMAScript | re::regex::icase);
+					markCount = compiled.mark_count();
+				}
+				catch (const re::regex_error& e) {
+					spdlog::error("Cannot compile the rule pattern {}: {}", rule.pattern, e.what());
+					continue;
+				}
+			}
+
+			kept.push_back(std::move(rule));
+			markCounts.push_back(markCount);
+		}
+
+		std::unordered_map<std::string, std::uint32_t> newExact;
+		std::vector<Node> newTrie(1);
+		std::vector<std::uint32_t> newRanks(kept.size(), 0);
+		std::vector<std::uint32_t> globs;
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> regexNodes;
+
+		for (std::uint32_t ii = 0; ii < kept.size(); ii++) {
+			const Rule& rule = kept[ii];
+			if (rule.kind == KIND::kExact) {
+				newExact.try_emplace(rule.pattern, ii);
+			}
+			else if (rule.kind == KIND::kGlob) {
+				globs.push_back(ii);
+			}
+			else {
+				regexNodes.emplace_back(AddNode(newTrie, GetRegexPrefix(rule.pattern)), ii);
+			}
+		}
+
+		auto literals = [&](std::uint32_t a_index) {
+			const std::string& pattern = kept[a_index].pattern;
+			return std::count_if(pattern.begin(), pattern.end(), [](char c) { return !IsWildcard(c); });
+		};
+
+		std::stable_sort(globs.begin(), globs.end(), [&](std::uint32_t a, std::uint32_t b) { return literals(a) > literals(b); });
+
+		// Globs hang off the node of their literal prefix, a lookup only tests the globs along the name's own path
+		for (std::uint32_t rank = 0; rank < globs.size(); rank++) {
+			std::uint32_t index = globs[rank];
+			newRanks[index] = rank;
+
+			const std::string& pattern = kept[index].pattern;
+			std::size_t prefix = std::find_if(pattern.begin(), pattern.end(), IsWildcard) - pattern.begin();
+			newTrie[AddNode(newTrie, std::string_view(pattern).substr(0, prefix))].globs.push_back(index);
+		}
+
+		// The regexes of a node are combined into one automaton, each rule in its own group so the matched alternative tells which rule won.
+		// Patterns with backreferences, or a node whose patterns cannot be combined, are matched one regex per rule.
+		std::stable_sort(regexNodes.begin(), regexNodes.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		constexpr auto kFlags = re::regex::ECMAScript | re::regex::icase | re::regex::optimize;
+
+		std::vector<Regex> newRegexes;
+		auto addRegex = [&](std::uint32_t a_node, Regex a_regex) {
+			newTrie[a_node].regexes.push_back(static_cast<std::uint32_t>(newRegexes.size()));
+			newRegexes.push_back(std::move(a_regex));
+		};
+
+		for (std::size_t begin = 0; begin < regexNodes.size();) {
+			std::uint32_t node = regexNodes[begin].first;
+
+			std::vector<std::uint32_t> combinable;
+			std::vector<std::uint32_t> standalone;
+			std::size_t end = begin;
+			for (; end < regexNodes.size() && regexNodes[end].first == node; end++) {
+				std::uint32_t index = regexNodes[end].second;
+				(HasBackreference(kept[index].pattern) ? standalone : combinable).push_back(index);
+			}
+
+			if (combinable.size() > 1) {
+				Regex regex;
+				std::string combined;
+				std::size_t nextGroup = 1;
+				for (std::uint32_t index : combinable) {
+					if (!combined.empty()) {
+						combined.push_back('|');
+					}
+					combined.append("(").append(kept[index].pattern).append(")");
+
+					regex.groups.push_back(nextGroup);
+					regex.indices.push_back(index);
+					nextGroup += markCounts[index] + 1;
+				}
+
+				try {
+					regex.combined = re::regex(combined, kFlags);
+					addRegex(node, std::move(regex));
+					combinable.clear();
+				}
+				catch (const re::regex_error& e) {
+					spdlog::warn("Cannot combine the rule patterns, matching them one by one: {}", e.what());
+				}
+			}
+
+			standalone.insert(standalone.end(), combinable.begin(), combinable.end());
+			for (std::uint32_t index : standalone) {
+				addRegex(node, Regex{ re::regex(kept[index].pattern, kFlags), { 0 }, { index } });
+			}
+
+			begin = end;
+		}
+
+		std::lock_guard guard(lock);
+		rules = std::move(kept);
+		exact = std::move(newExact);
+		trie = std::move(newTrie);
+		globRanks = std::move(newRanks);
+		regexes = std::move(newRegexes);
+		ResetMemo();
+		return rules.size();
+	}
+
+	std::int32_t Matcher::Find(const std::string& a_key) const {
+		auto exactIt = exact.find(a_key);
+		if (exactIt != exact.end()) {
+			return static_cast<std::int32_t>(exactIt->second);
+		}
+
+		std::int32_t bestGlob = -1;
+		std::int32_t bestRegex = -1;
+		std::uint32_t node = 0;
+		for (std::size_t depth = 0;; depth++) {
+			const Node& current = trie[node];
+			for (std::uint32_t index : current.globs) {
+				if ((bestGlob < 0 || globRanks[index] < globRanks[static_cast<std::uint32_t>(bestGlob)]) && MatchGlob(rules[index].pattern, a_key)) {
+					bestGlob = static_cast<std::int32_t>(index);
+				}
+			}
+
+			// Regexes are only needed while no glob matched, and a regex whose first rule is declared after the best match cannot win
+			if (bestGlob < 0) {
+				for (std::uint32_t regexIndex : current.regexes) {
+					const Regex& regex = regexes[regexIndex];
+					re::smatch match;
+					if ((bestRegex >= 0 && regex.indices.front() > static_cast<std::uint32_t>(bestRegex)) || !re::regex_match(a_key, match, regex.combined)) {
+						continue;
+					}
+
+					for (std::size_t ii = 0; ii < regex.groups.size(); ii++) {
+						if (match[regex.groups[ii]].matched) {
+							if (bestRegex < 0 || regex.indices[ii] < static_cast<std::uint32_t>(bestRegex)) {
+								bestRegex = static_cast<std::int32_t>(regex.indices[ii]);
+							}
+							break;
+						}
+					}
+				}
+			}
+
+			if (depth == a_key.size()) {
+				break;
+			}
+
+			const auto& children = current.children;
+			auto it = std::find_if(children.begin(), children.end(), [&](const auto& a_child) { return a_child.first == a_key[depth]; });
+			if (it == children.end()) {
+				break;
+			}
+			node = it->second;
+		}
+
+		return bestGlob >= 0 ? bestGlob : bestRegex;
+	}
+
+	bool Matcher::Match(std::string_view a_position, Entries& a_entries) {
+		Tokenizer::LowerKey key(a_position);
+
+		std::lock_guard guard(lock);
+		if (rules.empty()) {
+			return false;
+		}
+
+		std::int32_t index;
+		auto it = memo.find(key.Get());
+		if (it != memo.end()) {
+			index = it->second;
+		}
+		else {
+			index = Find(std::string(key.Get()));
+
+			// Position names come from the loaded AAF packs, the budget only guards against a runaway caller
+			if (MemoryTracker::IsOverBudget(MemoryTracker::CATEGORY::kRuleMemo)) {
+				ResetMemo();
+			}
+			memo.emplace(key.Get(), index);
+		}
+
+		if (index < 0) {
+			return false;
+		}
+
+		a_entries = rules[static_cast<std::uint32_t>(index)].entries;
+		return true;
+	}
+
+	std::size_t Matcher::GetRuleCount() const {
+		std::lock_guard guard(lock);
+		return rules.size();
+	}
+
+	void Matcher::Clear() {
+		std::lock_guard guard(lock);
+		rules.clear();
+		exact.clear();
+		trie.assign(1, Node{});
+		globRanks.clear();
+		regexes.clear();
+		ResetMemo();
+	}
+
+	// clear() keeps the bucket array, which would stay counted against the budget, a fresh map hands everything back
+	void Matcher::ResetMemo() {
+		decltype(memo) empty(memo.get_allocator());
+		memo.swap(empty);
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/PositionFile.h"
+#include "Core/Tokenizer.h"
+
+namespace OffsetRules {
+	using Entries = std::vector<PositionFile::Entry>;
+
+	enum class KIND : std::uint32_t {
+		kExact,
+		kGlob,
+		kRegex
+	};
+
+	struct Rule {
+		KIND        kind;
+		std::string pattern;
+		Entries     entries;
+	};
+
+	// A rule is a [pattern] line followed by the usual index|x,y,z lines, patterns starting with re: are regexes and * or ? make a glob
+	std::vector<Rule> Parse(std::string_view a_buffer);
+
+	// Exact names win over globs, globs with more literal characters win over shorter ones and globs win over regexes.
+	// Within the same precedence the rule declared first wins. Names are matched case-insensitively.
+	class Matcher {
+	public:
+		Matcher();
+		~Matcher();
+
+		std::size_t Compile(std::vector<Rule> a_rules);
+		bool Match(std::string_view a_position, Entries& a_entries);
+		std::size_t GetRuleCount() const;
+		void Clear();
+
+	private:
+		struct Node {
+			std::vector<std::pair<char, std::uint32_t>> children;
+			std::vector<std::uint32_t>                  globs;
+			std::vector<std::uint32_t>                  regexes;
+		};
+
+		struct Regex;
+
+		static std::uint32_t AddNode(std::vector<Node>& a_trie, std::string_view a_prefix);
+		std::int32_t Find(const std::string& a_key) const;
+		void ResetMemo();
+
+		mutable std::mutex                                      lock;
+		std::vector<Rule>                                       rules;
+		std::unordered_map<std::string, std::uint32_t>          exact;
+		std::vector<Node>                                       trie;
+		std::vector<std::uint32_t>                              globRanks;
+		std::vector<Regex>                                      regexes;
+		std::pmr::unordered_map<std::pmr::string, std::int32_t, Tokenizer::StringHash, std::equal_to<>> memo;
+	};
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+namespace PathCache {
+	// Generation of one scene, bumped when that scene's animation changes so other scenes keep their cached paths
+	class Generation {
+	public:
+		std::uint32_t Get() const { return value; }
+
+		void Bump() {
+			// 0 marks an entry that was never cached
+			if (++value == 0) {
+				value = 1;
+			}
+		}
+
+	private:
+		std::uint32_t value = 1;
+	};
+
+	// Uses the cached path if it was stored under the current generation and the actor still holds that same path, otherwise walks
+	// again and calls a_onChange when the path moved. Only knowing that some path is present is not enough, the engine can replace it.
+	template <class Path, class IsCurrent, class Walk, class OnChange>
+	Path* Lookup(Path*& a_cached, std::uint32_t& a_cachedGeneration, std::uint32_t a_generation, std::uint64_t& a_hits, IsCurrent&& a_isCurrent, Walk&& a_walk, OnChange&& a_onChange) {
+		if (a_cached && a_cachedGeneration == a_generation && a_isCurrent(a_cached)) {
+			a_hits++;
+			return a_cached;
+		}
+
+		Path* path = a_walk();
+		if (!path) {
+			return nullptr;
+		}
+
+		if (a_cached != path) {
+			a_cached = path;
+			a_onChange(path);
+		}
+
+		a_cachedGeneration = a_generation;
+		return path;
+	}
+}
@@ -0,0 +1,348 @@
+#include "Core/PositionBaker.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "Core/Tokenizer.h"
+
+namespace PositionBaker {
+	bool IsSpace(char a_ch) {
+		return std::isspace(static_cast<unsigned char>(a_ch)) != 0;
+	}
+
+	TOKEN XmlReader::Next() {
+		raw.clear();
+
+		std::streambuf* buffer = stream.rdbuf();
+		int ch = buffer ? buffer->sgetc() : std::char_traits<char>::eof();
+		if (ch == std::char_traits<char>::eof()) {
+			return token = TOKEN::kEnd;
+		}
+
+		if (ch != '<') {
+			while (ch != std::char_traits<char>::eof() && ch != '<') {
+				raw.push_back(static_cast<char>(ch));
+				ch = buffer->snextc();
+			}
+			return token = TOKEN::kText;
+		}
+
+		raw.push_back(static_cast<char>(buffer->sbumpc()));
+		ch = buffer->sgetc();
+
+		// Comments, CDATA, declarations and processing instructions are passed through as they are
+		if (ch == '!' || ch == '?') {
+			raw.push_back(static_cast<char>(buffer->sbumpc()));
+			int next = buffer->sgetc();
+			if (ch == '?') {
+				ReadUntil("?>");
+			}
+			else if (next == '-') {
+				ReadUntil("-->");
+			}
+			else if (next == '[') {
+				ReadUntil("]]>");
+			}
+			else {
+				ReadUntil(">");
+			}
+			return token = TOKEN::kOther;
+		}
+
+		char quote = 0;
+		for (ch = buffer->sbumpc(); ch != std::char_traits<char>::eof(); ch = buffer->sbumpc()) {
+			raw.push_back(static_cast<char>(ch));
+			if (quote) {
+				if (ch == quote) {
+					quote = 0;
+				}
+			}
+			else if (ch == '"' || ch == '\'') {
+				quote = static_cast<char>(ch);
+			}
+			else if (ch == '>') {
+				return token = raw.size() > 1 && raw[1] == '/' ? TOKEN::kEndTag : TOKEN::kStartTag;
+			}
+		}
+
+		// A tag cut off by the end of the file is copied but never rewritten
+		return token = TOKEN::kOther;
+	}
+
+	bool XmlReader::ReadUntil(std::string_view a_terminator) {
+		std::streambuf* buffer = stream.rdbuf();
+		for (int ch = buffer->sbumpc(); ch != std::char_traits<char>::eof(); ch = buffer->sbumpc()) {
+			raw.push_back(static_cast<char>(ch));
+			if (raw.size() >= a_terminator.size() && std::string_view(raw).substr(raw.size() - a_terminator.size()) == a_terminator) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::string_view XmlReader::GetName() const {
+		if (token != TOKEN::kStartTag && token != TOKEN::kEndTag) {
+			return {};
+		}
+
+		std::size_t begin = token == TOKEN::kEndTag ? 2 : 1;
+		std::size_t end = begin;
+		while (end < raw.size() && !IsSpace(raw[end]) && raw[end] != '/' && raw[end] != '>') {
+			end++;
+		}
+		return std::string_view(raw).substr(begin, end - begin);
+	}
+
+	bool XmlReader::IsSelfClosing() const {
+		return token == TOKEN::kStartTag && raw.size() >= 2 && raw[raw.size() - 2] == '/';
+	}
+
+	bool XmlReader::FindAttribute(std::string_view a_name, std::size_t& a_begin, std::size_t& a_end) const {
+		if (token != TOKEN::kStartTag) {
+			return false;
+		}
+
+		std::size_t pos = 1 + GetName().size();
+		while (pos < raw.size()) {
+			while (pos < raw.size() && IsSpace(raw[pos])) {
+				pos++;
+			}
+
+			std::size_t nameBegin = pos;
+			while (pos < raw.size() && !IsSpace(raw[pos]) && raw[pos] != '=' && raw[pos] != '/' && raw[pos] != '>') {
+				pos++;
+			}
+			if (pos == nameBegin) {
+				return false;
+			}
+			std::string_view name = std::string_view(raw).substr(nameBegin, pos - nameBegin);
+
+			while (pos < raw.size() && IsSpace(raw[pos])) {
+				pos++;
+			}
+			if (pos >= raw.size() || raw[pos] != '=') {
+				continue;
+			}
+			pos++;
+			while (pos < raw.size() && IsSpace(raw[pos])) {
+				pos++;
+			}
+			if (pos >= raw.size() || (raw[pos] != '"' && raw[pos] != '\'')) {
+				return false;
+			}
+
+			char quote = raw[pos++];
+			std::size_t valueEnd = raw.find(quote, pos);
+			if (valueEnd == std::string::npos) {
+				return false;
+			}
+
+			if (name == a_name) {
+				a_begin = pos;
+				a_end = valueEnd;
+				return true;
+			}
+			pos = valueEnd + 1;
+		}
+
+		return false;
+	}
+
+	bool XmlReader::GetAttribute(std::string_view a_name, std::string& a_value) const {
+		std::size_t begin, end;
+		if (!FindAttribute(a_name, begin, end)) {
+			return false;
+		}
+
+		a_value.assign(raw, begin, end - begin);
+		return true;
+	}
+
+	void XmlReader::SetAttribute(std::string_view a_name, std::string_view a_value) {
+		std::size_t begin, end;
+		if (FindAttribute(a_name, begin, end)) {
+			raw.replace(begin, end - begin, a_value);
+			return;
+		}
+
+		if (token != TOKEN::kStartTag) {
+			return;
+		}
+
+		std::size_t pos = raw.size() - (IsSelfClosing() ? 2 : 1);
+		while (pos > 0 && IsSpace(raw[pos - 1])) {
+			pos--;
+		}
+		raw.insert(pos, fmt::format(" {}=\"{}\"", a_name, a_value));
+	}
+
+	std::string MakeKey(std::string_view a_id) {
+		return Tokenizer::ToLower(a_id);
+	}
+
+	bool ReadPositions(const std::filesystem::path& a_path, std::vector<Position>& a_positions) {
+		std::ifstream file(a_path, std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		XmlReader reader(file);
+		for (TOKEN token = reader.Next(); token != TOKEN::kEnd; token = reader.Next()) {
+			if (token != TOKEN::kStartTag || reader.GetName() != "position") {
+				continue;
+			}
+
+			Position position;
+			if (!reader.GetAttribute("id", position.id)) {
+				continue;
+			}
+			reader.GetAttribute("animation", position.animation);
+			a_positions.push_back(std::move(position));
+		}
+
+		return true;
+	}
+
+	std::string CheckBakeable(const Position* a_position, const Entries& a_entries, bool a_separatePlayer, const Entries* a_playerEntries) {
+		if (!a_position) {
+			return "no AAF position";
+		}
+		if (a_position->animation.empty()) {
+			return "not a single animation";
+		}
+		if (std::any_of(a_entries.begin(), a_entries.end(), [](const PositionFile::Entry& a_entry) { return a_entry.scale != PositionFile::kNoScale; })) {
+			return "has scale buckets";
+		}
+		if (std::all_of(a_entries.begin(), a_entries.end(), [](const PositionFile::Entry& a_entry) { return a_entry.offset == Vector3{}; })) {
+			return "no offsets";
+		}
+		if (a_separatePlayer) {
+			// Without layers a missing player file means no offsets in player scenes, not the NPC ones
+			if (!a_playerEntries) {
+				return "no player offsets";
+			}
+			if (PositionFile::Serialize(*a_playerEntries) != PositionFile::Serialize(a_entries)) {
+				return "player offsets differ";
+			}
+		}
+		return {};
+	}
+
+	// AAF offsets are x,y,z with an optional rotation, which is kept as it is
+	bool AddOffset(std::string& a_value, const Vector3& a_offset) {
+		float values[3] = { 0.0f, 0.0f, 0.0f };
+		std::string_view rest;
+
+		std::string_view value = Tokenizer::Trim(a_value);
+		if (!value.empty()) {
+			std::size_t index = 0;
+			for (float& number : values) {
+				if (index >= value.size() || !Tokenizer::ParseNumber(Tokenizer::Trim(Tokenizer::GetNextData(value, index, ',')), number)) {
+					return false;
+				}
+			}
+			if (index < value.size()) {
+				rest = value.substr(index - 1);
+			}
+		}
+
+		a_value = fmt::format("{},{},{}{}", values[0] + a_offset.x, values[1] + a_offset.y, values[2] + a_offset.z, rest);
+		return true;
+	}
+
+	bool Bake(const std::filesystem::path& a_path, const std::filesystem::path& a_outPath, const std::unordered_map<std::string, Entries>& a_animations, Result& a_result) {
+		std::filesystem::path tempPath = a_outPath;
+		tempPath += ".tmp";
+
+		bool changed = false;
+		{
+			std::ifstream input(a_path, std::ios::binary);
+			if (!input.is_open()) {
+				return false;
+			}
+
+			std::error_code ec;
+			std::filesystem::create_directories(a_outPath.parent_path(), ec);
+
+			std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+			if (!output.is_open()) {
+				return false;
+			}
+
+			XmlReader reader(input);
+			const Entries* entries = nullptr;
+			std::size_t depth = 0;
+			std::size_t animationDepth = 0;
+			std::uint32_t actorIndex = 0;
+			std::string value;
+
+			for (TOKEN token = reader.Next(); token != TOKEN::kEnd; token = reader.Next()) {
+				if (token == TOKEN::kStartTag) {
+					std::string_view name = reader.GetName();
+					if (!entries && name == "animation" && !reader.IsSelfClosing() && reader.GetAttribute("id", value)) {
+						auto it = a_animations.find(MakeKey(value));
+						if (it != a_animations.end()) {
+							entries = &it->second;
+							animationDepth = depth;
+							actorIndex = 0;
+							a_result.animations.push_back(it->first);
+						}
+					}
+					// Only the direct actor children of the animation are counted, in the order AAF assigns them
+					else if (entries && name == "actor" && depth == animationDepth + 1) {
+						auto entry = std::find_if(entries->begin(), entries->end(), [&](const PositionFile::Entry& a_entry) {
+							return a_entry.index == actorIndex && a_entry.scale == PositionFile::kNoScale;
+						});
+
+						if (entry != entries->end() && !(entry->offset == Vector3{})) {
+							value.clear();
+							reader.GetAttribute("offset", value);
+							if (AddOffset(value, entry->offset)) {
+								reader.SetAttribute("offset", value);
+								a_result.actorCount++;
+								changed = true;
+							}
+							else {
+								spdlog::error("Cannot parse the offset {} in {}", value, a_path.string());
+							}
+						}
+						actorIndex++;
+					}
+
+					if (!reader.IsSelfClosing()) {
+						depth++;
+					}
+				}
+				else if (token == TOKEN::kEndTag) {
+					depth = depth > 0 ? depth - 1 : 0;
+					if (entries && depth == animationDepth && reader.GetName() == "animation") {
+						entries = nullptr;
+					}
+				}
+
+				output.write(reader.GetRaw().data(), static_cast<std::streamsize>(reader.GetRaw().size()));
+			}
+
+			output.close();
+			if (!output.good()) {
+				std::filesystem::remove(tempPath, ec);
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		if (!changed) {
+			std::filesystem::remove(tempPath, ec);
+			return true;
+		}
+
+		std::filesystem::rename(tempPath, a_outPath, ec);
+		if (ec) {
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+		return true;
+	}
+}
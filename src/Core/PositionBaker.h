@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/PositionFile.h"
+
+namespace PositionBaker {
+	using Entries = std::vector<PositionFile::Entry>;
+
+	enum class TOKEN : std::uint32_t {
+		kEnd,
+		kText,
+		kStartTag,
+		kEndTag,
+		kOther
+	};
+
+	// Reads an XML file one token at a time, the raw text of every token is kept so a copy can be written back byte for byte
+	class XmlReader {
+	public:
+		explicit XmlReader(std::istream& a_stream) : stream(a_stream) {}
+
+		TOKEN Next();
+		const std::string& GetRaw() const { return raw; }
+		std::string_view GetName() const;
+		bool IsSelfClosing() const;
+		bool GetAttribute(std::string_view a_name, std::string& a_value) const;
+		// Replaces the value in place or appends the attribute to the start tag
+		void SetAttribute(std::string_view a_name, std::string_view a_value);
+
+	private:
+		bool FindAttribute(std::string_view a_name, std::size_t& a_begin, std::size_t& a_end) const;
+		bool ReadUntil(std::string_view a_terminator);
+
+		std::istream& stream;
+		std::string   raw;
+		TOKEN         token = TOKEN::kEnd;
+	};
+
+	// An AAF position and the animation it plays, positions built from trees or groups have no animation
+	struct Position {
+		std::string id;
+		std::string animation;
+	};
+
+	struct Result {
+		std::size_t              actorCount = 0;
+		// Keys of the animations found in the file and rewritten
+		std::vector<std::string> animations;
+	};
+
+	std::string MakeKey(std::string_view a_id);
+	bool ReadPositions(const std::filesystem::path& a_path, std::vector<Position>& a_positions);
+
+	// Why a position cannot be baked, empty when it can. With separate player offsets the Player\ entries, null when the
+	// position has no player file, must be the same as the NPC ones since player scenes play the same XML.
+	std::string CheckBakeable(const Position* a_position, const Entries& a_entries, bool a_separatePlayer, const Entries* a_playerEntries);
+
+	// Adds the plain offsets of each animation, keyed by MakeKey, to the offset attribute of its actors.
+	// The file is streamed to a temporary next to the output and only moved into place when something changed.
+	bool Bake(const std::filesystem::path& a_path, const std::filesystem::path& a_outPath, const std::unordered_map<std::string, Entries>& a_animations, Result& a_result);
+}
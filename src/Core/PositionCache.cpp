@@ -0,0 +1,243 @@
+#include "Core/PositionCache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+#include "Core/MemoryTracker.h"
+#include "Core/OffsetProfiles.h"
+#include "Core/Tokenizer.h"
+
+namespace PositionCache {
+	using Entries = std::vector<PositionFile::Entry>;
+	using CachedEntries = std::pmr::vector<PositionFile::Entry>;
+	using Positions = std::pmr::unordered_map<std::pmr::string, CachedEntries, Tokenizer::StringHash, std::equal_to<>>;
+
+	constexpr MemoryTracker::CATEGORY kCategory = MemoryTracker::CATEGORY::kPositionCache;
+
+	// Rough per position cost of the map node and the allocation headers, only used to stop a prewarm before it overshoots
+	constexpr std::size_t kNodeOverhead = 64;
+
+	std::shared_mutex g_lock;
+	std::array<Positions, 2> g_positions{ Positions(MemoryTracker::GetResource(kCategory)), Positions(MemoryTracker::GetResource(kCategory)) };
+
+	std::string MakeKey(std::string_view a_position) {
+		return Tokenizer::ToLower(a_position);
+	}
+
+	std::size_t GetCost(const std::string& a_key, const Entries& a_entries) {
+		return kNodeOverhead + a_key.capacity() + a_entries.capacity() * sizeof(PositionFile::Entry);
+	}
+
+	std::size_t GetMemoryUsage() {
+		return MemoryTracker::GetUsage(kCategory).current;
+	}
+
+	// Erasing nodes leaves the bucket array at its largest size, moving the nodes to a fresh map sizes it for what is left
+	void Compact(Positions& a_positions) {
+		Positions compact(a_positions.get_allocator());
+		compact.reserve(a_positions.size());
+		while (!a_positions.empty()) {
+			compact.insert(a_positions.extract(a_positions.begin()));
+		}
+		a_positions.swap(compact);
+	}
+
+	// Drops other positions until the cache is a quarter below its budget, so the next stores do not evict again right away.
+	// The bucket arrays are compacted before measuring, otherwise they would stay counted and every store would empty the cache.
+	void Evict(bool a_isPlayer, std::string_view a_keep) {
+		std::size_t budget = MemoryTracker::GetBudget(kCategory);
+		if (budget == 0 || GetMemoryUsage() <= budget) {
+			return;
+		}
+
+		for (auto& positions : g_positions) {
+			Compact(positions);
+		}
+
+		std::size_t target = budget - budget / 4;
+		for (bool isPlayer : { a_isPlayer, !a_isPlayer }) {
+			auto& positions = g_positions[isPlayer];
+			std::size_t compactedSize = positions.size();
+			for (auto it = positions.begin(); it != positions.end() && GetMemoryUsage() > target;) {
+				if (isPlayer == a_isPlayer && it->first == a_keep) {
+					++it;
+					continue;
+				}
+
+				it = positions.erase(it);
+
+				// Compacting each time half the nodes are gone keeps the counted bucket array close to what is left
+				if (positions.size() <= compactedSize / 2) {
+					Compact(positions);
+					compactedSize = positions.size();
+					it = positions.begin();
+				}
+			}
+			Compact(positions);
+		}
+
+		if (GetMemoryUsage() > budget) {
+			auto& positions = g_positions[a_isPlayer];
+			if (auto it = positions.find(a_keep); it != positions.end()) {
+				positions.erase(it);
+				Compact(positions);
+			}
+		}
+	}
+
+	struct File {
+		std::filesystem::path path;
+		bool                  isPlayer;
+	};
+
+	std::vector<File> EnumerateFiles(const std::vector<Directory>& a_directories) {
+		std::vector<File> result;
+		for (const auto& directory : a_directories) {
+			std::error_code ec;
+			for (std::filesystem::directory_iterator it(directory.path, ec), end; !ec && it != end; it.increment(ec)) {
+				if (it->is_regular_file(ec) && it->path().extension() == ".txt") {
+					result.push_back({ it->path(), directory.isPlayer });
+				}
+			}
+		}
+		return result;
+	}
+
+	Stats Prewarm(const std::vector<Directory>& a_directories, std::uint32_t a_threadCount, std::size_t a_memoryLimit, std::stop_token a_stopToken) {
+		SetMemoryLimit(a_memoryLimit);
+
+		std::vector<File> files = EnumerateFiles(a_directories);
+
+		// Workers stop on an outside request or once the memory limit is hit
+		std::stop_source stopSource;
+		std::stop_callback stopCallback(a_stopToken, [&stopSource]() { stopSource.request_stop(); });
+
+		std::atomic<std::size_t> nextFile = 0;
+		std::atomic<std::size_t> parsedFiles = 0;
+		std::atomic<std::size_t> parsedEntries = 0;
+		std::atomic<bool> limitReached = false;
+
+		auto worker = [&]() {
+			std::stop_token token = stopSource.get_token();
+			while (!token.stop_requested()) {
+				std::size_t index = nextFile.fetch_add(1, std::memory_order_relaxed);
+				if (index >= files.size()) {
+					break;
+				}
+
+				Entries entries;
+				if (!PositionFile::Load(files[index].path.string(), entries)) {
+					continue;
+				}
+				OffsetProfiles::Sort(entries);
+				entries.shrink_to_fit();
+
+				std::string key = MakeKey(files[index].path.stem().string());
+				std::size_t cost = GetCost(key, entries);
+				std::size_t entryCount = entries.size();
+
+				std::unique_lock lock(g_lock);
+				std::size_t budget = MemoryTracker::GetBudget(kCategory);
+				if (budget > 0 && GetMemoryUsage() + cost > budget) {
+					limitReached = true;
+					stopSource.request_stop();
+					break;
+				}
+
+				// A position saved while prewarming is newer than the file read here
+				g_positions[files[index].isPlayer].try_emplace(std::pmr::string(key), entries.begin(), entries.end());
+				lock.unlock();
+
+				parsedFiles++;
+				parsedEntries += entryCount;
+			}
+		};
+
+		std::size_t threadCount = std::clamp<std::size_t>(a_threadCount, 1, std::max<std::size_t>(files.size(), 1));
+		{
+			std::vector<std::jthread> threads;
+			threads.reserve(threadCount);
+			for (std::size_t ii = 0; ii < threadCount; ii++) {
+				threads.emplace_back(worker);
+			}
+		}
+
+		Stats stats;
+		stats.files = parsedFiles;
+		stats.entries = parsedEntries;
+		stats.limitReached = limitReached;
+		stats.cancelled = a_stopToken.stop_requested();
+
+		std::shared_lock lock(g_lock);
+		stats.memoryUsage = GetMemoryUsage();
+		return stats;
+	}
+
+	void SetMemoryLimit(std::size_t a_memoryLimit) {
+		std::unique_lock lock(g_lock);
+		MemoryTracker::SetBudget(kCategory, a_memoryLimit);
+		Evict(false, {});
+	}
+
+	// True when a lookup would be answered without reading the file
+	bool Contains(std::string_view a_position, bool a_isPlayer) {
+		Tokenizer::LowerKey key(a_position);
+
+		std::shared_lock lock(g_lock);
+		return g_positions[a_isPlayer].contains(key.Get());
+	}
+
+	// Returns false when the caller has to read the file itself
+	bool Find(std::string_view a_position, bool a_isPlayer, Entries& a_entries) {
+		Tokenizer::LowerKey key(a_position);
+
+		std::shared_lock lock(g_lock);
+		const auto& positions = g_positions[a_isPlayer];
+		auto it = positions.find(key.Get());
+		if (it == positions.end()) {
+			return false;
+		}
+
+		a_entries.assign(it->second.begin(), it->second.end());
+		return true;
+	}
+
+	void Store(std::string_view a_position, bool a_isPlayer, const Entries& a_entries) {
+		Tokenizer::LowerKey key(a_position);
+
+		std::unique_lock lock(g_lock);
+		auto& positions = g_positions[a_isPlayer];
+		auto it = positions.find(key.Get());
+		if (it != positions.end()) {
+			it->second.assign(a_entries.begin(), a_entries.end());
+		}
+		else {
+			positions.try_emplace(std::pmr::string(key.Get(), positions.get_allocator()), a_entries.begin(), a_entries.end());
+		}
+
+		Evict(a_isPlayer, key.Get());
+	}
+
+	// Only the caller knows it looked for the file and found none, a scan that did not see a file proves nothing because the
+	// file can be added later. The answer holds until a save stores the position or the cache is cleared.
+	void StoreMissing(std::string_view a_position, bool a_isPlayer) {
+		Store(a_position, a_isPlayer, {});
+	}
+
+	void Clear() {
+		std::unique_lock lock(g_lock);
+		for (auto& positions : g_positions) {
+			positions.clear();
+		}
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stop_token>
+#include <string_view>
+#include <vector>
+
+#include "Core/PositionFile.h"
+
+namespace PositionCache {
+	struct Directory {
+		std::filesystem::path path;
+		bool                  isPlayer;
+	};
+
+	struct Stats {
+		std::size_t files = 0;
+		std::size_t entries = 0;
+		std::size_t memoryUsage = 0;
+		bool        limitReached = false;
+		bool        cancelled = false;
+	};
+
+	Stats Prewarm(const std::vector<Directory>& a_directories, std::uint32_t a_threadCount, std::size_t a_memoryLimit, std::stop_token a_stopToken);
+	void SetMemoryLimit(std::size_t a_memoryLimit);
+	bool Contains(std::string_view a_position, bool a_isPlayer);
+	bool Find(std::string_view a_position, bool a_isPlayer, std::vector<PositionFile::Entry>& a_entries);
+	void Store(std::string_view a_position, bool a_isPlayer, const std::vector<PositionFile::Entry>& a_entries);
+	void StoreMissing(std::string_view a_position, bool a_isPlayer);
+	void Clear();
+}
@@ -0,0 +1,106 @@
+#include "Core/PositionFile.h"
+
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "Core/Tokenizer.h"
+
+namespace PositionFile {
+	std::vector<Entry> Parse(std::string_view a_buffer) {
+		std::vector<Entry> result;
+
+		Tokenizer::LineReader reader(a_buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			line = Tokenizer::Trim(line);
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+
+			std::size_t index = 0;
+
+			std::string_view indexStr = Tokenizer::GetNextData(line, index, '|');
+			if (indexStr.empty()) {
+				spdlog::error("Cannot read the position index: {}", line);
+				continue;
+			}
+
+			std::string_view offX = Tokenizer::GetNextData(line, index, ',');
+			if (offX.empty()) {
+				spdlog::error("Cannot read the offsetX: {}", line);
+				continue;
+			}
+
+			std::string_view offY = Tokenizer::GetNextData(line, index, ',');
+			if (offY.empty()) {
+				spdlog::error("Cannot read the offsetY: {}", line);
+				continue;
+			}
+
+			std::string_view offZ = Tokenizer::GetNextData(line, index, 0);
+			if (offZ.empty()) {
+				spdlog::error("Cannot read the offsetZ: {}", line);
+				continue;
+			}
+
+			// A scale bucket is written as index@scale
+			std::string_view scaleStr;
+			std::size_t scalePos = indexStr.find('@');
+			if (scalePos != std::string_view::npos) {
+				scaleStr = Tokenizer::Trim(indexStr.substr(scalePos + 1));
+				indexStr = Tokenizer::Trim(indexStr.substr(0, scalePos));
+			}
+
+			Entry entry;
+			if (!scaleStr.empty() && (!Tokenizer::ParseNumber(scaleStr, entry.scale) || entry.scale <= 0.0f)) {
+				spdlog::error("Cannot parse the scale: {}", line);
+				continue;
+			}
+
+			if (!Tokenizer::ParseNumber(indexStr, entry.index) || !Tokenizer::ParseNumber(offX, entry.offset.x) ||
+				!Tokenizer::ParseNumber(offY, entry.offset.y) || !Tokenizer::ParseNumber(offZ, entry.offset.z)) {
+				spdlog::error("Cannot parse the position data: {}", line);
+				continue;
+			}
+
+			result.push_back(entry);
+		}
+
+		return result;
+	}
+
+	std::string Serialize(const std::vector<Entry>& a_entries) {
+		std::string result;
+		for (const auto& entry : a_entries) {
+			if (entry.scale == kNoScale) {
+				fmt::format_to(std::back_inserter(result), "{}|{},{},{}\n", entry.index, entry.offset.x, entry.offset.y, entry.offset.z);
+			}
+			else {
+				fmt::format_to(std::back_inserter(result), "{}@{}|{},{},{}\n", entry.index, entry.scale, entry.offset.x, entry.offset.y, entry.offset.z);
+			}
+		}
+		return result;
+	}
+
+	bool Load(const std::string& a_path, std::vector<Entry>& a_entries) {
+		std::string buffer;
+		if (!Tokenizer::ReadFile(a_path, buffer)) {
+			return false;
+		}
+
+		a_entries = Parse(buffer);
+		return true;
+	}
+
+	bool Save(const std::string& a_path, const std::vector<Entry>& a_entries) {
+		std::ofstream file(a_path, std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		std::string buffer = Serialize(a_entries);
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		return file.good();
+	}
+}
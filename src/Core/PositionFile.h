@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/Vector3.h"
+
+namespace PositionFile {
+	// Entries without a scale apply to every actor scale
+	constexpr float kNoScale = 0.0f;
+
+	struct Entry {
+		std::uint32_t index;
+		Vector3       offset;
+		float         scale = kNoScale;
+	};
+
+	std::vector<Entry> Parse(std::string_view a_buffer);
+	std::string Serialize(const std::vector<Entry>& a_entries);
+	bool Load(const std::string& a_path, std::vector<Entry>& a_entries);
+	bool Save(const std::string& a_path, const std::vector<Entry>& a_entries);
+}
@@ -0,0 +1,204 @@
+#include "Core/PositionLayers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "Core/OffsetProfiles.h"
+#include "Core/Tokenizer.h"
+
+namespace PositionLayers {
+	std::string MakeKey(std::string_view a_position) {
+		return Tokenizer::ToLower(a_position);
+	}
+
+	Positions ReadLayer(const std::filesystem::path& a_directory, std::uint32_t a_threadCount) {
+		std::vector<std::filesystem::path> files;
+
+		std::error_code ec;
+		for (std::filesystem::directory_iterator it(a_directory, ec), end; !ec && it != end; it.increment(ec)) {
+			if (it->is_regular_file(ec) && it->path().extension() == ".txt") {
+				files.push_back(it->path());
+			}
+		}
+
+		Positions result;
+		std::mutex resultLock;
+		std::atomic<std::size_t> nextFile = 0;
+
+		auto worker = [&]() {
+			for (std::size_t index = nextFile.fetch_add(1, std::memory_order_relaxed); index < files.size(); index = nextFile.fetch_add(1, std::memory_order_relaxed)) {
+				Entries entries;
+				if (!PositionFile::Load(files[index].string(), entries)) {
+					continue;
+				}
+				OffsetProfiles::Sort(entries);
+
+				std::string key = MakeKey(files[index].stem().string());
+
+				std::lock_guard guard(resultLock);
+				result.insert_or_assign(std::move(key), std::move(entries));
+			}
+		};
+
+		std::size_t threadCount = std::clamp<std::size_t>(a_threadCount, 1, std::max<std::size_t>(files.size(), 1));
+		{
+			std::vector<std::jthread> threads;
+			for (std::size_t ii = 1; ii < threadCount; ii++) {
+				threads.emplace_back(worker);
+			}
+			worker();
+		}
+
+		return result;
+	}
+
+	void Index::Reset(std::vector<Layer> a_layers, float a_bucketSize) {
+		std::unique_lock guard(lock);
+		bucketSize = a_bucketSize;
+		layers = std::move(a_layers);
+		contents.assign(layers.size(), Positions{});
+		merged[0].clear();
+		merged[1].clear();
+	}
+
+	std::size_t Index::GetLayerCount() const {
+		std::shared_lock guard(lock);
+		return layers.size();
+	}
+
+	Layer Index::GetLayer(std::size_t a_slot) const {
+		std::shared_lock guard(lock);
+		return layers.at(a_slot);
+	}
+
+	// Merges every layer holding the position, the player result shares the other one when no player layer changes it
+	void Index::Rebuild(const std::string& a_key) {
+		Entries result;
+		bool found = false;
+		for (std::size_t ii = 0; ii < layers.size(); ii++) {
+			if (layers[ii].isPlayer) {
+				continue;
+			}
+
+			auto it = contents[ii].find(a_key);
+			if (it != contents[ii].end()) {
+				OffsetProfiles::Merge(result, it->second, bucketSize);
+				found = true;
+			}
+		}
+
+		EntriesPtr npcEntries = found ? std::make_shared<const Entries>(result) : nullptr;
+		EntriesPtr playerEntries = npcEntries;
+
+		bool playerFound = false;
+		for (std::size_t ii = 0; ii < layers.size(); ii++) {
+			if (!layers[ii].isPlayer) {
+				continue;
+			}
+
+			auto it = contents[ii].find(a_key);
+			if (it != contents[ii].end()) {
+				OffsetProfiles::Merge(result, it->second, bucketSize);
+				playerFound = true;
+			}
+		}
+
+		if (playerFound) {
+			playerEntries = std::make_shared<const Entries>(std::move(result));
+		}
+
+		for (int isPlayer = 0; isPlayer < 2; isPlayer++) {
+			const EntriesPtr& entries = isPlayer ? playerEntries : npcEntries;
+			if (entries) {
+				merged[isPlayer].insert_or_assign(a_key, entries);
+			}
+			else {
+				merged[isPlayer].erase(a_key);
+			}
+		}
+	}
+
+	void Index::Assign(std::size_t a_slot, Positions a_positions) {
+		std::unique_lock guard(lock);
+		if (a_slot >= layers.size()) {
+			return;
+		}
+
+		std::unordered_set<std::string> keys;
+		for (const auto& [key, entries] : contents[a_slot]) {
+			keys.insert(key);
+		}
+		for (const auto& [key, entries] : a_positions) {
+			keys.insert(key);
+		}
+
+		contents[a_slot] = std::move(a_positions);
+		for (const auto& key : keys) {
+			Rebuild(key);
+		}
+	}
+
+	void Index::Assign(std::size_t a_slot, const std::filesystem::path& a_directory, Positions a_positions) {
+		{
+			std::unique_lock guard(lock);
+			if (a_slot >= layers.size()) {
+				return;
+			}
+			layers[a_slot].directory = a_directory;
+		}
+
+		Assign(a_slot, std::move(a_positions));
+	}
+
+	// Updates a single position after it was saved into the layer
+	void Index::Store(std::size_t a_slot, std::string_view a_position, Entries a_entries) {
+		std::string key = MakeKey(a_position);
+
+		std::unique_lock guard(lock);
+		if (a_slot >= layers.size()) {
+			return;
+		}
+
+		contents[a_slot].insert_or_assign(key, std::move(a_entries));
+		Rebuild(key);
+	}
+
+	bool Index::FindInLayer(std::size_t a_slot, std::string_view a_position, Entries& a_entries) const {
+		Tokenizer::LowerKey key(a_position);
+
+		std::shared_lock guard(lock);
+		if (a_slot >= contents.size()) {
+			return false;
+		}
+
+		auto it = contents[a_slot].find(key.Get());
+		if (it == contents[a_slot].end()) {
+			return false;
+		}
+
+		a_entries = it->second;
+		return true;
+	}
+
+	bool Index::Find(std::string_view a_position, bool a_isPlayer, Entries& a_entries) const {
+		Tokenizer::LowerKey key(a_position);
+
+		std::shared_lock guard(lock);
+		const auto& positions = merged[a_isPlayer];
+		auto it = positions.find(key.Get());
+		if (it == positions.end()) {
+			return false;
+		}
+
+		a_entries = *it->second;
+		return true;
+	}
+
+	std::size_t Index::GetPositionCount() const {
+		std::shared_lock guard(lock);
+		return merged[1].size();
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/PositionFile.h"
+#include "Core/Tokenizer.h"
+
+namespace PositionLayers {
+	using Entries = std::vector<PositionFile::Entry>;
+	using Positions = std::unordered_map<std::string, Entries, Tokenizer::StringHash, std::equal_to<>>;
+
+	struct Layer {
+		std::filesystem::path directory;
+		// Player layers only apply to player scenes, on top of every other layer
+		bool                  isPlayer;
+	};
+
+	std::string MakeKey(std::string_view a_position);
+	// Reads every position file of the directory, a missing directory is an empty layer
+	Positions ReadLayer(const std::filesystem::path& a_directory, std::uint32_t a_threadCount);
+
+	// Layers are ordered from the lowest to the highest priority and merged entry by entry, so a layer only has to hold what it changes.
+	// The merged result of every position is kept for both scene kinds, a lookup is a single probe however many layers there are.
+	class Index {
+	public:
+		void Reset(std::vector<Layer> a_layers, float a_bucketSize);
+		std::size_t GetLayerCount() const;
+		Layer GetLayer(std::size_t a_slot) const;
+
+		// Replaces the contents of one layer, only the positions in its old or new contents are merged again
+		void Assign(std::size_t a_slot, Positions a_positions);
+		void Assign(std::size_t a_slot, const std::filesystem::path& a_directory, Positions a_positions);
+		void Store(std::size_t a_slot, std::string_view a_position, Entries a_entries);
+		bool FindInLayer(std::size_t a_slot, std::string_view a_position, Entries& a_entries) const;
+		bool Find(std::string_view a_position, bool a_isPlayer, Entries& a_entries) const;
+		std::size_t GetPositionCount() const;
+
+	private:
+		using EntriesPtr = std::shared_ptr<const Entries>;
+
+		void Rebuild(const std::string& a_key);
+
+		float                                       bucketSize = 0.0f;
+		mutable std::shared_mutex                   lock;
+		std::vector<Layer>                          layers;
+		std::vector<Positions>                      contents;
+		std::unordered_map<std::string, EntriesPtr, Tokenizer::StringHash, std::equal_to<>> merged[2];
+	};
+}
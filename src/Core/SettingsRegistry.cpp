@@ -0,0 +1,381 @@
+#include "Core/SettingsRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Core/Tokenizer.h"
+
+using namespace std::literals;
+
+namespace Settings {
+	enum class TYPE : std::uint32_t {
+		kBool,
+		kUInt,
+		kFloat,
+		kEnum
+	};
+
+	struct Definition {
+		ID id;
+		std::string_view section;
+		std::string_view key;
+		TYPE type;
+		float min;
+		float max;
+		float defaultValue;
+	};
+
+	// uint and float values are clamped into [min, max], enum values outside of it are rejected
+	constexpr std::array<Definition, static_cast<std::size_t>(ID::kTotal)> g_definitions{
+		Definition{ ID::kSeparatePlayerOffset, "Settings"sv, "bSeparatePlayerOffset"sv, TYPE::kBool, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kUnifyAAFDoppelgangerScale, "Settings"sv, "bUnifyAAFDoppelgangerScale"sv, TYPE::kBool, 0.0f, 1.0f, 1.0f },
+		Definition{ ID::kPlayerPositionerType, "Settings"sv, "iPlayerPositionerType"sv, TYPE::kEnum, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kNPCPositionerType, "Settings"sv, "iNPCPositionerType"sv, TYPE::kEnum, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kMoveSpeed, "Movement"sv, "fMoveSpeed"sv, TYPE::kFloat, 0.0f, 1000.0f, 5.0f },
+		Definition{ ID::kMoveAcceleration, "Movement"sv, "fMoveAcceleration"sv, TYPE::kFloat, 0.0f, 1000.0f, 20.0f },
+		Definition{ ID::kMoveMaxSpeed, "Movement"sv, "fMoveMaxSpeed"sv, TYPE::kFloat, 0.0f, 1000.0f, 40.0f },
+		Definition{ ID::kStickDeadzone, "Movement"sv, "fStickDeadzone"sv, TYPE::kFloat, 0.0f, 0.95f, 0.2f },
+		Definition{ ID::kTelemetry, "Debug"sv, "bTelemetry"sv, TYPE::kBool, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kPrewarm, "Cache"sv, "bPrewarm"sv, TYPE::kBool, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kPrewarmThreads, "Cache"sv, "iPrewarmThreads"sv, TYPE::kUInt, 1.0f, 16.0f, 4.0f },
+		Definition{ ID::kPrewarmMemoryLimit, "Cache"sv, "iPrewarmMemoryLimitMB"sv, TYPE::kUInt, 1.0f, 1024.0f, 64.0f },
+		Definition{ ID::kScaleProfiles, "Settings"sv, "bScaleProfiles"sv, TYPE::kBool, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kScaleBucketSize, "Settings"sv, "fScaleBucketSize"sv, TYPE::kFloat, 0.01f, 1.0f, 0.05f },
+		Definition{ ID::kPrefetch, "Cache"sv, "bPrefetch"sv, TYPE::kBool, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kPrefetchCount, "Cache"sv, "iPrefetchCount"sv, TYPE::kUInt, 1.0f, 4.0f, 2.0f },
+		Definition{ ID::kBlendDuration, "Settings"sv, "fBlendDuration"sv, TYPE::kFloat, 0.0f, 5.0f, 0.0f },
+		Definition{ ID::kLODDistance, "Scheduler"sv, "fLODDistance"sv, TYPE::kFloat, 0.0f, 100000.0f, 0.0f },
+		Definition{ ID::kFrameBudget, "Scheduler"sv, "iFrameBudgetUS"sv, TYPE::kUInt, 0.0f, 100000.0f, 0.0f },
+		Definition{ ID::kNudgeStep, "Movement"sv, "fNudgeStep"sv, TYPE::kFloat, 0.01f, 1000.0f, 1.0f },
+		Definition{ ID::kOffsetLimit, "Movement"sv, "fOffsetLimit"sv, TYPE::kFloat, 0.0f, 100000.0f, 0.0f },
+		Definition{ ID::kAsyncLog, "Debug"sv, "bAsyncLog"sv, TYPE::kBool, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kLogRateLimit, "Debug"sv, "iLogRateLimit"sv, TYPE::kUInt, 0.0f, 10000.0f, 100.0f },
+		Definition{ ID::kLayers, "Cache"sv, "bLayers"sv, TYPE::kBool, 0.0f, 1.0f, 0.0f },
+		Definition{ ID::kRuleMemoBudget, "Memory"sv, "iRuleMemoBudgetKB"sv, TYPE::kUInt, 0.0f, 65536.0f, 1024.0f },
+		Definition{ ID::kMemoryLogInterval, "Memory"sv, "iLogIntervalSec"sv, TYPE::kUInt, 0.0f, 86400.0f, 0.0f },
+	};
+
+	constexpr bool IsDefinitionOrderValid() {
+		for (std::size_t ii = 0; ii < g_definitions.size(); ii++) {
+			if (static_cast<std::size_t>(g_definitions[ii].id) != ii) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static_assert(IsDefinitionOrderValid(), "Setting definitions must be ordered by ID");
+
+	constexpr char ToLower(char a_ch) {
+		return a_ch >= 'A' && a_ch <= 'Z' ? static_cast<char>(a_ch - 'A' + 'a') : a_ch;
+	}
+
+	// Case insensitive FNV-1a, the seed is searched at compile time so that every name lands in its own slot
+	constexpr std::uint32_t HashName(std::string_view a_name, std::uint32_t a_seed) {
+		std::uint32_t hash = 2166136261u ^ a_seed;
+		for (char ch : a_name) {
+			hash ^= static_cast<std::uint8_t>(ToLower(ch));
+			hash *= 16777619u;
+		}
+		return hash ^ (hash >> 15);
+	}
+
+	constexpr std::size_t kHashTableSize = std::bit_ceil(g_definitions.size() * 2);
+	constexpr std::uint32_t kInvalidSlot = 0xFFFFFFFF;
+
+	constexpr bool IsPerfectSeed(std::uint32_t a_seed) {
+		std::array<bool, kHashTableSize> used{};
+		for (const auto& def : g_definitions) {
+			std::size_t slot = HashName(def.key, a_seed) & (kHashTableSize - 1);
+			if (used[slot]) {
+				return false;
+			}
+			used[slot] = true;
+		}
+		return true;
+	}
+
+	constexpr std::uint32_t FindPerfectSeed() {
+		for (std::uint32_t seed = 0; seed < 0x10000; seed++) {
+			if (IsPerfectSeed(seed)) {
+				return seed;
+			}
+		}
+		return kInvalidSlot;
+	}
+
+	constexpr std::uint32_t kHashSeed = FindPerfectSeed();
+	static_assert(kHashSeed != kInvalidSlot, "No perfect hash seed found for the setting names");
+
+	constexpr std::array<std::uint32_t, kHashTableSize> BuildHashTable() {
+		std::array<std::uint32_t, kHashTableSize> table{};
+		table.fill(kInvalidSlot);
+		for (std::size_t ii = 0; ii < g_definitions.size(); ii++) {
+			table[HashName(g_definitions[ii].key, kHashSeed) & (kHashTableSize - 1)] = static_cast<std::uint32_t>(ii);
+		}
+		return table;
+	}
+
+	constexpr auto g_hashTable = BuildHashTable();
+
+	// bools and uints are stored as is, floats as their bit pattern
+	constexpr std::uint32_t EncodeDefault(const Definition& a_def) {
+		if (a_def.type == TYPE::kFloat) {
+			return std::bit_cast<std::uint32_t>(a_def.defaultValue);
+		}
+		return static_cast<std::uint32_t>(a_def.defaultValue);
+	}
+
+	using Slots = std::array<std::atomic<std::uint32_t>, g_definitions.size()>;
+
+	Slots g_values = []<std::size_t... I>(std::index_sequence<I...>) {
+		return Slots{ EncodeDefault(g_definitions[I])... };
+	}(std::make_index_sequence<g_definitions.size()>());
+
+	std::array<std::vector<Callback>, g_definitions.size()> g_callbacks;
+
+	const Definition& GetDefinition(ID a_id) {
+		return g_definitions[static_cast<std::size_t>(a_id)];
+	}
+
+	std::optional<ID> FindID(std::string_view a_name) {
+		std::uint32_t index = g_hashTable[HashName(a_name, kHashSeed) & (kHashTableSize - 1)];
+		if (index == kInvalidSlot) {
+			return std::nullopt;
+		}
+
+		std::string_view key = g_definitions[index].key;
+		if (key.size() != a_name.size() || !std::equal(key.begin(), key.end(), a_name.begin(), [](char a_l, char a_r) { return ToLower(a_l) == ToLower(a_r); })) {
+			return std::nullopt;
+		}
+
+		return g_definitions[index].id;
+	}
+
+	bool GetBool(ID a_id) {
+		return g_values[static_cast<std::size_t>(a_id)].load(std::memory_order_relaxed) != 0;
+	}
+
+	std::uint32_t GetUInt(ID a_id) {
+		return g_values[static_cast<std::size_t>(a_id)].load(std::memory_order_relaxed);
+	}
+
+	float GetFloat(ID a_id) {
+		return std::bit_cast<float>(g_values[static_cast<std::size_t>(a_id)].load(std::memory_order_relaxed));
+	}
+
+	std::optional<std::uint32_t> Encode(const Definition& a_def, double a_value) {
+		if (std::isnan(a_value)) {
+			return std::nullopt;
+		}
+
+		switch (a_def.type) {
+		case TYPE::kBool:
+			return a_value != 0.0 ? 1u : 0u;
+
+		case TYPE::kUInt:
+			return static_cast<std::uint32_t>(std::clamp(std::round(a_value), static_cast<double>(a_def.min), static_cast<double>(a_def.max)));
+
+		case TYPE::kEnum:
+			if (a_value != std::round(a_value) || a_value < a_def.min || a_value > a_def.max) {
+				return std::nullopt;
+			}
+			return static_cast<std::uint32_t>(a_value);
+
+		case TYPE::kFloat:
+			return std::bit_cast<std::uint32_t>(std::clamp(static_cast<float>(a_value), a_def.min, a_def.max));
+		}
+
+		return std::nullopt;
+	}
+
+	void LogValue(ID a_id) {
+		if (a_id >= ID::kTotal) {
+			return;
+		}
+
+		const Definition& def = GetDefinition(a_id);
+		switch (def.type) {
+		case TYPE::kBool:
+			spdlog::info("{}: {}", def.key, GetBool(def.id));
+			break;
+
+		case TYPE::kUInt:
+		case TYPE::kEnum:
+			spdlog::info("{}: {}", def.key, GetUInt(def.id));
+			break;
+
+		case TYPE::kFloat:
+			spdlog::info("{}: {}", def.key, GetFloat(def.id));
+			break;
+		}
+	}
+
+	bool SetValue(ID a_id, double a_value) {
+		if (a_id >= ID::kTotal) {
+			return false;
+		}
+
+		const Definition& def = GetDefinition(a_id);
+		auto encoded = Encode(def, a_value);
+		if (!encoded) {
+			return false;
+		}
+
+		std::uint32_t prevValue = g_values[static_cast<std::size_t>(a_id)].exchange(*encoded, std::memory_order_relaxed);
+		if (prevValue == *encoded) {
+			return true;
+		}
+
+		for (const auto& callback : g_callbacks[static_cast<std::size_t>(a_id)]) {
+			callback(a_id);
+		}
+
+		return true;
+	}
+
+	void ResetValue(ID a_id) {
+		if (a_id >= ID::kTotal) {
+			return;
+		}
+
+		SetValue(a_id, GetDefinition(a_id).defaultValue);
+	}
+
+	bool SetValue(std::string_view a_name, double a_value) {
+		auto id = FindID(a_name);
+		if (!id) {
+			return false;
+		}
+
+		return SetValue(*id, a_value);
+	}
+
+	// Callbacks have to be registered before the settings are loaded, they are not guarded against concurrent registration
+	void RegisterCallback(ID a_id, Callback a_callback) {
+		if (a_id >= ID::kTotal) {
+			return;
+		}
+
+		g_callbacks[static_cast<std::size_t>(a_id)].push_back(std::move(a_callback));
+	}
+
+	std::optional<std::size_t> FindDefinition(std::string_view a_section, std::string_view a_key) {
+		auto id = FindID(a_key);
+		if (!id || !Tokenizer::IEquals(GetDefinition(*id).section, a_section)) {
+			return std::nullopt;
+		}
+
+		return static_cast<std::size_t>(*id);
+	}
+
+	// Reads every known key in one pass over the file, the last occurrence of a key wins
+	RawValues ParseINI(std::string_view a_content) {
+		RawValues result;
+		std::string_view section;
+
+		Tokenizer::LineReader reader(a_content);
+		std::string_view line;
+		while (reader.Next(line)) {
+			line = Tokenizer::Trim(line);
+
+			if (line.empty() || line[0] == ';' || line[0] == '#') {
+				continue;
+			}
+
+			if (line[0] == '[') {
+				std::size_t sectionEnd = line.find(']');
+				section = sectionEnd != std::string_view::npos ? Tokenizer::Trim(line.substr(1, sectionEnd - 1)) : std::string_view{};
+				continue;
+			}
+
+			std::size_t separator = line.find('=');
+			if (separator == std::string_view::npos) {
+				continue;
+			}
+
+			auto index = FindDefinition(section, Tokenizer::Trim(line.substr(0, separator)));
+			if (!index) {
+				continue;
+			}
+
+			// Like GetPrivateProfileString, only whole lines are comments and a ';' after the '=' is part of the value
+			std::string_view value = Tokenizer::Trim(line.substr(separator + 1));
+
+			if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+				value = value.substr(1, value.size() - 2);
+			}
+
+			result[*index] = std::string(value);
+		}
+
+		return result;
+	}
+
+	bool ApplyValue(const Definition& a_def, std::string_view a_value) {
+		double value;
+		if (a_def.type == TYPE::kBool && Tokenizer::IEquals(a_value, "true"sv)) {
+			value = 1.0;
+		}
+		else if (a_def.type == TYPE::kBool && Tokenizer::IEquals(a_value, "false"sv)) {
+			value = 0.0;
+		}
+		else {
+			// The number at the start counts and the rest is ignored, the way the old std::stoul reads of the same file did
+			auto [ptr, ec] = std::from_chars(a_value.data(), a_value.data() + a_value.size(), value);
+			if (ec != std::errc() || ptr == a_value.data()) {
+				return false;
+			}
+		}
+
+		return SetValue(a_def.id, value);
+	}
+
+	void ApplyValues(const RawValues& a_values) {
+		for (std::size_t ii = 0; ii < g_definitions.size(); ii++) {
+			if (!a_values[ii]) {
+				continue;
+			}
+
+			if (!ApplyValue(g_definitions[ii], *a_values[ii])) {
+				spdlog::warn("Invalid value for {}: {}", g_definitions[ii].key, *a_values[ii]);
+			}
+		}
+	}
+
+	// Keys that were added, edited or removed between two reads of the file
+	std::vector<ID> DiffValues(const RawValues& a_previous, const RawValues& a_current) {
+		std::vector<ID> result;
+		for (std::size_t ii = 0; ii < g_definitions.size(); ii++) {
+			if (a_previous[ii] != a_current[ii]) {
+				result.push_back(g_definitions[ii].id);
+			}
+		}
+		return result;
+	}
+
+	// A key that is no longer in the file goes back to its default
+	void ApplyChanges(const RawValues& a_values, const std::vector<ID>& a_changed) {
+		for (ID id : a_changed) {
+			if (id >= ID::kTotal) {
+				continue;
+			}
+
+			const auto& value = a_values[static_cast<std::size_t>(id)];
+			if (!value) {
+				ResetValue(id);
+			}
+			else if (!ApplyValue(GetDefinition(id), *value)) {
+				spdlog::warn("Invalid value for {}: {}", GetDefinition(id).key, *value);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Settings {
+	enum class ID : std::uint32_t {
+		kSeparatePlayerOffset,
+		kUnifyAAFDoppelgangerScale,
+		kPlayerPositionerType,
+		kNPCPositionerType,
+		kMoveSpeed,
+		kMoveAcceleration,
+		kMoveMaxSpeed,
+		kStickDeadzone,
+		kTelemetry,
+		kPrewarm,
+		kPrewarmThreads,
+		kPrewarmMemoryLimit,
+		kScaleProfiles,
+		kScaleBucketSize,
+		kPrefetch,
+		kPrefetchCount,
+		kBlendDuration,
+		kLODDistance,
+		kFrameBudget,
+		kNudgeStep,
+		kOffsetLimit,
+		kAsyncLog,
+		kLogRateLimit,
+		kLayers,
+		kRuleMemoBudget,
+		kMemoryLogInterval,
+
+		kTotal
+	};
+
+	using Callback = std::function<void(ID)>;
+	using RawValues = std::array<std::optional<std::string>, static_cast<std::size_t>(ID::kTotal)>;
+
+	std::optional<ID> FindID(std::string_view a_name);
+	bool GetBool(ID a_id);
+	std::uint32_t GetUInt(ID a_id);
+	float GetFloat(ID a_id);
+	bool SetValue(ID a_id, double a_value);
+	bool SetValue(std::string_view a_name, double a_value);
+	void ResetValue(ID a_id);
+	void RegisterCallback(ID a_id, Callback a_callback);
+	void LogValue(ID a_id);
+
+	RawValues ParseINI(std::string_view a_content);
+	void ApplyValues(const RawValues& a_values);
+	std::vector<ID> DiffValues(const RawValues& a_previous, const RawValues& a_current);
+	void ApplyChanges(const RawValues& a_values, const std::vector<ID>& a_changed);
+}
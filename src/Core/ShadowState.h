@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ShadowState {
+	enum MUTATOR : std::uint32_t {
+		kSpell,
+		kRefScale,
+		kPosition,
+
+		kTotal
+	};
+
+	struct Counter {
+		std::uint64_t requested = 0;
+		std::uint64_t elided = 0;
+	};
+
+	// Skips engine mutations that would not change anything, the Engine policy provides the calls:
+	//   std::uint32_t GetID(Reference*), bool HasSpell/AddSpell/RemoveSpell(Actor*, Spell*),
+	//   void SetRefScale(Reference*, float), std::uint16_t GetRefScale(Reference*),
+	//   void ModPos(Reference*, char, float), float GetPosition(Reference*, std::size_t)
+	template <class Engine>
+	class Tracker {
+	public:
+		using Reference = typename Engine::Reference;
+		using Spell = typename Engine::Spell;
+
+		Tracker() = default;
+		explicit Tracker(Engine a_engine) : engine(std::move(a_engine)) {}
+
+		template <class Actor>
+		void AddSpell(Actor* a_actor, Spell* a_spell) {
+			if (!a_actor || !a_spell) {
+				return;
+			}
+
+			counters[kSpell].requested++;
+
+			Shadow& shadow = GetShadow(a_actor);
+			SpellState* state = FindSpellState(shadow, a_spell);
+			if (state && state->hasSpell) {
+				counters[kSpell].elided++;
+				return;
+			}
+
+			engine.AddSpell(a_actor, a_spell);
+			SetSpellState(shadow, a_spell, true);
+		}
+
+		// An unknown spell is checked once with HasSpell, a known one skips the check
+		template <class Actor>
+		void RemoveSpell(Actor* a_actor, Spell* a_spell) {
+			if (!a_actor || !a_spell) {
+				return;
+			}
+
+			counters[kSpell].requested++;
+
+			Shadow& shadow = GetShadow(a_actor);
+			SpellState* state = FindSpellState(shadow, a_spell);
+			if (state && !state->hasSpell) {
+				counters[kSpell].elided++;
+				return;
+			}
+
+			if (state || engine.HasSpell(a_actor, a_spell)) {
+				engine.RemoveSpell(a_actor, a_spell);
+			}
+			SetSpellState(shadow, a_spell, false);
+		}
+
+		// The refScale field is read back to notice scale changes made by anything else
+		void SetRefScale(Reference* a_refr, float a_scale) {
+			if (!a_refr) {
+				return;
+			}
+
+			counters[kRefScale].requested++;
+
+			Shadow& shadow = GetShadow(a_refr);
+			if (shadow.scale == a_scale && shadow.refScale == engine.GetRefScale(a_refr)) {
+				counters[kRefScale].elided++;
+				return;
+			}
+
+			engine.SetRefScale(a_refr, a_scale);
+			shadow.scale = a_scale;
+			shadow.refScale = engine.GetRefScale(a_refr);
+		}
+
+		// The position is read back as well, so a reference moved by the engine or another mod is moved again
+		void ModPos(Reference* a_refr, char a_axis, float a_value) {
+			if (!a_refr || a_axis < 'X' || a_axis > 'Z') {
+				return;
+			}
+
+			counters[kPosition].requested++;
+
+			std::size_t axis = static_cast<std::size_t>(a_axis - 'X');
+			Shadow& shadow = GetShadow(a_refr);
+			if (shadow.position[axis] == a_value && engine.GetPosition(a_refr, axis) == a_value) {
+				counters[kPosition].elided++;
+				return;
+			}
+
+			engine.ModPos(a_refr, a_axis, a_value);
+			shadow.position[axis] = a_value;
+		}
+
+		void Forget(Reference* a_refr) {
+			if (!a_refr) {
+				return;
+			}
+
+			shadows.erase(engine.GetID(a_refr));
+		}
+
+		void Reset() { shadows.clear(); }
+
+		const Counter& GetCounter(MUTATOR a_mutator) const { return counters[a_mutator]; }
+		std::size_t GetCount() const { return shadows.size(); }
+		Engine& GetEngine() { return engine; }
+
+	private:
+		struct SpellState {
+			Spell* spell;
+			bool   hasSpell;
+		};
+
+		// What the plugin last set on a reference, anything not set through here is unknown
+		struct Shadow {
+			Reference*                          refr = nullptr;
+			std::vector<SpellState>             spells;
+			std::optional<float>                scale;
+			std::uint16_t                       refScale = 0;
+			std::array<std::optional<float>, 3> position;
+		};
+
+		// A different reference behind the same ID means the actor was reloaded, so the old state no longer holds
+		Shadow& GetShadow(Reference* a_refr) {
+			Shadow& shadow = shadows[engine.GetID(a_refr)];
+			if (shadow.refr != a_refr) {
+				shadow = Shadow{};
+				shadow.refr = a_refr;
+			}
+			return shadow;
+		}
+
+		static SpellState* FindSpellState(Shadow& a_shadow, Spell* a_spell) {
+			for (auto& state : a_shadow.spells) {
+				if (state.spell == a_spell) {
+					return &state;
+				}
+			}
+			return nullptr;
+		}
+
+		static void SetSpellState(Shadow& a_shadow, Spell* a_spell, bool a_hasSpell) {
+			SpellState* state = FindSpellState(a_shadow, a_spell);
+			if (state) {
+				state->hasSpell = a_hasSpell;
+			}
+			else {
+				a_shadow.spells.push_back({ a_spell, a_hasSpell });
+			}
+		}
+
+		Engine                                    engine;
+		std::unordered_map<std::uint32_t, Shadow> shadows;
+		std::array<Counter, MUTATOR::kTotal>      counters;
+	};
+}
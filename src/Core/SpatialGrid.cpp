@@ -0,0 +1,220 @@
+#include "Core/SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace SpatialGrid {
+	float GetDistanceSq(const Vector3& a_lhs, const Vector3& a_rhs) {
+		float dx = a_lhs.x - a_rhs.x;
+		float dy = a_lhs.y - a_rhs.y;
+		float dz = a_lhs.z - a_rhs.z;
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	Grid::Grid(float a_cellSize) :
+		cellSize(a_cellSize > 0.0f ? a_cellSize : 1.0f) {}
+
+	std::int32_t Grid::GetCellCoord(float a_value) const {
+		float cell = std::floor(a_value / cellSize);
+		return static_cast<std::int32_t>(std::clamp(cell, -2147483648.0f, 2147483520.0f));
+	}
+
+	Grid::CellKey Grid::GetCellKey(std::int32_t a_x, std::int32_t a_y) const {
+		return (static_cast<CellKey>(static_cast<std::uint32_t>(a_x)) << 32) | static_cast<std::uint32_t>(a_y);
+	}
+
+	Grid::CellKey Grid::GetCellKey(const Vector3& a_position) const {
+		return GetCellKey(GetCellCoord(a_position.x), GetCellCoord(a_position.y));
+	}
+
+	// Only moves between cells touch the cell lists
+	void Grid::Update(std::uint32_t a_id, const Vector3& a_position) {
+		auto [it, inserted] = positions.try_emplace(a_id, a_position);
+		if (!inserted) {
+			CellKey prevKey = GetCellKey(it->second);
+			it->second = a_position;
+			if (prevKey == GetCellKey(a_position)) {
+				return;
+			}
+
+			auto cellIt = cells.find(prevKey);
+			if (cellIt != cells.end()) {
+				std::erase(cellIt->second, a_id);
+				if (cellIt->second.empty()) {
+					cells.erase(cellIt);
+				}
+			}
+		}
+
+		cells[GetCellKey(a_position)].push_back(a_id);
+	}
+
+	void Grid::Remove(std::uint32_t a_id) {
+		auto it = positions.find(a_id);
+		if (it == positions.end()) {
+			return;
+		}
+
+		auto cellIt = cells.find(GetCellKey(it->second));
+		if (cellIt != cells.end()) {
+			std::erase(cellIt->second, a_id);
+			if (cellIt->second.empty()) {
+				cells.erase(cellIt);
+			}
+		}
+
+		positions.erase(it);
+	}
+
+	void Grid::Clear() {
+		positions.clear();
+		cells.clear();
+	}
+
+	// Searches rings of cells around the point until no closer point can exist outside the searched square.
+	// Once a ring would cover more cells than are occupied, the remaining points are checked directly.
+	std::optional<std::uint32_t> Grid::FindNearest(const Vector3& a_point) const {
+		std::optional<std::uint32_t> result;
+		float bestDistanceSq = std::numeric_limits<float>::max();
+
+		auto check = [&](std::uint32_t a_id, const Vector3& a_position) {
+			float distanceSq = GetDistanceSq(a_position, a_point);
+			if (distanceSq < bestDistanceSq) {
+				bestDistanceSq = distanceSq;
+				result = a_id;
+			}
+		};
+
+		auto checkCell = [&](std::int64_t a_x, std::int64_t a_y) {
+			auto cellIt = cells.find(GetCellKey(static_cast<std::int32_t>(a_x), static_cast<std::int32_t>(a_y)));
+			if (cellIt != cells.end()) {
+				for (auto id : cellIt->second) {
+					check(id, positions.at(id));
+				}
+			}
+		};
+
+		std::int64_t centerX = GetCellCoord(a_point.x);
+		std::int64_t centerY = GetCellCoord(a_point.y);
+
+		for (std::int64_t ring = 0; !positions.empty(); ring++) {
+			if (ring > 0 && static_cast<std::size_t>(ring * 8) > cells.size()) {
+				for (const auto& [id, position] : positions) {
+					check(id, position);
+				}
+				break;
+			}
+
+			if (ring == 0) {
+				checkCell(centerX, centerY);
+			}
+			else {
+				for (std::int64_t d = -ring; d <= ring; d++) {
+					checkCell(centerX + d, centerY - ring);
+					checkCell(centerX + d, centerY + ring);
+				}
+				for (std::int64_t d = -ring + 1; d < ring; d++) {
+					checkCell(centerX - ring, centerY + d);
+					checkCell(centerX + ring, centerY + d);
+				}
+			}
+
+			// Every point outside the searched square is at least ring cells away in x or y
+			float reach = static_cast<float>(ring) * cellSize;
+			if (result && reach * reach >= bestDistanceSq) {
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	// Walks the cells along the ray, widened by the radius
+	std::optional<std::uint32_t> Grid::FindNearestToRay(const Vector3& a_origin, const Vector3& a_direction, float a_radius, float a_maxDistance) const {
+		float length = std::sqrt(a_direction.x * a_direction.x + a_direction.y * a_direction.y + a_direction.z * a_direction.z);
+		if (length <= 0.0f || positions.empty()) {
+			return std::nullopt;
+		}
+
+		Vector3 direction{ a_direction.x / length, a_direction.y / length, a_direction.z / length };
+
+		std::optional<std::uint32_t> result;
+		float bestDistanceSq = a_radius * a_radius;
+		float bestAlong = std::numeric_limits<float>::max();
+
+		auto check = [&](std::uint32_t a_id, const Vector3& a_position) {
+			Vector3 diff{ a_position.x - a_origin.x, a_position.y - a_origin.y, a_position.z - a_origin.z };
+			float along = diff.x * direction.x + diff.y * direction.y + diff.z * direction.z;
+			if (along < 0.0f || along > a_maxDistance) {
+				return;
+			}
+
+			Vector3 lateral{ diff.x - direction.x * along, diff.y - direction.y * along, diff.z - direction.z * along };
+			float distanceSq = lateral.x * lateral.x + lateral.y * lateral.y + lateral.z * lateral.z;
+			// Ties go to the point closer to the origin so that the actor in front wins
+			if (distanceSq < bestDistanceSq || (distanceSq == bestDistanceSq && along < bestAlong)) {
+				bestDistanceSq = distanceSq;
+				bestAlong = along;
+				result = a_id;
+			}
+		};
+
+		// A cell lookup costs about as much as checking 16 points, so a ray walking more cells than that is answered by checking every point
+		std::int32_t reach = static_cast<std::int32_t>(std::ceil(a_radius / cellSize));
+		float step = cellSize * 0.5f;
+		float stepCount = a_maxDistance / step + 1.0f;
+		if (stepCount * static_cast<float>((2 * reach + 1) * (2 * reach + 1)) > static_cast<float>(positions.size()) / 16.0f) {
+			for (const auto& [id, position] : positions) {
+				check(id, position);
+			}
+			return result;
+		}
+
+		std::vector<CellKey> keys;
+		for (float t = 0.0f;; t = std::min(t + step, a_maxDistance)) {
+			std::int32_t cellX = GetCellCoord(a_origin.x + direction.x * t);
+			std::int32_t cellY = GetCellCoord(a_origin.y + direction.y * t);
+
+			for (std::int32_t dx = -reach; dx <= reach; dx++) {
+				for (std::int32_t dy = -reach; dy <= reach; dy++) {
+					keys.push_back(GetCellKey(cellX + dx, cellY + dy));
+				}
+			}
+
+			if (t >= a_maxDistance) {
+				break;
+			}
+		}
+
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+		for (auto key : keys) {
+			auto cellIt = cells.find(key);
+			if (cellIt != cells.end()) {
+				for (auto id : cellIt->second) {
+					check(id, positions.at(id));
+				}
+			}
+		}
+
+		return result;
+	}
+
+	std::vector<std::uint32_t> Grid::SortByDistance(const Vector3& a_point) const {
+		std::vector<std::pair<float, std::uint32_t>> sorted;
+		sorted.reserve(positions.size());
+		for (const auto& [id, position] : positions) {
+			sorted.emplace_back(GetDistanceSq(position, a_point), id);
+		}
+		std::sort(sorted.begin(), sorted.end());
+
+		std::vector<std::uint32_t> result;
+		result.reserve(sorted.size());
+		for (const auto& [distanceSq, id] : sorted) {
+			result.push_back(id);
+		}
+		return result;
+	}
+}
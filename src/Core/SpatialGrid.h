@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Vector3.h"
+
+namespace SpatialGrid {
+	// Uniform grid over the x/y plane, distances are measured in 3D
+	class Grid {
+	public:
+		explicit Grid(float a_cellSize);
+
+		void Update(std::uint32_t a_id, const Vector3& a_position);
+		void Remove(std::uint32_t a_id);
+		void Clear();
+		std::size_t GetCount() const { return positions.size(); }
+
+		std::optional<std::uint32_t> FindNearest(const Vector3& a_point) const;
+		// Nearest point to the ray within a_radius of it, points behind the origin or farther than a_maxDistance along the ray are ignored
+		std::optional<std::uint32_t> FindNearestToRay(const Vector3& a_origin, const Vector3& a_direction, float a_radius, float a_maxDistance) const;
+		std::vector<std::uint32_t> SortByDistance(const Vector3& a_point) const;
+
+	private:
+		using CellKey = std::uint64_t;
+
+		CellKey GetCellKey(const Vector3& a_position) const;
+		CellKey GetCellKey(std::int32_t a_x, std::int32_t a_y) const;
+		std::int32_t GetCellCoord(float a_value) const;
+
+		float                                                   cellSize;
+		std::unordered_map<std::uint32_t, Vector3>              positions;
+		std::unordered_map<CellKey, std::vector<std::uint32_t>> cells;
+	};
+}
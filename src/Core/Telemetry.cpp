@@ -0,0 +1,333 @@
+#include "Core/Telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+namespace Telemetry {
+#ifdef _WIN32
+	constexpr const char* kRegionName = "Local\\AAFDynamicPositionerTelemetry";
+#else
+	constexpr const char* kRegionName = "/AAFDynamicPositionerTelemetry";
+#endif
+
+	std::atomic<bool> g_enabled = false;
+	std::mutex g_startLock;
+	void* g_handle = nullptr;
+	Region* g_region = nullptr;
+
+	// Pushes can come from the VM threads and the UI thread, the flag keeps the ring single-producer
+	std::atomic_flag g_writeLock = ATOMIC_FLAG_INIT;
+
+	Region* MapRegion(bool a_create, void*& a_handle) {
+#ifdef _WIN32
+		HANDLE mapping;
+		if (a_create) {
+			mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(sizeof(Region)), kRegionName);
+		}
+		else {
+			mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, kRegionName);
+		}
+
+		if (!mapping) {
+			return nullptr;
+		}
+
+		void* view = MapViewOfFile(mapping, a_create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, sizeof(Region));
+		if (!view) {
+			CloseHandle(mapping);
+			return nullptr;
+		}
+
+		a_handle = mapping;
+		return static_cast<Region*>(view);
+#else
+		int fd = a_create ? shm_open(kRegionName, O_CREAT | O_RDWR, 0644) : shm_open(kRegionName, O_RDONLY, 0);
+		if (fd < 0) {
+			return nullptr;
+		}
+
+		if (a_create && ftruncate(fd, sizeof(Region)) != 0) {
+			close(fd);
+			return nullptr;
+		}
+
+		void* view = mmap(nullptr, sizeof(Region), a_create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (view == MAP_FAILED) {
+			return nullptr;
+		}
+
+		a_handle = nullptr;
+		return static_cast<Region*>(view);
+#endif
+	}
+
+	void UnmapRegion(Region* a_region, void* a_handle) {
+		if (!a_region) {
+			return;
+		}
+
+#ifdef _WIN32
+		UnmapViewOfFile(a_region);
+		CloseHandle(a_handle);
+#else
+		(void)a_handle;
+		munmap(a_region, sizeof(Region));
+#endif
+	}
+
+	Reader::~Reader() {
+		Close();
+	}
+
+	bool Reader::Open() {
+		Close();
+
+		region = MapRegion(false, handle);
+		if (!region) {
+			return false;
+		}
+
+		if (region->magic != kMagic || region->version != kVersion || region->capacity != kRingCapacity || region->recordSize != sizeof(Record)) {
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void Reader::Close() {
+		UnmapRegion(region, handle);
+		region = nullptr;
+		handle = nullptr;
+	}
+
+	bool Reader::ReadSnapshot(Snapshot& a_snapshot) const {
+		if (!region) {
+			return false;
+		}
+
+		for (;;) {
+			std::uint64_t before = region->snapshotSequence.load(std::memory_order_acquire);
+			if (before & 1) {
+				continue;
+			}
+
+			std::memcpy(&a_snapshot, &region->snapshot, sizeof(Snapshot));
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (region->snapshotSequence.load(std::memory_order_relaxed) == before) {
+				return true;
+			}
+		}
+	}
+
+	// Returns false when no new record is available, a reader that fell behind by more than the capacity skips ahead
+	bool Reader::ReadNext(std::uint64_t& a_cursor, Record& a_record) const {
+		if (!region) {
+			return false;
+		}
+
+		for (;;) {
+			std::uint64_t writeIndex = region->writeIndex.load(std::memory_order_acquire);
+			if (a_cursor >= writeIndex) {
+				return false;
+			}
+
+			if (writeIndex - a_cursor > kRingCapacity) {
+				a_cursor = writeIndex - kRingCapacity;
+			}
+
+			const Slot& slot = region->slots[a_cursor % kRingCapacity];
+			std::uint64_t expected = a_cursor * 2 + 2;
+
+			std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+			if (before != expected) {
+				continue;
+			}
+
+			std::memcpy(&a_record, &slot.record, sizeof(Record));
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+				continue;
+			}
+
+			a_cursor++;
+			return true;
+		}
+	}
+
+	std::uint64_t Reader::GetWriteIndex() const {
+		return region ? region->writeIndex.load(std::memory_order_acquire) : 0;
+	}
+
+	bool Start() {
+		std::lock_guard lock(g_startLock);
+		if (g_region) {
+			return true;
+		}
+
+		Region* region = MapRegion(true, g_handle);
+		if (!region) {
+			return false;
+		}
+
+		new (region) Region{};
+		region->magic = kMagic;
+		region->version = kVersion;
+		region->capacity = kRingCapacity;
+		region->recordSize = sizeof(Record);
+
+		g_region = region;
+		g_enabled.store(true, std::memory_order_release);
+		return true;
+	}
+
+	void Stop() {
+		std::lock_guard lock(g_startLock);
+		if (!g_region) {
+			return;
+		}
+
+		g_enabled.store(false, std::memory_order_release);
+		while (g_writeLock.test_and_set(std::memory_order_acquire)) {}
+
+		UnmapRegion(g_region, g_handle);
+		g_region = nullptr;
+		g_handle = nullptr;
+
+#ifndef _WIN32
+		shm_unlink(kRegionName);
+#endif
+
+		g_writeLock.clear(std::memory_order_release);
+	}
+
+	bool IsEnabled() {
+		return g_enabled.load(std::memory_order_relaxed);
+	}
+
+	void UpdateTiming(Timing& a_timing, std::uint32_t a_duration) {
+		a_timing.count++;
+		a_timing.last = a_duration;
+		a_timing.max = std::max(a_timing.max, a_duration);
+	}
+
+	template <class F>
+	void WriteSnapshot(Region* a_region, F&& a_func) {
+		std::uint64_t sequence = a_region->snapshotSequence.load(std::memory_order_relaxed);
+		a_region->snapshotSequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		a_func(a_region->snapshot);
+
+		a_region->snapshotSequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	void Push(EVENT a_event, std::uint64_t a_sceneID, std::uint32_t a_formID, const Vector3& a_offset, std::uint32_t a_duration, std::string_view a_position) {
+		if (!IsEnabled()) {
+			return;
+		}
+
+		if (g_writeLock.test_and_set(std::memory_order_acquire)) {
+			// Dropping a record is preferred over stalling a game thread behind another writer
+			return;
+		}
+
+		Region* region = g_region;
+		if (region) {
+			std::uint64_t index = region->writeIndex.load(std::memory_order_relaxed);
+			Slot& slot = region->slots[index % kRingCapacity];
+
+			slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			Record& record = slot.record;
+			record.timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+			record.sceneID = a_sceneID;
+			record.event = a_event;
+			record.formID = a_formID;
+			record.duration = a_duration;
+			record.offset = a_offset;
+
+			std::size_t length = std::min<std::size_t>(a_position.size(), kMaxPositionLength - 1);
+			std::memcpy(record.position, a_position.data(), length);
+			record.position[length] = '\0';
+
+			slot.sequence.store(index * 2 + 2, std::memory_order_release);
+			region->writeIndex.store(index + 1, std::memory_order_release);
+
+			if (a_event == EVENT::kApplyOffset || a_event == EVENT::kLoadPosition || a_event == EVENT::kSavePosition) {
+				WriteSnapshot(region, [&](Snapshot& a_snapshot) {
+					if (a_event == EVENT::kApplyOffset) {
+						UpdateTiming(a_snapshot.apply, a_duration);
+					}
+					else if (a_event == EVENT::kLoadPosition) {
+						UpdateTiming(a_snapshot.load, a_duration);
+					}
+					else {
+						UpdateTiming(a_snapshot.save, a_duration);
+					}
+				});
+			}
+		}
+
+		g_writeLock.clear(std::memory_order_release);
+	}
+
+	void UpdateCounts(std::uint32_t a_activeScenes, std::uint32_t a_activeActors) {
+		if (!IsEnabled()) {
+			return;
+		}
+
+		while (g_writeLock.test_and_set(std::memory_order_acquire)) {}
+
+		if (g_region) {
+			WriteSnapshot(g_region, [&](Snapshot& a_snapshot) {
+				a_snapshot.activeScenes = a_activeScenes;
+				a_snapshot.activeActors = a_activeActors;
+			});
+		}
+
+		g_writeLock.clear(std::memory_order_release);
+	}
+
+	void UpdatePrefetch(std::uint64_t a_hits, std::uint64_t a_misses) {
+		if (!IsEnabled()) {
+			return;
+		}
+
+		while (g_writeLock.test_and_set(std::memory_order_acquire)) {}
+
+		if (g_region) {
+			WriteSnapshot(g_region, [&](Snapshot& a_snapshot) {
+				a_snapshot.prefetchHits = a_hits;
+				a_snapshot.prefetchMisses = a_misses;
+			});
+		}
+
+		g_writeLock.clear(std::memory_order_release);
+	}
+
+	std::uint64_t GetTimestamp() {
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	std::uint32_t GetElapsed(std::uint64_t a_since) {
+		return static_cast<std::uint32_t>(std::min<std::uint64_t>(GetTimestamp() - a_since, 0xFFFFFFFF));
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include "Core/Vector3.h"
+
+namespace Telemetry {
+	constexpr std::uint32_t kMagic = 0x54464141;  // AAFT
+	constexpr std::uint32_t kVersion = 2;
+	constexpr std::uint32_t kRingCapacity = 4096;
+	constexpr std::uint32_t kMaxPositionLength = 64;
+
+	enum class EVENT : std::uint32_t {
+		kSceneInit,
+		kAnimationChange,
+		kSceneEnd,
+		kApplyOffset,
+		kLoadPosition,
+		kSavePosition,
+		kPrefetch,
+
+		kTotal
+	};
+
+	struct Record {
+		std::uint64_t timestamp;  // microseconds since the epoch
+		std::uint64_t sceneID;
+		EVENT         event;
+		std::uint32_t formID;
+		std::uint32_t duration;  // microseconds
+		Vector3       offset;
+		char          position[kMaxPositionLength];
+	};
+
+	struct Timing {
+		std::uint64_t count;
+		std::uint32_t last;
+		std::uint32_t max;
+	};
+
+	struct Snapshot {
+		std::uint32_t activeScenes;
+		std::uint32_t activeActors;
+		Timing        apply;
+		Timing        load;
+		Timing        save;
+		std::uint64_t prefetchHits;
+		std::uint64_t prefetchMisses;
+	};
+
+	// Every slot and the snapshot are guarded by a sequence number that is odd while the block is being written
+	struct Slot {
+		std::atomic<std::uint64_t> sequence;
+		Record                     record;
+	};
+
+	struct Region {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t capacity;
+		std::uint32_t recordSize;
+
+		alignas(64) std::atomic<std::uint64_t> writeIndex;
+		alignas(64) std::atomic<std::uint64_t> snapshotSequence;
+		Snapshot snapshot;
+
+		alignas(64) Slot slots[kRingCapacity];
+	};
+
+	static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Telemetry requires lock-free 64-bit atomics");
+
+	class Reader {
+	public:
+		Reader() = default;
+		~Reader();
+
+		Reader(const Reader&) = delete;
+		Reader& operator=(const Reader&) = delete;
+
+		bool Open();
+		void Close();
+		bool ReadSnapshot(Snapshot& a_snapshot) const;
+		bool ReadNext(std::uint64_t& a_cursor, Record& a_record) const;
+		std::uint64_t GetWriteIndex() const;
+
+	private:
+		void*   handle = nullptr;
+		Region* region = nullptr;
+	};
+
+	bool Start();
+	void Stop();
+	bool IsEnabled();
+	void Push(EVENT a_event, std::uint64_t a_sceneID, std::uint32_t a_formID, const Vector3& a_offset, std::uint32_t a_duration, std::string_view a_position);
+	void UpdateCounts(std::uint32_t a_activeScenes, std::uint32_t a_activeActors);
+	void UpdatePrefetch(std::uint64_t a_hits, std::uint64_t a_misses);
+	std::uint64_t GetTimestamp();
+	std::uint32_t GetElapsed(std::uint64_t a_since);
+}
@@ -0,0 +1,139 @@
+#include "Core/Tokenizer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#	include <emmintrin.h>
+#	define TOKENIZER_USE_SSE2
+#endif
+
+namespace Tokenizer {
+	bool IsSpace(char a_ch) {
+		return a_ch == ' ' || (a_ch >= '\t' && a_ch <= '\r');
+	}
+
+	bool LineReader::Next(std::string_view& a_line) {
+		if (position >= buffer.size()) {
+			return false;
+		}
+
+		std::size_t lineEnd = FindFirstOf(buffer, position, '\n', '\n', '\n');
+		a_line = buffer.substr(position, lineEnd - position);
+		position = lineEnd + 1;
+
+		if (!a_line.empty() && a_line.back() == '\r') {
+			a_line.remove_suffix(1);
+		}
+
+		return true;
+	}
+
+	bool ReadFile(const std::string& a_path, std::string& a_buffer) {
+		std::ifstream file(a_path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		std::streamoff size = file.tellg();
+		if (size < 0) {
+			return false;
+		}
+
+		a_buffer.resize(static_cast<std::size_t>(size));
+		file.seekg(0);
+		file.read(a_buffer.data(), size);
+		return file.good() || file.eof();
+	}
+
+	// Returns the position of the first byte equal to any of the given characters, or the size of the string
+	std::size_t FindFirstOf(std::string_view a_str, std::size_t a_pos, char a_ch0, char a_ch1, char a_ch2) {
+		const char* data = a_str.data();
+		std::size_t size = a_str.size();
+
+#ifdef TOKENIZER_USE_SSE2
+		const __m128i ch0 = _mm_set1_epi8(a_ch0);
+		const __m128i ch1 = _mm_set1_epi8(a_ch1);
+		const __m128i ch2 = _mm_set1_epi8(a_ch2);
+
+		for (; a_pos + 16 <= size; a_pos += 16) {
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + a_pos));
+			__m128i match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, ch0), _mm_cmpeq_epi8(chunk, ch1)), _mm_cmpeq_epi8(chunk, ch2));
+			std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(match));
+			if (mask) {
+				return a_pos + std::countr_zero(mask);
+			}
+		}
+#endif
+
+		for (; a_pos < size; a_pos++) {
+			char ch = data[a_pos];
+			if (ch == a_ch0 || ch == a_ch1 || ch == a_ch2) {
+				return a_pos;
+			}
+		}
+
+		return size;
+	}
+
+	std::string_view Trim(std::string_view a_str) {
+		std::size_t begin = 0;
+		while (begin < a_str.size() && IsSpace(a_str[begin])) {
+			begin++;
+		}
+
+		std::size_t end = a_str.size();
+		while (end > begin && IsSpace(a_str[end - 1])) {
+			end--;
+		}
+
+		return a_str.substr(begin, end - begin);
+	}
+
+	// Reads up to the delimiter, which is consumed, or up to a comment, which is left in place so that every following read is empty
+	std::string_view GetNextData(std::string_view a_line, std::size_t& a_index, char a_delimiter) {
+		if (a_index >= a_line.size()) {
+			a_index = a_line.size();
+			return {};
+		}
+
+		char delimiter = a_delimiter != 0 ? a_delimiter : '#';
+		std::size_t end = FindFirstOf(a_line, a_index, '#', delimiter, delimiter);
+
+		std::string_view retVal = a_line.substr(a_index, end - a_index);
+		if (end < a_line.size() && a_line[end] != '#' && a_line[end] == delimiter) {
+			a_index = end + 1;
+		}
+		else {
+			a_index = end;
+		}
+
+		return Trim(retVal);
+	}
+
+	std::string ToLower(std::string_view a_str) {
+		std::string result(a_str);
+		std::transform(result.begin(), result.end(), result.begin(), [](unsigned char a_ch) { return static_cast<char>(std::tolower(a_ch)); });
+		return result;
+	}
+
+	bool IEquals(std::string_view a_lhs, std::string_view a_rhs) {
+		return a_lhs.size() == a_rhs.size() && std::equal(a_lhs.begin(), a_lhs.end(), a_rhs.begin(), [](char a_l, char a_r) {
+			return std::tolower(static_cast<unsigned char>(a_l)) == std::tolower(static_cast<unsigned char>(a_r));
+		});
+	}
+
+	LowerKey::LowerKey(std::string_view a_str) {
+		if (a_str.size() > kBufferSize) {
+			heap = ToLower(a_str);
+			view = heap;
+			return;
+		}
+
+		std::transform(a_str.begin(), a_str.end(), buffer, [](unsigned char a_ch) { return static_cast<char>(std::tolower(a_ch)); });
+		view = std::string_view(buffer, a_str.size());
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace Tokenizer {
+	class LineReader {
+	public:
+		explicit LineReader(std::string_view a_buffer) : buffer(a_buffer) {}
+
+		bool Next(std::string_view& a_line);
+
+	private:
+		std::string_view buffer;
+		std::size_t position = 0;
+	};
+
+	bool ReadFile(const std::string& a_path, std::string& a_buffer);
+	std::size_t FindFirstOf(std::string_view a_str, std::size_t a_pos, char a_ch0, char a_ch1, char a_ch2);
+	std::string_view Trim(std::string_view a_str);
+	std::string_view GetNextData(std::string_view a_line, std::size_t& a_index, char a_delimiter);
+
+	// Position names, file names and setting values are matched case-insensitively like the game's file system does
+	std::string ToLower(std::string_view a_str);
+	bool IEquals(std::string_view a_lhs, std::string_view a_rhs);
+
+	// Lowercases into a buffer on the stack so a lookup builds no key, only names longer than the buffer go to the heap
+	class LowerKey {
+	public:
+		explicit LowerKey(std::string_view a_str);
+		LowerKey(const LowerKey&) = delete;
+		LowerKey& operator=(const LowerKey&) = delete;
+
+		std::string_view Get() const { return view; }
+
+	private:
+		static constexpr std::size_t kBufferSize = 256;
+
+		char             buffer[kBufferSize];
+		std::string      heap;
+		std::string_view view;
+	};
+
+	// With std::equal_to<> lets maps keyed by std::string or std::pmr::string be searched with a std::string_view
+	struct StringHash {
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view a_str) const noexcept { return std::hash<std::string_view>{}(a_str); }
+	};
+
+	template <class T>
+	bool ParseNumber(std::string_view a_value, T& a_result) {
+		const char* begin = a_value.data();
+		const char* end = a_value.data() + a_value.size();
+		if (begin != end && *begin == '+') {
+			begin++;
+			if (begin != end && *begin == '-') {
+				return false;
+			}
+		}
+
+		auto [ptr, ec] = std::from_chars(begin, end, a_result);
+		return ec == std::errc() && ptr == end;
+	}
+}
@@ -0,0 +1,293 @@
+#include "Core/TransitionModel.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+#include "Core/Tokenizer.h"
+
+namespace TransitionModel {
+	constexpr std::uint32_t kInvalidName = std::numeric_limits<std::uint32_t>::max();
+
+	// Counts are halved once one of them reaches this, so recent sequences outweigh old ones
+	constexpr std::uint32_t kMaxCount = 1u << 16;
+
+	struct Successor {
+		std::uint32_t name = kInvalidName;
+		std::uint32_t count = 0;
+	};
+
+	struct State {
+		std::array<Successor, kMaxSuccessors> successors;
+		std::uint64_t                         lastUsed = 0;
+	};
+
+	std::mutex g_lock;
+	std::vector<std::string> g_names;
+	std::vector<std::uint32_t> g_refCounts;
+	std::vector<std::uint32_t> g_freeNames;
+	std::unordered_map<std::string, std::uint32_t, Tokenizer::StringHash, std::equal_to<>> g_nameMap;
+	std::unordered_map<std::uint32_t, State> g_states;
+	std::uint64_t g_tick = 0;
+	bool g_dirty = false;
+
+	std::uint32_t FindName(std::string_view a_name) {
+		Tokenizer::LowerKey key(a_name);
+		auto it = g_nameMap.find(key.Get());
+		return it != g_nameMap.end() ? it->second : kInvalidName;
+	}
+
+	void AddRef(std::uint32_t a_name) {
+		g_refCounts[a_name]++;
+	}
+
+	// A name nothing refers to any more goes back to the free list
+	void Release(std::uint32_t a_name) {
+		if (a_name == kInvalidName || --g_refCounts[a_name] > 0) {
+			return;
+		}
+
+		g_nameMap.erase(g_names[a_name]);
+		g_names[a_name].clear();
+		g_freeNames.push_back(a_name);
+	}
+
+	// A state holds a reference on its own name and on each successor's name
+	void EvictOldest() {
+		auto oldest = std::min_element(g_states.begin(), g_states.end(), [](const auto& a_lhs, const auto& a_rhs) {
+			return a_lhs.second.lastUsed < a_rhs.second.lastUsed;
+		});
+
+		std::uint32_t name = oldest->first;
+		std::array<Successor, kMaxSuccessors> successors = oldest->second.successors;
+		g_states.erase(oldest);
+
+		Release(name);
+		for (const auto& successor : successors) {
+			Release(successor.name);
+		}
+	}
+
+	// Positions are interned so the table only holds integers, once the limit is reached names of evicted states are reused
+	std::uint32_t InternName(std::string_view a_name) {
+		Tokenizer::LowerKey lowerName(a_name);
+		auto it = g_nameMap.find(lowerName.Get());
+		if (it != g_nameMap.end()) {
+			return it->second;
+		}
+		std::string key(lowerName.Get());
+
+		while (g_freeNames.empty() && g_names.size() >= kMaxNames && !g_states.empty()) {
+			EvictOldest();
+		}
+
+		std::uint32_t name;
+		if (!g_freeNames.empty()) {
+			name = g_freeNames.back();
+			g_freeNames.pop_back();
+			g_names[name] = key;
+		}
+		else if (g_names.size() < kMaxNames) {
+			name = static_cast<std::uint32_t>(g_names.size());
+			g_names.push_back(key);
+			g_refCounts.push_back(0);
+		}
+		else {
+			return kInvalidName;
+		}
+
+		g_nameMap.emplace(std::move(key), name);
+		return name;
+	}
+
+	// The least recently used state makes room for a new one once the table is full
+	State* GetState(std::uint32_t a_name) {
+		auto it = g_states.find(a_name);
+		if (it != g_states.end()) {
+			return &it->second;
+		}
+
+		if (g_states.size() >= kMaxStates) {
+			EvictOldest();
+		}
+
+		AddRef(a_name);
+		return &g_states[a_name];
+	}
+
+	void AddCount(State& a_state, std::uint32_t a_name, std::uint32_t a_count) {
+		Successor* target = nullptr;
+		for (auto& successor : a_state.successors) {
+			if (successor.name == a_name) {
+				target = &successor;
+				break;
+			}
+		}
+
+		// A new successor replaces the least frequent one
+		if (!target) {
+			target = &*std::min_element(a_state.successors.begin(), a_state.successors.end(), [](const Successor& a_lhs, const Successor& a_rhs) {
+				return a_lhs.count < a_rhs.count;
+			});
+			AddRef(a_name);
+			Release(target->name);
+			target->name = a_name;
+			target->count = 0;
+		}
+
+		target->count = std::min(target->count + a_count, kMaxCount);
+		if (target->count >= kMaxCount) {
+			for (auto& successor : a_state.successors) {
+				successor.count /= 2;
+			}
+		}
+	}
+
+	// Both names are held while the state is looked up, an eviction could free them otherwise
+	bool AddTransition(std::string_view a_from, std::string_view a_to, std::uint32_t a_count) {
+		std::uint32_t from = InternName(a_from);
+		if (from == kInvalidName) {
+			return false;
+		}
+		AddRef(from);
+
+		std::uint32_t to = InternName(a_to);
+		bool added = to != kInvalidName && to != from;
+		if (added) {
+			AddRef(to);
+
+			State* state = GetState(from);
+			state->lastUsed = ++g_tick;
+			AddCount(*state, to, a_count);
+
+			Release(to);
+		}
+
+		Release(from);
+		return added;
+	}
+
+	void Observe(std::string_view a_from, std::string_view a_to) {
+		if (a_from.empty() || a_to.empty()) {
+			return;
+		}
+
+		std::lock_guard lock(g_lock);
+
+		if (AddTransition(a_from, a_to, 1)) {
+			g_dirty = true;
+		}
+	}
+
+	std::vector<std::string> Predict(std::string_view a_from, std::size_t a_count) {
+		std::vector<std::string> result;
+
+		std::lock_guard lock(g_lock);
+
+		auto it = g_states.find(FindName(a_from));
+		if (it == g_states.end()) {
+			return result;
+		}
+
+		std::array<Successor, kMaxSuccessors> successors = it->second.successors;
+		std::sort(successors.begin(), successors.end(), [](const Successor& a_lhs, const Successor& a_rhs) {
+			return a_lhs.count > a_rhs.count;
+		});
+
+		for (const auto& successor : successors) {
+			if (result.size() >= a_count || successor.count == 0) {
+				break;
+			}
+			result.push_back(g_names[successor.name]);
+		}
+
+		return result;
+	}
+
+	// Each line holds one transition as from|to|count
+	bool Load(const std::string& a_path) {
+		std::string buffer;
+		if (!Tokenizer::ReadFile(a_path, buffer)) {
+			return false;
+		}
+
+		std::lock_guard lock(g_lock);
+
+		Tokenizer::LineReader reader(buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			line = Tokenizer::Trim(line);
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+
+			std::size_t index = 0;
+			std::string_view fromStr = Tokenizer::GetNextData(line, index, '|');
+			std::string_view toStr = Tokenizer::GetNextData(line, index, '|');
+			std::string_view countStr = Tokenizer::GetNextData(line, index, 0);
+
+			std::uint32_t count;
+			if (fromStr.empty() || toStr.empty() || !Tokenizer::ParseNumber(countStr, count)) {
+				spdlog::error("Cannot parse the transition: {}", line);
+				continue;
+			}
+
+			if (count > 0) {
+				AddTransition(fromStr, toStr, count);
+			}
+		}
+
+		g_dirty = false;
+		return true;
+	}
+
+	bool Save(const std::string& a_path) {
+		std::string buffer;
+		{
+			std::lock_guard lock(g_lock);
+			for (const auto& [from, state] : g_states) {
+				for (const auto& successor : state.successors) {
+					if (successor.count > 0) {
+						fmt::format_to(std::back_inserter(buffer), "{}|{}|{}\n", g_names[from], g_names[successor.name], successor.count);
+					}
+				}
+			}
+			g_dirty = false;
+		}
+
+		std::ofstream file(a_path, std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		return file.good();
+	}
+
+	bool IsDirty() {
+		std::lock_guard lock(g_lock);
+		return g_dirty;
+	}
+
+	std::size_t GetNameCount() {
+		std::lock_guard lock(g_lock);
+		return g_nameMap.size();
+	}
+
+	void Clear() {
+		std::lock_guard lock(g_lock);
+		g_names.clear();
+		g_refCounts.clear();
+		g_freeNames.clear();
+		g_nameMap.clear();
+		g_states.clear();
+		g_tick = 0;
+		g_dirty = false;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TransitionModel {
+	constexpr std::size_t kMaxStates = 4096;
+	constexpr std::size_t kMaxNames = 16384;
+	constexpr std::size_t kMaxSuccessors = 4;
+
+	void Observe(std::string_view a_from, std::string_view a_to);
+	std::vector<std::string> Predict(std::string_view a_from, std::size_t a_count);
+	bool Load(const std::string& a_path);
+	bool Save(const std::string& a_path);
+	bool IsDirty();
+	std::size_t GetNameCount();
+	void Clear();
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+struct Vector3 {
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+
+	bool operator==(const Vector3&) const = default;
+};
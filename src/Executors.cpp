@@ -0,0 +1,27 @@
+#include "Executors.h"
+
+namespace Executors {
+	// Runs work through the F4SE task queue, which the game drains on its main thread
+	class MainExecutor : public Async::Executor {
+	public:
+		void Post(std::function<void()> a_work) override {
+			const F4SE::TaskInterface* task = F4SE::GetTaskInterface();
+			if (!task) {
+				a_work();
+				return;
+			}
+
+			task->AddTask(std::move(a_work));
+		}
+	};
+
+	Async::Executor& GetIOExecutor() {
+		static Async::ThreadExecutor executor;
+		return executor;
+	}
+
+	Async::Executor& GetMainExecutor() {
+		static MainExecutor executor;
+		return executor;
+	}
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "Core/Async.h"
+
+namespace Executors {
+	Async::Executor& GetIOExecutor();
+	Async::Executor& GetMainExecutor();
+}
@@ -0,0 +1,38 @@
+#include "Forms.h"
+
+#include "Core/FormTable.h"
+
+namespace Forms {
+	// Ordered by FORM
+	constexpr std::array<FormTable::Identifier, static_cast<std::size_t>(FORM::kTotal)> g_identifiers{
+		FormTable::Identifier{ "AAFDynamicPositioner.esp"sv, 0x00000810 },	// kMovableHighlightSpell
+		FormTable::Identifier{ "AAFDynamicPositioner.esp"sv, 0x00000811 },	// kImmovableHighlightSpell
+	};
+
+	FormTable::Table<RE::TESForm, g_identifiers.size()> g_forms(g_identifiers);
+
+	void ResolveAll() {
+		RE::TESDataHandler* g_dataHandler = RE::TESDataHandler::GetSingleton();
+		if (!g_dataHandler) {
+			logger::critical("Cannot resolve forms: data handler is not ready");
+			return;
+		}
+
+		g_forms.Resolve([g_dataHandler](std::uint32_t a_formID, std::string_view a_pluginName) {
+			return g_dataHandler->LookupForm(a_formID, a_pluginName);
+		});
+	}
+
+	RE::TESForm* GetForm(FORM a_form) {
+		if (a_form >= FORM::kTotal) {
+			return nullptr;
+		}
+
+		// Natives can run before kGameLoaded when the plugin is loaded late, resolve on first use then
+		if (!g_forms.IsResolved()) {
+			ResolveAll();
+		}
+
+		return g_forms.Get(static_cast<std::size_t>(a_form));
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Forms {
+	enum class FORM : std::uint32_t {
+		kMovableHighlightSpell,
+		kImmovableHighlightSpell,
+
+		kTotal
+	};
+
+	void ResolveAll();
+	RE::TESForm* GetForm(FORM a_form);
+
+	template <class T>
+	T* Get(FORM a_form) {
+		RE::TESForm* form = GetForm(a_form);
+		return form ? form->As<T>() : nullptr;
+	}
+}
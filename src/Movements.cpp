@@ -0,0 +1,55 @@
+#include "Movements.h"
+
+#include "Inputs.h"
+#include "Settings.h"
+#include "Utils.h"
+
+namespace Movements {
+	MovementCurve::Integrator g_integrator;
+
+	bool IsEnabled() {
+		return g_integrator.IsEnabled();
+	}
+
+	void SetActiveAxis(std::uint32_t a_axis) {
+		g_integrator.SetAxis(a_axis);
+	}
+
+	void SetHeldKey(std::uint32_t a_keyCode, bool a_isDown) {
+		if (a_keyCode == Inputs::ACTION_KEY::kActionKey_LEFT) {
+			g_integrator.SetLeftHeld(a_isDown);
+		}
+		else if (a_keyCode == Inputs::ACTION_KEY::kActionKey_RIGHT) {
+			g_integrator.SetRightHeld(a_isDown);
+		}
+	}
+
+	void SetStickDeflection(float a_value) {
+		g_integrator.SetStick(a_value);
+	}
+
+	bool Update(float a_interval, RE::NiPoint3& a_delta) {
+		MovementCurve::Config config{
+			Settings::GetFloat(Settings::ID::kMoveSpeed),
+			Settings::GetFloat(Settings::ID::kMoveAcceleration),
+			Settings::GetFloat(Settings::ID::kMoveMaxSpeed),
+			Settings::GetFloat(Settings::ID::kStickDeadzone)
+		};
+
+		Vector3 delta;
+		if (!g_integrator.Update(config, a_interval, delta)) {
+			return false;
+		}
+
+		a_delta = Utils::ToNiPoint3(delta);
+		return true;
+	}
+
+	bool ConsumePendingSave() {
+		return g_integrator.ConsumePendingSave();
+	}
+
+	void Reset() {
+		g_integrator.Reset();
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Core/MovementCurve.h"
+
+namespace Movements {
+	using AXIS = MovementCurve::AXIS;
+
+	bool IsEnabled();
+	void SetActiveAxis(std::uint32_t a_axis);
+	void SetHeldKey(std::uint32_t a_keyCode, bool a_isDown);
+	void SetStickDeflection(float a_value);
+	bool Update(float a_interval, RE::NiPoint3& a_delta);
+	bool ConsumePendingSave();
+	void Reset();
+}
@@ -0,0 +1,58 @@
+#include "Mutators.h"
+
+#include "Core/ShadowState.h"
+#include "Utils.h"
+
+namespace Mutators {
+	// Engine calls behind the shadow state, the tests use a stand-in with the same shape
+	struct Engine {
+		using Reference = RE::TESObjectREFR;
+		using Spell = RE::SpellItem;
+
+		std::uint32_t GetID(RE::TESObjectREFR* a_refr) { return a_refr->formID; }
+		bool HasSpell(RE::Actor* a_actor, RE::SpellItem* a_spell) { return Utils::HasSpell(a_actor, a_spell); }
+		void AddSpell(RE::Actor* a_actor, RE::SpellItem* a_spell) { Utils::AddSpell(a_actor, a_spell); }
+		void RemoveSpell(RE::Actor* a_actor, RE::SpellItem* a_spell) { Utils::RemoveSpell(a_actor, a_spell); }
+		void SetRefScale(RE::TESObjectREFR* a_refr, float a_scale) { Utils::SetRefScale(a_refr, a_scale); }
+		std::uint16_t GetRefScale(RE::TESObjectREFR* a_refr) { return a_refr->refScale; }
+		void ModPos(RE::TESObjectREFR* a_refr, char a_axis, float a_value) { Utils::ModPos(a_refr, a_axis, a_value); }
+
+		float GetPosition(RE::TESObjectREFR* a_refr, std::size_t a_axis) {
+			return a_axis == 0 ? a_refr->data.location.x : a_axis == 1 ? a_refr->data.location.y : a_refr->data.location.z;
+		}
+	};
+
+	ShadowState::Tracker<Engine> g_tracker;
+
+	void AddSpell(RE::Actor* a_actor, RE::SpellItem* a_spell) {
+		g_tracker.AddSpell(a_actor, a_spell);
+	}
+
+	void RemoveSpell(RE::Actor* a_actor, RE::SpellItem* a_spell) {
+		g_tracker.RemoveSpell(a_actor, a_spell);
+	}
+
+	void SetRefScale(RE::TESObjectREFR* a_refr, float a_scale) {
+		g_tracker.SetRefScale(a_refr, a_scale);
+	}
+
+	void ModPos(RE::TESObjectREFR* a_refr, char a_axis, float a_value) {
+		g_tracker.ModPos(a_refr, a_axis, a_value);
+	}
+
+	void Forget(RE::TESObjectREFR* a_refr) {
+		g_tracker.Forget(a_refr);
+	}
+
+	void Reset() {
+		g_tracker.Reset();
+	}
+
+	void LogStats() {
+		const auto& spell = g_tracker.GetCounter(ShadowState::kSpell);
+		const auto& refScale = g_tracker.GetCounter(ShadowState::kRefScale);
+		const auto& position = g_tracker.GetCounter(ShadowState::kPosition);
+		logger::debug("Elided engine calls: spells {}/{}, ref scale {}/{}, position {}/{}",
+			spell.elided, spell.requested, refScale.elided, refScale.requested, position.elided, position.requested);
+	}
+}
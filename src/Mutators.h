@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Mutators {
+	void AddSpell(RE::Actor* a_actor, RE::SpellItem* a_spell);
+	void RemoveSpell(RE::Actor* a_actor, RE::SpellItem* a_spell);
+	void SetRefScale(RE::TESObjectREFR* a_refr, float a_scale);
+	void ModPos(RE::TESObjectREFR* a_refr, char a_axis, float a_value);
+	void Forget(RE::TESObjectREFR* a_refr);
+	void Reset();
+	void LogStats();
+}
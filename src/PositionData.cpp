@@ -1,80 +1,429 @@
-#include "PositionData.h"
-
-#include <fstream>
-
-#include "Positioners.h"
-#include "Utils.h"
-
-namespace PositionData {
-	std::vector<Data> LoadPositionData(const std::string& a_position, bool a_isPlayerScene) {
-		std::string posPath = a_isPlayerScene ?
-			fmt::format("Data\\F4SE\\Plugins\\{}\\Player\\{}.txt", Version::PROJECT, a_position) : fmt::format("Data\\F4SE\\Plugins\\{}\\{}.txt", Version::PROJECT, a_position);
-		std::ifstream posFile(posPath);
-
-		std::vector<Data> result;
-
-		if (!posFile.is_open()) {
-			return result;
-		}
-
-		std::string line;
-		std::string indexStr, offX, offY, offZ;
-		while (std::getline(posFile, line)) {
-			Utils::Trim(line);
-			if (line.empty() || line[0] == '#') {
-				continue;
-			}
-
-			std::uint32_t index = 0;
-
-			indexStr = Utils::GetNextData(line, index, '|');
-			if (indexStr.empty()) {
-				logger::error("Cannot read the position index: {}", line);
-				continue;
-			}
-
-			offX = Utils::GetNextData(line, index, ',');
-			if (offX.empty()) {
-				logger::error("Cannot read the offsetX: {}", line);
-				continue;
-			}
-
-			offY = Utils::GetNextData(line, index, ',');
-			if (offY.empty()) {
-				logger::error("Cannot read the offsetY: {}", line);
-				continue;
-			}
-
-			offZ = Utils::GetNextData(line, index, 0);
-			if (offZ.empty()) {
-				logger::error("Cannot read the offsetZ: {}", line);
-				continue;
-			}
-
-			result.push_back({ stoul(indexStr), RE::NiPoint3(stof(offX), stof(offY), stof(offZ)) });
-		}
-
-		return result;
-	}
-
-	bool SavePositionData(const std::string& a_position, const std::vector<std::uint32_t>& a_actors, bool a_isPlayerScene) {
-		std::string posPath = a_isPlayerScene ?
-			fmt::format("Data\\F4SE\\Plugins\\{}\\Player\\{}.txt", Version::PROJECT, a_position) : fmt::format("Data\\F4SE\\Plugins\\{}\\{}.txt", Version::PROJECT, a_position);
-		std::ofstream posFile(posPath);
-
-		if (!posFile.is_open()) {
-			return false;
-		}
-
-		for (auto formId : a_actors) {
-			Positioners::ActorData* actorData = Positioners::GetActorDataByFormID(formId);
-			if (!actorData) {
-				return false;
-			}
-
-			posFile << actorData->PositionIndex << "|" << actorData->Offset.x << "," << actorData->Offset.y << "," << actorData->Offset.z << std::endl;
-		}
-
-		return true;
-	}
-}
+#include "PositionData.h"
+
+#include "Core/OffsetProfiles.h"
+#include "Core/OffsetRules.h"
+#include "Core/PositionCache.h"
+#include "Core/PositionLayers.h"
+#include "Core/Telemetry.h"
+#include "Core/Tokenizer.h"
+#include "Executors.h"
+#include "Positioners.h"
+#include "Settings.h"
+#include "Utils.h"
+
+namespace PositionData {
+	std::jthread g_prewarmThread;
+
+	// 우선순위가 낮은 순서부터 이름 순서의 Packs\<이름>\, 플러그인 폴더, Profiles\<캐릭터>\, Player\ 레이어
+	// 슬롯과 프로필은 입출력 스레드에서만 바뀌며, 모든 읽기와 저장은 레이어를 만든 다음에 실행됨
+	PositionLayers::Index g_layers;
+	std::atomic<bool> g_layersReady = false;
+	std::size_t g_userSlot = 0;
+	std::size_t g_profileSlot = 0;
+	std::size_t g_playerSlot = 0;
+	std::string g_profile;
+
+	// 패턴에 맞는 모든 위치가 공유하는 오프셋, 위치에 자체 오프셋이 없을 때 사용
+	OffsetRules::Matcher g_rules;
+
+	// AAF XML에 오프셋이 구워진 위치, 씬이 시작되기 전 게임을 불러올 때 한 번 채움. 플레이어 씬용은 player/ 접두어로 구분
+	std::unordered_set<std::string> g_baked;
+	bool g_bakedPlayer = false;
+
+	std::string GetPositionPath(const std::string& a_position, bool a_isPlayerScene) {
+		return a_isPlayerScene ?
+			fmt::format("Data\\F4SE\\Plugins\\{}\\Player\\{}.txt", Version::PROJECT, a_position) : fmt::format("Data\\F4SE\\Plugins\\{}\\{}.txt", Version::PROJECT, a_position);
+	}
+
+	std::filesystem::path GetPluginDirectory() {
+		return fmt::format("Data\\F4SE\\Plugins\\{}", Version::PROJECT);
+	}
+
+	// 프로필이 없으면 빈 경로를 돌려주고, 빈 경로는 빈 레이어로 읽힘
+	std::filesystem::path GetProfileDirectory(const std::string& a_profile) {
+		return a_profile.empty() ? std::filesystem::path{} : GetPluginDirectory() / "Profiles" / a_profile;
+	}
+
+	bool IsLayersEnabled() {
+		return Settings::GetBool(Settings::ID::kLayers) && g_layersReady.load(std::memory_order_acquire);
+	}
+
+	// 프로필 이름은 플레이어 캐릭터의 이름에서 폴더 이름에 쓸 수 없는 문자를 뺀 것
+	std::string GetCurrentProfile() {
+		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
+		const char* name = g_player ? g_player->GetDisplayFullName() : nullptr;
+		if (!name) {
+			return {};
+		}
+
+		std::string result;
+		for (const char* ch = name; *ch; ch++) {
+			if (!std::strchr("<>:\"/\\|?*", *ch) && static_cast<unsigned char>(*ch) >= 0x20) {
+				result.push_back(*ch);
+			}
+		}
+		return result;
+	}
+
+	bool IsCacheEnabled() {
+		return Settings::GetBool(Settings::ID::kPrewarm) || Settings::GetBool(Settings::ID::kPrefetch);
+	}
+
+	// 액터의 오프셋을 읽고 저장할 스케일 구간을 돌려줌, 프로필이 꺼져 있으면 kNoScale
+	float GetProfileScale(RE::Actor* a_actor) {
+		if (!a_actor || !Settings::GetBool(Settings::ID::kScaleProfiles)) {
+			return PositionFile::kNoScale;
+		}
+
+		return OffsetProfiles::GetBucketScale(Utils::GetActualScale(a_actor), Settings::GetFloat(Settings::ID::kScaleBucketSize));
+	}
+
+	void StartPrewarm() {
+		if (g_prewarmThread.joinable()) {
+			return;
+		}
+
+		std::uint32_t threadCount = Settings::GetUInt(Settings::ID::kPrewarmThreads);
+		std::size_t memoryLimit = static_cast<std::size_t>(Settings::GetUInt(Settings::ID::kPrewarmMemoryLimit)) * 1024 * 1024;
+
+		g_prewarmThread = std::jthread([threadCount, memoryLimit](std::stop_token a_token) {
+			std::vector<PositionCache::Directory> directories{
+				{ fmt::format("Data\\F4SE\\Plugins\\{}", Version::PROJECT), false },
+				{ fmt::format("Data\\F4SE\\Plugins\\{}\\Player", Version::PROJECT), true }
+			};
+
+			std::uint64_t startTime = Telemetry::GetTimestamp();
+			PositionCache::Stats stats = PositionCache::Prewarm(directories, threadCount, memoryLimit, a_token);
+			std::uint32_t elapsed = Telemetry::GetElapsed(startTime);
+
+			if (stats.cancelled) {
+				logger::info("Position prewarm cancelled after {} files", stats.files);
+				return;
+			}
+
+			logger::info("Prewarmed {} position files ({} entries, {} KB) in {} ms with {} threads", stats.files, stats.entries, stats.memoryUsage / 1024, elapsed / 1000, threadCount);
+			if (stats.limitReached) {
+				logger::warn("Position prewarm stopped at the memory limit of {} MB", memoryLimit / (1024 * 1024));
+			}
+		});
+	}
+
+	void StopPrewarm() {
+		if (g_prewarmThread.joinable()) {
+			g_prewarmThread.request_stop();
+			g_prewarmThread.join();
+		}
+
+		g_prewarmThread = std::jthread();
+
+		// 미리 가져오기가 켜져 있으면 같은 캐시를 계속 사용하므로 비우지 않음
+		if (!Settings::GetBool(Settings::ID::kPrefetch)) {
+			PositionCache::Clear();
+		}
+	}
+
+	void BuildLayers(std::string a_profile) {
+		std::uint64_t startTime = Telemetry::GetTimestamp();
+		std::uint32_t threadCount = Settings::GetUInt(Settings::ID::kPrewarmThreads);
+
+		std::filesystem::path pluginDirectory = GetPluginDirectory();
+
+		std::vector<std::filesystem::path> packs;
+		std::error_code ec;
+		for (std::filesystem::directory_iterator it(pluginDirectory / "Packs", ec), end; !ec && it != end; it.increment(ec)) {
+			if (it->is_directory(ec)) {
+				packs.push_back(it->path());
+			}
+		}
+		std::sort(packs.begin(), packs.end());
+
+		std::vector<PositionLayers::Layer> layers;
+		for (const auto& pack : packs) {
+			layers.push_back({ pack, false });
+		}
+
+		g_userSlot = layers.size();
+		layers.push_back({ pluginDirectory, false });
+		g_profileSlot = layers.size();
+		layers.push_back({ GetProfileDirectory(a_profile), false });
+		g_playerSlot = layers.size();
+		layers.push_back({ pluginDirectory / "Player", true });
+
+		g_layers.Reset(layers, Settings::GetFloat(Settings::ID::kScaleBucketSize));
+		for (std::size_t ii = 0; ii < layers.size(); ii++) {
+			g_layers.Assign(ii, PositionLayers::ReadLayer(layers[ii].directory, threadCount));
+		}
+
+		g_profile = std::move(a_profile);
+		g_layersReady.store(true, std::memory_order_release);
+
+		logger::info("Merged {} position layers ({} packs) into {} positions in {} ms", layers.size(), packs.size(), g_layers.GetPositionCount(), Telemetry::GetElapsed(startTime) / 1000);
+	}
+
+	void StartLayers() {
+		if (!Settings::GetBool(Settings::ID::kLayers)) {
+			return;
+		}
+
+		Executors::GetIOExecutor().Post([profile = GetCurrentProfile()]() mutable {
+			if (!g_layersReady.load(std::memory_order_acquire)) {
+				BuildLayers(std::move(profile));
+			}
+		});
+	}
+
+	void StopLayers() {
+		Executors::GetIOExecutor().Post([]() {
+			g_layersReady.store(false, std::memory_order_release);
+			g_layers.Reset({}, 0.0f);
+		});
+	}
+
+	// 프로필 레이어만 다시 읽고 다른 레이어는 병합된 상태를 유지
+	void SwitchProfile() {
+		Executors::GetIOExecutor().Post([profile = GetCurrentProfile()]() mutable {
+			if (!g_layersReady.load(std::memory_order_acquire) || profile == g_profile) {
+				return;
+			}
+
+			std::uint64_t startTime = Telemetry::GetTimestamp();
+
+			std::filesystem::path directory = GetProfileDirectory(profile);
+			g_layers.Assign(g_profileSlot, directory, PositionLayers::ReadLayer(directory, Settings::GetUInt(Settings::ID::kPrewarmThreads)));
+			g_profile = std::move(profile);
+
+			logger::info("Switched to the position profile '{}' in {} ms", g_profile, Telemetry::GetElapsed(startTime) / 1000);
+		});
+	}
+
+	// 규칙 파일은 이름 순서로 읽으며, 우선순위가 같으면 먼저 읽은 파일에 선언된 규칙이 이김
+	void LoadRules() {
+		Executors::GetIOExecutor().Post([]() {
+			std::uint64_t startTime = Telemetry::GetTimestamp();
+
+			std::vector<std::filesystem::path> files;
+			std::error_code ec;
+			for (std::filesystem::directory_iterator it(GetPluginDirectory() / "Rules", ec), end; !ec && it != end; it.increment(ec)) {
+				if (it->is_regular_file(ec) && it->path().extension() == ".txt") {
+					files.push_back(it->path());
+				}
+			}
+			std::sort(files.begin(), files.end());
+
+			std::vector<OffsetRules::Rule> rules;
+			std::string buffer;
+			for (const auto& file : files) {
+				if (!Tokenizer::ReadFile(file.string(), buffer)) {
+					logger::warn("Cannot read the rule file: {}", file.string());
+					continue;
+				}
+
+				for (auto& rule : OffsetRules::Parse(buffer)) {
+					OffsetProfiles::Sort(rule.entries);
+					rules.push_back(std::move(rule));
+				}
+			}
+
+			std::size_t count = g_rules.Compile(std::move(rules));
+			if (count > 0) {
+				logger::info("Compiled {} offset rules from {} files in {} ms", count, files.size(), Telemetry::GetElapsed(startTime) / 1000);
+			}
+		});
+	}
+
+	// Baked.txt는 위치 도구의 bake 명령이 쓰는 보고서, 한 줄에 위치 하나이고 Player/ 줄은 플레이어 씬용
+	void LoadBaked() {
+		g_baked.clear();
+		g_bakedPlayer = false;
+
+		std::string buffer;
+		if (!Tokenizer::ReadFile((GetPluginDirectory() / "Baked.txt").string(), buffer)) {
+			return;
+		}
+
+		Tokenizer::LineReader reader(buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			line = Tokenizer::Trim(line);
+			if (!line.empty() && line[0] != '#') {
+				std::string key = PositionLayers::MakeKey(line);
+				std::replace(key.begin(), key.end(), '\\', '/');
+				g_bakedPlayer = g_bakedPlayer || key.starts_with("player/");
+				g_baked.insert(std::move(key));
+			}
+		}
+
+		logger::info("{} positions are baked into the AAF data", g_baked.size());
+		if (!g_baked.empty() && Settings::GetBool(Settings::ID::kSeparatePlayerOffset) && !g_bakedPlayer) {
+			logger::warn("Baked.txt has no player positions, player scenes load their Player offsets on top of the baked ones, bake with --separate-player");
+		}
+	}
+
+	bool IsBaked(const std::string& a_position, bool a_isPlayerScene) {
+		if (g_baked.empty()) {
+			return false;
+		}
+		return g_baked.contains(a_isPlayerScene ? "player/" + PositionLayers::MakeKey(a_position) : PositionLayers::MakeKey(a_position));
+	}
+
+	// 읽기에 실패한 이유가 파일이 없어서일 때만 참, 잠겨 있던 파일은 다음에 다시 읽음
+	bool IsMissing(const std::string& a_path) {
+		std::error_code ec;
+		return !std::filesystem::exists(a_path, ec) && !ec;
+	}
+
+	// 캐시에서 읽은 경우에만 a_fromCache를 설정하여 미리 읽기의 적중을 판단할 수 있게 함
+	std::vector<Data> ReadPositionData(const std::string& a_position, bool a_isPlayerScene, bool& a_fromCache) {
+		std::uint64_t startTime = Telemetry::GetTimestamp();
+
+		a_fromCache = false;
+
+		std::vector<Data> result;
+		if (IsLayersEnabled()) {
+			g_layers.Find(a_position, a_isPlayerScene, result);
+			Telemetry::Push(Telemetry::EVENT::kLoadPosition, 0, 0, Vector3{}, Telemetry::GetElapsed(startTime), a_position);
+			return result;
+		}
+
+		bool useCache = IsCacheEnabled();
+
+		if (useCache && PositionCache::Find(a_position, a_isPlayerScene, result)) {
+			a_fromCache = true;
+			Telemetry::Push(Telemetry::EVENT::kLoadPosition, 0, 0, Vector3{}, Telemetry::GetElapsed(startTime), a_position);
+			return result;
+		}
+
+		std::string posPath = GetPositionPath(a_position, a_isPlayerScene);
+
+		if (PositionFile::Load(posPath, result)) {
+			OffsetProfiles::Sort(result);
+			if (useCache) {
+				PositionCache::Store(a_position, a_isPlayerScene, result);
+			}
+		}
+		else if (useCache && IsMissing(posPath)) {
+			PositionCache::StoreMissing(a_position, a_isPlayerScene);
+		}
+
+		Telemetry::Push(Telemetry::EVENT::kLoadPosition, 0, 0, Vector3{}, Telemetry::GetElapsed(startTime), a_position);
+
+		return result;
+	}
+
+	std::vector<Data> LoadPositionData(const std::string& a_position, bool a_isPlayerScene, bool* a_fromCache) {
+		bool fromCache;
+		std::vector<Data> result = ReadPositionData(a_position, a_isPlayerScene, fromCache);
+		if (a_fromCache) {
+			*a_fromCache = fromCache;
+		}
+
+		if (result.empty()) {
+			g_rules.Match(a_position, result);
+		}
+		return result;
+	}
+
+	// AnimationChange 전에 위치를 미리 캐시에 읽어 둠, 입출력 스레드에서 실행
+	void Prefetch(const std::string& a_position, bool a_isPlayerScene) {
+		if (IsLayersEnabled() || IsBaked(a_position, a_isPlayerScene) || PositionCache::Contains(a_position, a_isPlayerScene)) {
+			return;
+		}
+
+		std::uint64_t startTime = Telemetry::GetTimestamp();
+
+		std::string posPath = GetPositionPath(a_position, a_isPlayerScene);
+
+		std::vector<Data> result;
+		if (!PositionFile::Load(posPath, result)) {
+			if (IsMissing(posPath)) {
+				PositionCache::StoreMissing(a_position, a_isPlayerScene);
+			}
+			return;
+		}
+
+		OffsetProfiles::Sort(result);
+		PositionCache::Store(a_position, a_isPlayerScene, result);
+
+		Telemetry::Push(Telemetry::EVENT::kPrefetch, 0, 0, Vector3{}, Telemetry::GetElapsed(startTime), a_position);
+	}
+
+	// 플레이어 씬은 플레이어 레이어에, 그 외에는 프로필 폴더가 있으면 프로필에, 없으면 플러그인 폴더에 저장
+	// 해당 레이어가 가진 항목에만 새 항목을 병합하므로 파일은 하위 레이어에 대한 변경분으로 유지됨
+	void SaveLayeredPosition(const std::string& a_position, bool a_isPlayerScene, const std::vector<Data>& a_entries) {
+		std::uint64_t startTime = Telemetry::GetTimestamp();
+
+		std::size_t slot = g_userSlot;
+		if (a_isPlayerScene) {
+			slot = g_playerSlot;
+		}
+		else {
+			std::error_code ec;
+			std::filesystem::path profileDirectory = g_layers.GetLayer(g_profileSlot).directory;
+			if (!profileDirectory.empty() && std::filesystem::is_directory(profileDirectory, ec)) {
+				slot = g_profileSlot;
+			}
+		}
+
+		std::string posPath = (g_layers.GetLayer(slot).directory / (a_position + ".txt")).string();
+
+		// 규칙이 적용되던 위치를 처음 저장할 때는 하위 레이어에 이미 있는 경우가 아니면 규칙의 나머지 항목을 유지
+		std::vector<Data> merged;
+		if (!g_layers.FindInLayer(slot, a_position, merged)) {
+			std::vector<Data> lower;
+			if (!g_layers.Find(a_position, a_isPlayerScene, lower)) {
+				g_rules.Match(a_position, merged);
+			}
+		}
+		OffsetProfiles::Merge(merged, a_entries, Settings::GetFloat(Settings::ID::kScaleBucketSize));
+
+		if (!PositionFile::Save(posPath, merged)) {
+			logger::warn("Cannot save the position data: {}", posPath);
+			return;
+		}
+
+		g_layers.Store(slot, a_position, std::move(merged));
+
+		Telemetry::Push(Telemetry::EVENT::kSavePosition, 0, 0, Vector3{}, Telemetry::GetElapsed(startTime), a_position);
+	}
+
+	bool SavePositionData(const std::string& a_position, const std::pmr::vector<std::uint32_t>& a_actors, bool a_isPlayerScene) {
+		std::string posPath = GetPositionPath(a_position, a_isPlayerScene);
+
+		std::vector<Data> entries;
+		for (auto formId : a_actors) {
+			Positioners::ActorData* actorData = Positioners::GetActorDataByFormID(formId);
+			if (!actorData) {
+				return false;
+			}
+
+			entries.push_back({ actorData->PositionIndex, Utils::ToVector3(actorData->Offset), GetProfileScale(actorData->Actor) });
+		}
+
+		// 파일은 입출력 스레드에서 저장되며, 먼저 대기열에 들어간 같은 위치의 읽기가 끝난 뒤에 실행됨
+		Executors::GetIOExecutor().Post([a_position, a_isPlayerScene, posPath = std::move(posPath), entries = std::move(entries)]() {
+			if (IsLayersEnabled()) {
+				SaveLayeredPosition(a_position, a_isPlayerScene, entries);
+				return;
+			}
+
+			std::uint64_t startTime = Telemetry::GetTimestamp();
+
+			// 파일에 이미 있는 다른 스케일 구간과 액터 인덱스는 그대로 유지
+			std::vector<Data> merged = LoadPositionData(a_position, a_isPlayerScene);
+			OffsetProfiles::Merge(merged, entries, Settings::GetFloat(Settings::ID::kScaleBucketSize));
+
+			if (!PositionFile::Save(posPath, merged)) {
+				logger::warn("Cannot save the position data: {}", posPath);
+				return;
+			}
+
+			if (IsCacheEnabled()) {
+				PositionCache::Store(a_position, a_isPlayerScene, merged);
+			}
+
+			Telemetry::Push(Telemetry::EVENT::kSavePosition, 0, 0, Vector3{}, Telemetry::GetElapsed(startTime), a_position);
+		});
+
+		return true;
+	}
+}
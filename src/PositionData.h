@@ -1,11 +1,20 @@
-#pragma once
-
-namespace PositionData {
-	struct Data {
-		std::uint32_t index;
-		RE::NiPoint3  offset;
-	};
-
-	std::vector<Data> LoadPositionData(const std::string& a_position, bool a_isPlayerScene);
-	bool SavePositionData(const std::string& a_position, const std::vector<std::uint32_t>& a_actorList, bool a_isPlayerScene);
-}
+#pragma once
+
+#include "Core/PositionFile.h"
+
+namespace PositionData {
+	using Data = PositionFile::Entry;
+
+	float GetProfileScale(RE::Actor* a_actor);
+	void StartPrewarm();
+	void StopPrewarm();
+	void StartLayers();
+	void StopLayers();
+	void SwitchProfile();
+	void LoadRules();
+	void LoadBaked();
+	bool IsBaked(const std::string& a_position, bool a_isPlayerScene);
+	void Prefetch(const std::string& a_position, bool a_isPlayerScene);
+	std::vector<Data> LoadPositionData(const std::string& a_position, bool a_isPlayerScene, bool* a_fromCache = nullptr);
+	bool SavePositionData(const std::string& a_position, const std::pmr::vector<std::uint32_t>& a_actorList, bool a_isPlayerScene);
+}
@@ -1,673 +1,1267 @@
-#include "Positioners.h"
-
-#include "Scaleforms.h"
-#include "PositionData.h"
-#include "Utils.h"
-
-namespace Positioners {
-	struct SceneData {
-		std::uint64_t              SceneID;
-		std::string                Position;
-		std::vector<std::uint32_t> ActorList;
-	};
-
-	enum POSITIONER_TYPE : std::uint32_t {
-		kRelative = 0,
-		kAbsolute
-	};
-
-	std::uint32_t g_playerPositionerType = POSITIONER_TYPE::kRelative;
-	std::uint32_t g_npcPositionerType = POSITIONER_TYPE::kRelative;
-
-	enum CAN_MOVE : std::uint32_t {
-		kYes = 0,
-		kNo_Selection,
-		kNo_Scale,
-	};
-
-	std::unordered_map<std::uint32_t, ActorData> g_actorMap;
-	std::unordered_map<std::uint64_t, SceneData> g_sceneMap;
-
-	bool g_separatePlayerOffset = false;
-	bool g_unifyAAFDoppelgangerScale = true;
-	std::uint64_t g_sceneMapKey = 1;
-	std::uint32_t g_selectedActorFormID = 0;
-
-	std::uint32_t GetSelectedActorFormID() {
-		return g_selectedActorFormID;
-	}
-
-	void SetSelectedActorFormID(std::uint32_t a_formID) {
-		g_selectedActorFormID = a_formID;
-	}
-
-	void ClearSelectedActorFormID() {
-		SetSelectedActorFormID(0);
-	}
-
-	ActorData* GetActorDataByFormID(std::uint32_t a_formID) {
-		auto it = g_actorMap.find(a_formID);
-		if (it == g_actorMap.end()) {
-			return nullptr;
-		}
-
-		return &it->second;
-	}
-
-	ActorData* GetPlayerActorData() {
-		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
-		if (!g_player) {
-			return nullptr;
-		}
-
-		return GetActorDataByFormID(g_player->formID);
-	}
-
-	ActorData* GetSelectedActorData() {
-		if (!GetSelectedActorFormID()) {
-			return nullptr;
-		}
-
-		return GetActorDataByFormID(GetSelectedActorFormID());
-	}
-
-	SceneData* GetSceneDataByID(std::uint64_t a_sceneID) {
-		auto it = g_sceneMap.find(a_sceneID);
-		if (it == g_sceneMap.end()) {
-			return nullptr;
-		}
-
-		return &it->second;
-	}
-
-	std::uint64_t GetSceneIDFromActorList(const RE::BSTArray<RE::Actor*>& a_actorList) {
-		for (auto actor : a_actorList) {
-			ActorData* actorData = GetActorDataByFormID(actor->formID);
-			if (!actorData) {
-				continue;
-			}
-
-			// 액터를 이용하여 씬의 ID를 가져옴
-			return actorData->SceneID;
-		}
-
-		return 0;
-	}
-
-	ExtraRefrPath* GetExtraRefrPath(RE::Actor* a_actor) {
-		if (!a_actor) {
-			return nullptr;
-		}
-
-		RE::BSExtraData* refrPath = a_actor->extraList->extraData.GetByType(RE::EXTRA_DATA_TYPE::kRefrPath);
-		if (!refrPath) {
-			return nullptr;
-		}
-
-		return (ExtraRefrPath*)refrPath;
-	}
-
-	RE::SpellItem* GetHighlightSpell(bool a_isMovable) {
-		static RE::SpellItem* movableSpell = nullptr;
-		static RE::SpellItem* immovableSpell = nullptr;
-
-		if (a_isMovable) {
-			if (!movableSpell) {
-				auto movableSpellForm = Utils::GetFormFromIdentifier("AAFDynamicPositioner.esp"sv, 0x00000810);
-				if (movableSpellForm) {
-					movableSpell = movableSpellForm->As<RE::SpellItem>();
-				}
-			}
-			return movableSpell;
-		}
-		else {
-			if (!immovableSpell) {
-				auto immovableSpellForm = Utils::GetFormFromIdentifier("AAFDynamicPositioner.esp"sv, 0x00000811);
-				if (immovableSpellForm) {
-					immovableSpell = immovableSpellForm->As<RE::SpellItem>();
-				}
-			}
-			return immovableSpell;
-		}
-	}
-
-	void ClearHighlightSpellFromActor(RE::Actor* a_actor) {
-		if (Utils::HasSpell(a_actor, GetHighlightSpell(true))) {
-			Utils::RemoveSpell(a_actor, GetHighlightSpell(true));
-		}
-		if (Utils::HasSpell(a_actor, GetHighlightSpell(false))) {
-			Utils::RemoveSpell(a_actor, GetHighlightSpell(false));
-		}
-	}
-
-	bool IsPlayerInScene(SceneData* a_sceneData) {
-		if (!a_sceneData) {
-			return false;
-		}
-
-		ActorData* playerActorData = GetPlayerActorData();
-		if (!playerActorData) {
-			return false;
-		}
-
-		for (auto formId : a_sceneData->ActorList) {
-			if (formId == playerActorData->FormID) {
-				return true;
-			}
-		}
-
-		return false;
-	}
-
-	bool IsActorInPlayerScene(ActorData* a_actorData) {
-		if (!a_actorData) {
-			return false;
-		}
-
-		ActorData* playerActorData = GetPlayerActorData();
-		if (!playerActorData) {
-			return false;
-		}
-
-		if (a_actorData->SceneID == playerActorData->SceneID) {
-			return true;
-		}
-
-		return false;
-	}
-
-	bool IsActorScale1(RE::Actor* a_actor) {
-		if (!a_actor) {
-			return false;
-		}
-
-		float actorScale = Utils::GetActualScale(a_actor);
-		std::uint32_t intScale = static_cast<std::uint32_t>(std::round(actorScale * 100));
-		if (intScale == 100) {
-			return true;
-		}
-		return false;
-	}
-
-	std::vector<PositionData::Data> LoadPosition(SceneData* a_sceneData) {
-		if (!a_sceneData) {
-			return std::vector<PositionData::Data>();
-		}
-
-		return PositionData::LoadPositionData(a_sceneData->Position, g_separatePlayerOffset ? IsPlayerInScene(a_sceneData) : false);
-	}
-
-	void SavePosition(SceneData* a_sceneData) {
-		if (!a_sceneData) {
-			return;
-		}
-
-		PositionData::SavePositionData(a_sceneData->Position, a_sceneData->ActorList, g_separatePlayerOffset ? IsPlayerInScene(a_sceneData) : false);
-	}
-
-	void SavePosition(ActorData* a_actorData) {
-		if (!a_actorData) {
-			return;
-		}
-
-		SavePosition(GetSceneDataByID(a_actorData->SceneID));
-	}
-
-	std::vector<PositionData::Data> GetPreviousPosition(SceneData* a_sceneData) {
-		std::vector<PositionData::Data> retVec;
-
-		if (!a_sceneData) {
-			return retVec;
-		}
-
-		for (auto actorFormID : a_sceneData->ActorList) {
-			auto actorData = GetActorDataByFormID(actorFormID);
-			if (!actorData) {
-				continue;
-			}
-
-			PositionData::Data nData;
-			nData.index = actorData->PositionIndex;
-			nData.offset = actorData->Offset;
-			retVec.push_back(nData);
-		}
-
-		return retVec;
-	}
-
-	std::optional<PositionData::Data> GetPositionData(const std::vector<PositionData::Data> a_posVec, std::uint32_t a_posIdx) {
-		for (PositionData::Data data : a_posVec) {
-			if (data.index == a_posIdx) {
-				return data;
-			}
-		}
-
-		return std::nullopt;
-	}
-
-	RE::NiPoint3 GetOffsetFromPositionData(const std::vector<PositionData::Data> a_posVec, std::uint32_t a_posIdx) {
-		auto data = GetPositionData(a_posVec, a_posIdx);
-		if (!data.has_value()) {
-			return RE::NiPoint3{};
-		}
-		return data->offset;
-	}
-
-	RE::NiPoint3 GetRotatedOffset(const RE::NiPoint3& a_offset, float a_rot) {
-		float rotatedOffsetX = a_offset.x * cos(a_rot) + a_offset.y * sin(a_rot);
-		float rotatedOffsetY = -a_offset.x * sin(a_rot) + a_offset.y * cos(a_rot);
-		float rotatedOffsetZ = a_offset.z;
-		return RE::NiPoint3(rotatedOffsetX, rotatedOffsetY, rotatedOffsetZ);
-	}
-
-	void ApplyOffset(ActorData* a_actorData) {
-		std::uint32_t positionerType = IsActorInPlayerScene(a_actorData) ? g_playerPositionerType : g_npcPositionerType;
-		if (positionerType == POSITIONER_TYPE::kRelative && IsActorScale1(a_actorData->Actor)) {
-			return;
-		}
-
-		RE::NiPoint3 rotatedOffset = GetRotatedOffset(a_actorData->Offset, a_actorData->Actor->data.angle.z);
-
-		if (a_actorData->ExtraRefrPath) {
-			if (positionerType == POSITIONER_TYPE::kRelative) {
-				float scale = Utils::GetActualScale(a_actorData->Actor);
-				float scaleDiff = 1.0f - scale;
-				a_actorData->ExtraRefrPath->goalPos.x = a_actorData->OriginalPosition.x + rotatedOffset.x * scaleDiff;
-				a_actorData->ExtraRefrPath->goalPos.y = a_actorData->OriginalPosition.y + rotatedOffset.y * scaleDiff;
-				a_actorData->ExtraRefrPath->goalPos.z = a_actorData->OriginalPosition.z + rotatedOffset.z * scaleDiff;
-			}
-			else if (positionerType == POSITIONER_TYPE::kAbsolute) {
-				a_actorData->ExtraRefrPath->goalPos.x = a_actorData->OriginalPosition.x + rotatedOffset.x;
-				a_actorData->ExtraRefrPath->goalPos.y = a_actorData->OriginalPosition.y + rotatedOffset.y;
-				a_actorData->ExtraRefrPath->goalPos.z = a_actorData->OriginalPosition.z + rotatedOffset.z;
-			}
-
-			Utils::ModPos(a_actorData->Actor, 'X', a_actorData->ExtraRefrPath->goalPos.x);
-			Utils::ModPos(a_actorData->Actor, 'Y', a_actorData->ExtraRefrPath->goalPos.y);
-			Utils::ModPos(a_actorData->Actor, 'Z', a_actorData->ExtraRefrPath->goalPos.z);
-		}
-	}
-
-	void SetOffset(const std::string& a_axis, float a_offset) {
-		ActorData* actorData = GetSelectedActorData();
-		if (!actorData) {
-			return;
-		}
-
-		ExtraRefrPath* extraRefPath = GetExtraRefrPath(actorData->Actor);
-		if (!extraRefPath) {
-			return;
-		}
-
-		if (actorData->ExtraRefrPath != extraRefPath) {
-			actorData->ExtraRefrPath = extraRefPath;
-			actorData->OriginalPosition = extraRefPath->goalPos;
-		}
-
-		if (a_axis == "X") {
-			actorData->Offset.x = a_offset;
-		}
-		else if (a_axis == "Y") {
-			actorData->Offset.y = a_offset;
-		}
-		else if (a_axis == "Z") {
-			actorData->Offset.z = a_offset;
-		}
-
-		ApplyOffset(actorData);
-		SavePosition(actorData);
-	}
-
-	void ClearOffset() {
-		ActorData* actorData = GetSelectedActorData();
-		if (!actorData) {
-			return;
-		}
-
-		ExtraRefrPath* extraRefPath = GetExtraRefrPath(actorData->Actor);
-		if (!extraRefPath) {
-			return;
-		}
-
-		if (actorData->ExtraRefrPath != extraRefPath) {
-			actorData->ExtraRefrPath = extraRefPath;
-			actorData->OriginalPosition = extraRefPath->goalPos;
-		}
-
-		actorData->Offset = RE::NiPoint3{};
-
-		ApplyOffset(actorData);
-		SavePosition(actorData);
-	}
-
-	void ResetPositioner() {
-		g_actorMap.clear();
-		g_sceneMap.clear();
-		g_sceneMapKey = 1;
-		ClearSelectedActorFormID();
-	}
-
-	void SceneInit(std::monostate, RE::BSTArray<RE::Actor*> a_actors, RE::Actor* a_doppelganger) {
-		SceneData newScene;
-
-		// 새 씬 초기화
-		newScene.SceneID = g_sceneMapKey++;
-
-		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
-
-		for (auto actor : a_actors) {
-			RE::Actor* actorPtr = actor;
-
-			bool isPlayerActor = false;
-
-			// 현재 액터가 플레이어인 경우 인자의 도플갱어를 사용
-			if (actorPtr == g_player) {
-				isPlayerActor = true;
-
-				actorPtr = a_doppelganger;
-				if (!actorPtr) {
-					continue;
-				}
-
-				if (g_unifyAAFDoppelgangerScale) {
-					Utils::SetRefScale(actorPtr, Utils::GetActualScale(g_player));
-				}
-			}
-
-			// 액터 정보 초기화
-			ActorData actorData;
-			actorData.FormID = isPlayerActor ? g_player->formID : actorPtr->formID;
-			actorData.Actor = actorPtr;
-			actorData.SceneID = newScene.SceneID;
-			actorData.ExtraRefrPath = nullptr;
-			actorData.Offset = RE::NiPoint3();
-			actorData.OriginalPosition = RE::NiPoint3();
-
-			// 초기화한 액터 정보를 씬의 액터 리스트에 삽입
-			newScene.ActorList.push_back(actorData.FormID);
-
-			// 씬의 액터 리스트에 삽입된 액터 정보의 포인터를 액터 맵에 추가함
-			g_actorMap.insert(std::make_pair(actorData.FormID, actorData));
-		}
-
-		// 씬을 씬 맵에 삽입
-		g_sceneMap.insert(std::make_pair(newScene.SceneID, newScene));
-	}
-
-	void AnimationChange(std::monostate, std::string a_position, RE::BSTArray<RE::Actor*> a_actors) {
-		std::uint64_t sceneID = GetSceneIDFromActorList(a_actors);
-		if (!sceneID) {
-			return;
-		}
-
-		// 씬 ID를 이용하여 씬 맵에서 씬을 찾는다
-		SceneData* sceneData = GetSceneDataByID(sceneID);
-		if (!sceneData) {
-			return;
-		}
-
-		std::vector<PositionData::Data> prevPosDataVec = GetPreviousPosition(sceneData);
-		sceneData->Position = a_position;
-
-		// 씬 정보를 이용하여 위치 정보를 읽어옴
-		std::vector<PositionData::Data> posDataVec = LoadPosition(sceneData);
-
-		for (std::uint32_t ii = 0; ii < a_actors.size(); ii++) {
-			RE::Actor* actorPtr = a_actors[ii];
-
-			ActorData* actorData = GetActorDataByFormID(actorPtr->formID);
-			if (!actorData) {
-				continue;
-			}
-
-			actorData->PositionIndex = ii;
-			if (!posDataVec.empty()) {
-				actorData->Offset = GetOffsetFromPositionData(posDataVec, ii);
-			}
-			else {
-				actorData->Offset = GetOffsetFromPositionData(prevPosDataVec, ii);
-			}
-
-			if (Scaleforms::IsMenuOpen() && actorData->FormID == GetSelectedActorFormID()) {
-				Scaleforms::UpdateMenu(actorData->Offset);
-			}
-
-			// 액터의 실제 위치를 저장하는 ExtraRefrPath를 불러옴
-			ExtraRefrPath* extraRefPath = GetExtraRefrPath(actorData->Actor);
-			if (!actorData->ExtraRefrPath && !extraRefPath) {
-				continue;
-			}
-
-			// ExtraRefPath는 변하지 않은 경우
-			if (actorData->ExtraRefrPath && actorData->ExtraRefrPath == extraRefPath) {
-				// 위치 조절 전 좌표로 원복
-				actorData->ExtraRefrPath->goalPos = actorData->OriginalPosition;
-			}
-			// ExtraRefPath가 변한 경우
-			else {
-				actorData->ExtraRefrPath = extraRefPath;
-				if (extraRefPath) {
-					actorData->OriginalPosition = extraRefPath->goalPos;
-				}
-			}
-
-			// 액터 오프셋 적용
-			ApplyOffset(actorData);
-		}
-	}
-
-	void SceneEnd(std::monostate, RE::BSTArray<RE::Actor*> a_actors) {
-		std::uint64_t sceneId = GetSceneIDFromActorList(a_actors);
-		if (!sceneId) {
-			return;
-		}
-
-		for (auto actor : a_actors) {
-			ActorData* actorData = GetActorDataByFormID(actor->formID);
-			if (!actorData) {
-				continue;
-			}
-
-			// 선택한 액터가 종료되는 씬에 포함되어있을 경우 선택한 액터를 초기화
-			if (actorData->FormID == GetSelectedActorFormID()) {
-				if (Scaleforms::IsMenuOpen()) {
-					Scaleforms::CloseMenu();
-				}
-
-				ClearHighlightSpellFromActor(actor);
-				ClearSelectedActorFormID();
-			}
-
-			g_actorMap.erase(actorData->FormID);
-		}
-
-		g_sceneMap.erase(sceneId);
-	}
-
-	std::uint32_t CanMovePosition(std::monostate) {
-		ActorData* selectedActorData = GetSelectedActorData();
-		if (!selectedActorData) {
-			return CAN_MOVE::kNo_Selection;
-		}
-
-		std::uint32_t positionerType = IsActorInPlayerScene(selectedActorData) ? g_playerPositionerType : g_npcPositionerType;
-
-		// 위치 조절 타입이 스케일이고 액터 스케일이 1이면 이동 불가
-		if (positionerType == POSITIONER_TYPE::kRelative && IsActorScale1(selectedActorData->Actor)) {
-			return CAN_MOVE::kNo_Scale;
-		}
-
-		return CAN_MOVE::kYes;
-	}
-
-	RE::Actor* ChangeSelectedActor() {
-		ActorData* actorData;
-		SceneData* sceneData;
-
-		// 현재 선택되어있는 액터를 가져옴
-		actorData = GetSelectedActorData();
-
-		// 현재 선택되어있는 액터가 없을 경우
-		if (!actorData) {
-			// 플레이어로 진행중인 씬이 있는지 확인
-			actorData = GetPlayerActorData();
-			if (actorData) {
-				// 플레이어로 진행중인 씬이 있을 때 씬 정보를 가져옴
-				SceneData* playerScene = GetSceneDataByID(actorData->SceneID);
-				if (!playerScene || playerScene->ActorList.empty()) {
-					return nullptr;
-				}
-
-				// 해당 씬의 가장 첫 액터를 선택하여 반환
-				actorData = GetActorDataByFormID(playerScene->ActorList.front());
-				if (!actorData) {
-					return nullptr;
-				}
-
-				SetSelectedActorFormID(actorData->FormID);
-				return actorData->Actor;
-			}
-
-			// 플레이어로 진행중인 씬이 없는 경우
-			// 첫 씬의 첫 액터를 선택하여 반환함
-			if (g_sceneMap.empty()) {
-				return nullptr;
-			}
-
-			sceneData = &g_sceneMap.begin()->second;
-			if (sceneData->ActorList.empty()) {
-				return nullptr;
-			}
-
-			actorData = GetActorDataByFormID(sceneData->ActorList.front());
-			if (!actorData) {
-				return nullptr;
-			}
-
-			SetSelectedActorFormID(actorData->FormID);
-			return actorData->Actor;
-		}
-
-		// 현재 선택되어있는 액터가 있을 경우 현재 액터가 포함된 씬을 가져옴
-		auto scene_iter = g_sceneMap.find(actorData->SceneID);
-		if (scene_iter == g_sceneMap.end()) {
-			return nullptr;
-		}
-
-		sceneData = &scene_iter->second;
-
-		// 현재 선택된 액터를 찾고 그 액터의 다음 액터를 찾아서 반환
-		auto actor_iter = std::find(sceneData->ActorList.begin(), sceneData->ActorList.end(), actorData->FormID);
-		if (actor_iter == sceneData->ActorList.end()) {
-			return nullptr;
-		}
-
-		actor_iter = std::next(actor_iter);
-		if (actor_iter != sceneData->ActorList.end()) {
-			actorData = GetActorDataByFormID(*actor_iter);
-			if (!actorData) {
-				return nullptr;
-			}
-
-			SetSelectedActorFormID(actorData->FormID);
-			return actorData->Actor;
-		}
-
-		// 선택된 액터가 해당 씬의 마지막 액터였을 경우
-		// 해당 씬의 다음 씬의 첫 액터를 찾아서 반환
-		scene_iter = std::next(scene_iter);
-		if (scene_iter != g_sceneMap.end()) {
-			sceneData = &scene_iter->second;
-			if (sceneData->ActorList.empty()) {
-				return nullptr;
-			}
-
-			actorData = GetActorDataByFormID(sceneData->ActorList.front());
-			if (!actorData) {
-				return nullptr;
-			}
-
-			SetSelectedActorFormID(actorData->FormID);
-			return actorData->Actor;
-		}
-
-		// 선택된 액터가 마지막 씬의 마지막 액터였을 경우
-		// 가장 첫 씬의 첫 액터를 찾아서 반환
-		sceneData = &g_sceneMap.begin()->second;
-		if (sceneData->ActorList.empty()) {
-			return nullptr;
-		}
-
-		actorData = GetActorDataByFormID(sceneData->ActorList.front());
-		if (!actorData) {
-			return nullptr;
-		}
-
-		SetSelectedActorFormID(actorData->FormID);
-		return actorData->Actor;
-	}
-
-	bool ChangeActor_Native(std::monostate) {
-		ActorData* selectedActorData = GetSelectedActorData();
-		if (selectedActorData) {
-			ClearHighlightSpellFromActor(selectedActorData->Actor);
-		}
-
-		RE::Actor* selectedActor = ChangeSelectedActor();
-		if (!selectedActor) {
-			return false;
-		}
-
-		if (CanMovePosition({}) == CAN_MOVE::kYes) {
-			Utils::AddSpell(selectedActor, GetHighlightSpell(true));
-		}
-		else {
-			Utils::AddSpell(selectedActor, GetHighlightSpell(false));
-		}
-
-		return true;
-	}
-
-	void ClearActorSelection(std::monostate) {
-		ActorData* selectedActorData = GetSelectedActorData();
-		if (selectedActorData) {
-			ClearHighlightSpellFromActor(selectedActorData->Actor);
-		}
-		ClearSelectedActorFormID();
-	}
-
-	void ShowPositionerMenu_Native(std::monostate) {
-		ActorData* actorData = GetSelectedActorData();
-		if (!actorData) {
-			return;
-		}
-
-		ExtraRefrPath* extraRefPath = GetExtraRefrPath(actorData->Actor);
-		if (!extraRefPath) {
-			return;
-		}
-
-		if (actorData->ExtraRefrPath != extraRefPath) {
-			actorData->ExtraRefrPath = extraRefPath;
-			actorData->OriginalPosition = extraRefPath->goalPos;
-		}
-
-		if (Scaleforms::IsMenuOpen()) {
-			return;
-		}
-
-		Scaleforms::OpenMenu(actorData->Offset);
-	}
-
-	void Install(RE::BSScript::IVirtualMachine* a_vm) {
-		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SceneInit"sv, SceneInit);
-		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "AnimationChange"sv, AnimationChange);
-		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SceneEnd"sv, SceneEnd);
-
-		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "CanMovePosition"sv, CanMovePosition);
-		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "ChangeActor_Native"sv, ChangeActor_Native);
-		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "ClearActorSelection"sv, ClearActorSelection);
-
-		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "ShowPositionerMenu_Native"sv, ShowPositionerMenu_Native);
-	}
-}
+#include "Positioners.h"
+
+#include "Core/FrameScheduler.h"
+#include "Core/MemoryTracker.h"
+#include "Core/OffsetBlend.h"
+#include "Core/OffsetMath.h"
+#include "Core/OffsetProfiles.h"
+#include "Core/PathCache.h"
+#include "Core/SpatialGrid.h"
+#include "Core/Telemetry.h"
+#include "Executors.h"
+#include "Forms.h"
+#include "Mutators.h"
+#include "Prefetchers.h"
+#include "Scaleforms.h"
+#include "PositionData.h"
+#include "Settings.h"
+#include "Utils.h"
+
+namespace Positioners {
+	// 위치 이름과 액터 리스트도 씬 맵 노드와 같은 리소스에서 할당되도록 할당자를 받는 생성자를 둠
+	struct SceneData {
+		using allocator_type = std::pmr::polymorphic_allocator<>;
+
+		explicit SceneData(const allocator_type& a_allocator) : Position(a_allocator), ActorList(a_allocator) {}
+		SceneData(const SceneData& a_other, const allocator_type& a_allocator) :
+			SceneID(a_other.SceneID), Position(a_other.Position, a_allocator), ActorList(a_other.ActorList, a_allocator), Generation(a_other.Generation) {}
+		SceneData(SceneData&& a_other, const allocator_type& a_allocator) :
+			SceneID(a_other.SceneID), Position(std::move(a_other.Position), a_allocator), ActorList(std::move(a_other.ActorList), a_allocator), Generation(a_other.Generation) {}
+
+		std::uint64_t                   SceneID = 0;
+		std::pmr::string                Position;
+		std::pmr::vector<std::uint32_t> ActorList;
+		PathCache::Generation           Generation;
+	};
+
+	enum POSITIONER_TYPE : std::uint32_t {
+		kRelative = 0,
+		kAbsolute
+	};
+
+	enum CAN_MOVE : std::uint32_t {
+		kYes = 0,
+		kNo_Selection,
+		kNo_Scale,
+	};
+
+	// 긴 세션 동안의 메모리 사용량을 볼 수 있도록 액터 맵과 씬 맵은 분류별 리소스에서 할당
+	std::pmr::unordered_map<std::uint32_t, ActorData> g_actorMap{ MemoryTracker::GetResource(MemoryTracker::CATEGORY::kActors) };
+	std::pmr::unordered_map<std::uint64_t, SceneData> g_sceneMap{ MemoryTracker::GetResource(MemoryTracker::CATEGORY::kScenes) };
+	std::uint64_t g_lastMemoryLog = 0;
+
+	std::uint64_t g_sceneMapKey = 1;
+	std::uint32_t g_selectedActorFormID = 0;
+
+	// 씬 맵은 스크립트와 메인 스레드에서 접근하므로 하나의 락으로 보호, 읽기만 하는 네이티브는 공유 락을 사용
+	// 내부 함수는 락을 잡지 않고 호출하는 쪽이 이미 잡고 있다고 가정하므로 재귀 락이 필요 없음
+	std::shared_mutex g_lock;
+
+	// 게임을 불러오면 증가시켜 그 전에 큐에 들어간 씬 이벤트를 버림
+	std::atomic<std::uint32_t> g_epoch = 0;
+
+	// 위치가 바뀔 때 이전 오프셋에서 새 오프셋으로 매 프레임 보간
+	OffsetBlend::Blender g_blender;
+	bool g_blendScheduled = false;
+	std::uint64_t g_lastBlendTime = 0;
+
+	// 위치 변경은 씬마다 마지막 것만 남겨 플레이어 씬, 가까운 씬 순서로 프레임 예산 안에서 적용
+	FrameScheduler::Scheduler g_scheduler;
+	bool g_frameScheduled = false;
+
+	// 가장 가까운 액터를 고를 수 있도록 씬 액터의 위치를 격자에 유지
+	constexpr float kActorGridCellSize = 512.0f;
+	SpatialGrid::Grid g_actorGrid(kActorGridCellSize);
+
+	std::uint64_t g_extraRefrPathWalks = 0;
+	std::uint64_t g_extraRefrPathHits = 0;
+
+	std::uint32_t GetSelectedActorFormID() {
+		return g_selectedActorFormID;
+	}
+
+	void SetSelectedActorFormID(std::uint32_t a_formID) {
+		g_selectedActorFormID = a_formID;
+	}
+
+	void ClearSelectedActorFormID() {
+		SetSelectedActorFormID(0);
+	}
+
+	ActorData* GetActorDataByFormID(std::uint32_t a_formID) {
+		auto it = g_actorMap.find(a_formID);
+		if (it == g_actorMap.end()) {
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+
+	ActorData* GetPlayerActorData() {
+		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
+		if (!g_player) {
+			return nullptr;
+		}
+
+		return GetActorDataByFormID(g_player->formID);
+	}
+
+	ActorData* GetSelectedActorData() {
+		if (!GetSelectedActorFormID()) {
+			return nullptr;
+		}
+
+		return GetActorDataByFormID(GetSelectedActorFormID());
+	}
+
+	SceneData* GetSceneDataByID(std::uint64_t a_sceneID) {
+		auto it = g_sceneMap.find(a_sceneID);
+		if (it == g_sceneMap.end()) {
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+
+	ExtraRefrPath* GetExtraRefrPath(RE::Actor* a_actor) {
+		if (!a_actor) {
+			return nullptr;
+		}
+
+		g_extraRefrPathWalks++;
+
+		RE::BSExtraData* refrPath = a_actor->extraList->extraData.GetByType(RE::EXTRA_DATA_TYPE::kRefrPath);
+		if (!refrPath) {
+			return nullptr;
+		}
+
+		return (ExtraRefrPath*)refrPath;
+	}
+
+	// 액터가 속한 씬의 세대에 캐시된 ExtraRefrPath를 extraList가 아직 그대로 가지고 있으면 사용하고, 아니면 다시 찾아서 원래 좌표를 갱신
+	// 엔진이 경로를 새로 만들면 kRefrPath는 그대로 있으므로 HasType이 아니라 목록이 가진 포인터와 비교함
+	// 다른 씬의 애니메이션이 바뀌어도 이 씬의 캐시는 그대로 유지됨
+	ExtraRefrPath* GetCachedExtraRefrPath(ActorData* a_actorData) {
+		SceneData* sceneData = GetSceneDataByID(a_actorData->SceneID);
+		std::uint32_t generation = sceneData ? sceneData->Generation.Get() : 0;
+
+		return PathCache::Lookup(a_actorData->ExtraRefrPath, a_actorData->ExtraRefrPathGeneration, generation, g_extraRefrPathHits,
+			[&](ExtraRefrPath* a_cached) { return a_actorData->Actor->extraList && a_actorData->Actor->extraList->extraData.GetByType(RE::EXTRA_DATA_TYPE::kRefrPath) == a_cached; },
+			[&]() { return GetExtraRefrPath(a_actorData->Actor); },
+			[&](ExtraRefrPath* a_path) { a_actorData->OriginalPosition = a_path->goalPos; });
+	}
+
+	RE::SpellItem* GetHighlightSpell(bool a_isMovable) {
+		return Forms::Get<RE::SpellItem>(a_isMovable ? Forms::FORM::kMovableHighlightSpell : Forms::FORM::kImmovableHighlightSpell);
+	}
+
+	void ClearHighlightSpellFromActor(RE::Actor* a_actor) {
+		Mutators::RemoveSpell(a_actor, GetHighlightSpell(true));
+		Mutators::RemoveSpell(a_actor, GetHighlightSpell(false));
+	}
+
+	bool IsPlayerInScene(SceneData* a_sceneData) {
+		if (!a_sceneData) {
+			return false;
+		}
+
+		ActorData* playerActorData = GetPlayerActorData();
+		if (!playerActorData) {
+			return false;
+		}
+
+		for (auto formId : a_sceneData->ActorList) {
+			if (formId == playerActorData->FormID) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool IsActorInPlayerScene(ActorData* a_actorData) {
+		if (!a_actorData) {
+			return false;
+		}
+
+		ActorData* playerActorData = GetPlayerActorData();
+		if (!playerActorData) {
+			return false;
+		}
+
+		if (a_actorData->SceneID == playerActorData->SceneID) {
+			return true;
+		}
+
+		return false;
+	}
+
+	std::uint32_t GetPositionerType(ActorData* a_actorData) {
+		return Settings::GetUInt(IsActorInPlayerScene(a_actorData) ? Settings::ID::kPlayerPositionerType : Settings::ID::kNPCPositionerType);
+	}
+
+	bool IsActorScale1(RE::Actor* a_actor) {
+		if (!a_actor) {
+			return false;
+		}
+
+		float actorScale = Utils::GetActualScale(a_actor);
+		std::uint32_t intScale = static_cast<std::uint32_t>(std::round(actorScale * 100));
+		if (intScale == 100) {
+			return true;
+		}
+		return false;
+	}
+
+	// 입출력 스레드에서는 씬 맵을 볼 수 없으므로 스크립트 스레드에서 액터 배열로 플레이어 씬인지 미리 판단
+	bool IsPlayerInActors(const RE::BSTArray<RE::Actor*>& a_actors) {
+		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
+		return std::find(a_actors.begin(), a_actors.end(), g_player) != a_actors.end();
+	}
+
+	std::vector<PositionData::Data> LoadPosition(const std::string& a_position, bool a_hasPlayer, bool& a_fromCache) {
+		bool isPlayerScene = Settings::GetBool(Settings::ID::kSeparatePlayerOffset) && a_hasPlayer;
+		return PositionData::LoadPositionData(a_position, isPlayerScene, &a_fromCache);
+	}
+
+	// 구운 오프셋은 절대 모드에서 더한 값과 같으므로 씬 종류의 위치 조절 방식이 절대 모드일 때만 구운 위치로 취급
+	bool IsBakedPosition(const std::string& a_position, bool a_hasPlayer) {
+		bool isPlayerScene = a_hasPlayer && Settings::GetBool(Settings::ID::kSeparatePlayerOffset);
+		if (!PositionData::IsBaked(a_position, isPlayerScene)) {
+			return false;
+		}
+
+		if (Settings::GetUInt(a_hasPlayer ? Settings::ID::kPlayerPositionerType : Settings::ID::kNPCPositionerType) == POSITIONER_TYPE::kAbsolute) {
+			return true;
+		}
+
+		static std::atomic<bool> warned = false;
+		if (!warned.exchange(true)) {
+			logger::warn("{} is baked for the absolute positioner, in relative mode its offsets are applied on top of the baked XML", a_position);
+		}
+		return false;
+	}
+
+	void SavePosition(SceneData* a_sceneData) {
+		if (!a_sceneData) {
+			return;
+		}
+
+		PositionData::SavePositionData(std::string(a_sceneData->Position), a_sceneData->ActorList, Settings::GetBool(Settings::ID::kSeparatePlayerOffset) ? IsPlayerInScene(a_sceneData) : false);
+	}
+
+	void SavePosition(ActorData* a_actorData) {
+		if (!a_actorData) {
+			return;
+		}
+
+		SavePosition(GetSceneDataByID(a_actorData->SceneID));
+	}
+
+	std::vector<PositionData::Data> GetPreviousPosition(SceneData* a_sceneData) {
+		std::vector<PositionData::Data> retVec;
+
+		if (!a_sceneData) {
+			return retVec;
+		}
+
+		for (auto actorFormID : a_sceneData->ActorList) {
+			auto actorData = GetActorDataByFormID(actorFormID);
+			if (!actorData) {
+				continue;
+			}
+
+			PositionData::Data nData;
+			nData.index = actorData->PositionIndex;
+			nData.offset = Utils::ToVector3(actorData->Offset);
+			retVec.push_back(nData);
+		}
+
+		return retVec;
+	}
+
+	RE::NiPoint3 GetOffsetFromPositionData(const std::vector<PositionData::Data>& a_posVec, std::uint32_t a_posIdx, RE::Actor* a_actor) {
+		auto offset = OffsetProfiles::Resolve(a_posVec, a_posIdx, PositionData::GetProfileScale(a_actor), Settings::GetFloat(Settings::ID::kScaleBucketSize));
+		if (!offset.has_value()) {
+			return RE::NiPoint3{};
+		}
+		return Utils::ToNiPoint3(*offset);
+	}
+
+	void ApplyOffset(ActorData* a_actorData, const RE::NiPoint3& a_offset) {
+		std::uint32_t positionerType = GetPositionerType(a_actorData);
+		if (positionerType == POSITIONER_TYPE::kRelative && IsActorScale1(a_actorData->Actor)) {
+			return;
+		}
+
+		if (a_actorData->ExtraRefrPath) {
+			std::uint64_t startTime = Telemetry::GetTimestamp();
+
+			float scale = positionerType == POSITIONER_TYPE::kRelative ? Utils::GetActualScale(a_actorData->Actor) : 1.0f;
+			Vector3 goalPos = OffsetMath::GetGoalPosition(Utils::ToVector3(a_actorData->OriginalPosition), Utils::ToVector3(a_offset),
+				a_actorData->Actor->data.angle.z, scale, positionerType == POSITIONER_TYPE::kRelative);
+			a_actorData->ExtraRefrPath->goalPos = Utils::ToNiPoint3(goalPos);
+
+			Mutators::ModPos(a_actorData->Actor, 'X', a_actorData->ExtraRefrPath->goalPos.x);
+			Mutators::ModPos(a_actorData->Actor, 'Y', a_actorData->ExtraRefrPath->goalPos.y);
+			Mutators::ModPos(a_actorData->Actor, 'Z', a_actorData->ExtraRefrPath->goalPos.z);
+			a_actorData->AppliedOffset = a_offset;
+
+			g_actorGrid.Update(a_actorData->FormID, goalPos);
+
+			if (Telemetry::IsEnabled()) {
+				SceneData* sceneData = GetSceneDataByID(a_actorData->SceneID);
+				Telemetry::Push(Telemetry::EVENT::kApplyOffset, a_actorData->SceneID, a_actorData->FormID, Utils::ToVector3(a_offset),
+					Telemetry::GetElapsed(startTime), sceneData ? std::string_view(sceneData->Position) : std::string_view());
+			}
+		}
+	}
+
+	// 직접 적용하면 진행 중인 보간은 취소
+	void ApplyOffset(ActorData* a_actorData) {
+		g_blender.Cancel(a_actorData->FormID);
+		ApplyOffset(a_actorData, a_actorData->Offset);
+	}
+
+	void ScheduleBlend();
+
+	// 모든 보간을 한 번에 진행하고, 남은 보간이 있으면 다음 프레임에 다시 실행
+	void TickBlend() {
+		std::lock_guard lock(g_lock);
+
+		g_blendScheduled = false;
+
+		std::uint64_t now = Telemetry::GetTimestamp();
+		float interval = static_cast<float>(now - g_lastBlendTime) / 1000000.0f;
+		g_lastBlendTime = now;
+
+		g_blender.Advance(interval, [](std::uint32_t a_formID, const Vector3& a_offset, bool) {
+			ActorData* actorData = GetActorDataByFormID(a_formID);
+			if (actorData && actorData->ExtraRefrPath) {
+				ApplyOffset(actorData, Utils::ToNiPoint3(a_offset));
+			}
+		});
+
+		if (!g_blender.IsEmpty()) {
+			ScheduleBlend();
+		}
+	}
+
+	void ScheduleBlend() {
+		if (g_blendScheduled) {
+			return;
+		}
+
+		g_blendScheduled = true;
+		Executors::GetMainExecutor().Post(TickBlend);
+	}
+
+	// 이전에 적용된 오프셋에서 보간을 시작하고, 보간하지 않는 경우 바로 적용
+	void BlendOffset(ActorData* a_actorData) {
+		float duration = Settings::GetFloat(Settings::ID::kBlendDuration);
+		if (duration <= 0.0f || !F4SE::GetTaskInterface() || Utils::ToVector3(a_actorData->AppliedOffset) == Utils::ToVector3(a_actorData->Offset)) {
+			ApplyOffset(a_actorData);
+			return;
+		}
+
+		if (g_blender.IsEmpty()) {
+			g_lastBlendTime = Telemetry::GetTimestamp();
+		}
+
+		if (!g_blender.Start(a_actorData->FormID, Utils::ToVector3(a_actorData->AppliedOffset), Utils::ToVector3(a_actorData->Offset), duration)) {
+			ApplyOffset(a_actorData);
+			return;
+		}
+
+		ApplyOffset(a_actorData, a_actorData->AppliedOffset);
+		ScheduleBlend();
+	}
+
+	void SetOffset(std::uint32_t a_axis, float a_offset) {
+		std::lock_guard lock(g_lock);
+
+		ActorData* actorData = GetSelectedActorData();
+		if (!actorData) {
+			return;
+		}
+
+		if (!GetCachedExtraRefrPath(actorData)) {
+			return;
+		}
+
+		actorData->Offset = Utils::ToNiPoint3(OffsetMath::SetAxis(Utils::ToVector3(actorData->Offset), a_axis, a_offset, Settings::GetFloat(Settings::ID::kOffsetLimit)));
+
+		ApplyOffset(actorData);
+		SavePosition(actorData);
+	}
+
+	// 세 축을 한 번에 바꾸고 적용과 저장도 한 번만 수행
+	bool SetOffsets(const RE::NiPoint3& a_offset, RE::NiPoint3& a_applied) {
+		std::lock_guard lock(g_lock);
+
+		ActorData* actorData = GetSelectedActorData();
+		if (!actorData) {
+			return false;
+		}
+
+		if (!GetCachedExtraRefrPath(actorData)) {
+			return false;
+		}
+
+		actorData->Offset = Utils::ToNiPoint3(OffsetMath::Clamp(Utils::ToVector3(a_offset), Settings::GetFloat(Settings::ID::kOffsetLimit)));
+
+		ApplyOffset(actorData);
+		SavePosition(actorData);
+
+		a_applied = actorData->Offset;
+		return true;
+	}
+
+	bool NudgeOffset(std::uint32_t a_axis, float a_steps, RE::NiPoint3& a_applied) {
+		std::lock_guard lock(g_lock);
+
+		ActorData* actorData = GetSelectedActorData();
+		if (!actorData) {
+			return false;
+		}
+
+		if (!GetCachedExtraRefrPath(actorData)) {
+			return false;
+		}
+
+		actorData->Offset = Utils::ToNiPoint3(OffsetMath::Nudge(Utils::ToVector3(actorData->Offset), a_axis, a_steps,
+			Settings::GetFloat(Settings::ID::kNudgeStep), Settings::GetFloat(Settings::ID::kOffsetLimit)));
+
+		ApplyOffset(actorData);
+		SavePosition(actorData);
+
+		a_applied = actorData->Offset;
+		return true;
+	}
+
+	bool MoveOffset(const RE::NiPoint3& a_delta, RE::NiPoint3& a_offset) {
+		std::lock_guard lock(g_lock);
+
+		ActorData* actorData = GetSelectedActorData();
+		if (!actorData) {
+			return false;
+		}
+
+		if (!GetCachedExtraRefrPath(actorData)) {
+			return false;
+		}
+
+		actorData->Offset.x += a_delta.x;
+		actorData->Offset.y += a_delta.y;
+		actorData->Offset.z += a_delta.z;
+		actorData->Offset = Utils::ToNiPoint3(OffsetMath::Clamp(Utils::ToVector3(actorData->Offset), Settings::GetFloat(Settings::ID::kOffsetLimit)));
+
+		// 프레임마다 위치만 적용하고 저장은 이동이 끝난 후 SaveOffset에서 한 번만 수행
+		ApplyOffset(actorData);
+
+		a_offset = actorData->Offset;
+		return true;
+	}
+
+	void SaveOffset() {
+		std::lock_guard lock(g_lock);
+
+		SavePosition(GetSelectedActorData());
+	}
+
+	void ClearOffset() {
+		std::lock_guard lock(g_lock);
+
+		ActorData* actorData = GetSelectedActorData();
+		if (!actorData) {
+			return;
+		}
+
+		if (!GetCachedExtraRefrPath(actorData)) {
+			return;
+		}
+
+		actorData->Offset = RE::NiPoint3{};
+
+		ApplyOffset(actorData);
+		SavePosition(actorData);
+	}
+
+	void ResetPositioner() {
+		std::lock_guard lock(g_lock);
+
+		g_epoch++;
+		g_actorMap.clear();
+		g_sceneMap.clear();
+		g_sceneMapKey = 1;
+		ClearSelectedActorFormID();
+		Mutators::Reset();
+		g_blender.Clear();
+		g_scheduler.Clear();
+		g_actorGrid.Clear();
+
+		Telemetry::UpdateCounts(0, 0);
+	}
+
+	void InitScene(const RE::BSTArray<RE::Actor*>& a_actors, RE::Actor* a_doppelganger) {
+		SceneData newScene(g_sceneMap.get_allocator());
+
+		// 새 씬 초기화
+		newScene.SceneID = g_sceneMapKey++;
+
+		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
+
+		for (auto actor : a_actors) {
+			RE::Actor* actorPtr = actor;
+			if (!actorPtr) {
+				continue;
+			}
+
+			bool isPlayerActor = false;
+
+			// 현재 액터가 플레이어인 경우 인자의 도플갱어를 사용
+			if (actorPtr == g_player) {
+				isPlayerActor = true;
+
+				actorPtr = a_doppelganger;
+				if (!actorPtr) {
+					continue;
+				}
+
+				if (Settings::GetBool(Settings::ID::kUnifyAAFDoppelgangerScale)) {
+					Mutators::SetRefScale(actorPtr, Utils::GetActualScale(g_player));
+				}
+			}
+
+			// 액터 정보 초기화
+			ActorData actorData;
+			actorData.FormID = isPlayerActor ? g_player->formID : actorPtr->formID;
+			actorData.Actor = actorPtr;
+			actorData.SceneID = newScene.SceneID;
+			actorData.ExtraRefrPath = nullptr;
+			actorData.ExtraRefrPathGeneration = 0;
+			actorData.Offset = RE::NiPoint3();
+			actorData.OriginalPosition = RE::NiPoint3();
+			actorData.AppliedOffset = RE::NiPoint3();
+
+			// 초기화한 액터 정보를 씬의 액터 리스트에 삽입
+			newScene.ActorList.push_back(actorData.FormID);
+
+			// 씬의 액터 리스트에 삽입된 액터 정보의 포인터를 액터 맵에 추가함
+			g_actorMap.insert(std::make_pair(actorData.FormID, actorData));
+			g_actorGrid.Update(actorData.FormID, Utils::ToVector3(actorPtr->data.location));
+		}
+
+		// 씬을 씬 맵에 삽입
+		std::uint64_t sceneID = newScene.SceneID;
+		g_sceneMap.emplace(sceneID, std::move(newScene));
+
+		Telemetry::Push(Telemetry::EVENT::kSceneInit, sceneID, 0, Vector3{}, 0, {});
+		Telemetry::UpdateCounts(static_cast<std::uint32_t>(g_sceneMap.size()), static_cast<std::uint32_t>(g_actorMap.size()));
+	}
+
+	// 액터 포인터는 프레임을 넘어 들고 있지 않고 폼 ID로 받아 메인 스레드에서 다시 찾음
+	void ChangeAnimation(const std::string& a_position, std::uint64_t a_sceneID, const std::vector<std::uint32_t>& a_formIDs, const std::vector<PositionData::Data>& a_posDataVec, bool a_fromCache, std::uint64_t a_queuedTime) {
+		// 대기하는 동안 씬이 끝났으면 적용하지 않음
+		SceneData* sceneData = GetSceneDataByID(a_sceneID);
+		if (!sceneData) {
+			return;
+		}
+
+		// 구운 위치는 AAF 데이터에 오프셋이 이미 들어 있으므로 이전 오프셋을 이어받지 않음
+		bool isBaked = IsBakedPosition(a_position, IsPlayerInScene(sceneData));
+		std::vector<PositionData::Data> prevPosDataVec = GetPreviousPosition(sceneData);
+		std::string prevPosition(sceneData->Position);
+		sceneData->Position = a_position;
+		// 이 씬의 세대만 올려 다른 씬 액터의 캐시된 ExtraRefrPath는 유지
+		sceneData->Generation.Bump();
+
+		Prefetchers::OnAnimationChange(prevPosition, a_position, Settings::GetBool(Settings::ID::kSeparatePlayerOffset) ? IsPlayerInScene(sceneData) : false, a_fromCache);
+
+		// 스크립트에서 호출된 후 적용되기까지의 지연 시간을 기록
+		Telemetry::Push(Telemetry::EVENT::kAnimationChange, a_sceneID, 0, Vector3{}, Telemetry::GetElapsed(a_queuedTime), a_position);
+
+		for (std::uint32_t ii = 0; ii < a_formIDs.size(); ii++) {
+			ActorData* actorData = GetActorDataByFormID(a_formIDs[ii]);
+			if (!actorData || actorData->SceneID != a_sceneID) {
+				continue;
+			}
+
+			// 스케일은 AAF 배열의 액터 기준이므로 플레이어는 도플갱어가 아닌 플레이어로 찾음
+			RE::Actor* actorPtr = RE::TESForm::GetFormByID<RE::Actor>(a_formIDs[ii]);
+			if (!actorPtr) {
+				actorPtr = actorData->Actor;
+			}
+
+			actorData->PositionIndex = ii;
+			if (isBaked) {
+				actorData->Offset = RE::NiPoint3{};
+			}
+			else if (!a_posDataVec.empty()) {
+				actorData->Offset = GetOffsetFromPositionData(a_posDataVec, ii, actorPtr);
+			}
+			else {
+				actorData->Offset = GetOffsetFromPositionData(prevPosDataVec, ii, actorPtr);
+			}
+
+			if (Scaleforms::IsMenuOpen() && actorData->FormID == GetSelectedActorFormID()) {
+				Scaleforms::UpdateMenu(actorData->Offset);
+			}
+
+			// 액터의 실제 위치를 저장하는 ExtraRefrPath를 불러옴
+			ExtraRefrPath* extraRefPath = GetExtraRefrPath(actorData->Actor);
+			if (!actorData->ExtraRefrPath && !extraRefPath) {
+				continue;
+			}
+
+			// ExtraRefPath는 변하지 않은 경우
+			if (actorData->ExtraRefrPath && actorData->ExtraRefrPath == extraRefPath) {
+				// 위치 조절 전 좌표로 원복
+				actorData->ExtraRefrPath->goalPos = actorData->OriginalPosition;
+			}
+			// ExtraRefPath가 변한 경우
+			else {
+				actorData->ExtraRefrPath = extraRefPath;
+				if (extraRefPath) {
+					actorData->OriginalPosition = extraRefPath->goalPos;
+				}
+			}
+			actorData->ExtraRefrPathGeneration = sceneData->Generation.Get();
+
+			// 상대 모드의 1배율 액터처럼 ApplyOffset이 일찍 끝나도 격자는 새 위치의 목표 좌표를 따라가도록 여기서 갱신
+			if (actorData->ExtraRefrPath) {
+				g_actorGrid.Update(actorData->FormID, Utils::ToVector3(actorData->ExtraRefrPath->goalPos));
+			}
+
+			// 구운 위치에서 적용된 오프셋이 없으면 위치를 건드리지 않음
+			if (isBaked && Utils::ToVector3(actorData->AppliedOffset) == Vector3{}) {
+				continue;
+			}
+
+			// 액터 오프셋 적용
+			BlendOffset(actorData);
+		}
+	}
+
+	void LogMemoryStats() {
+		for (std::uint32_t ii = 0; ii < static_cast<std::uint32_t>(MemoryTracker::CATEGORY::kTotal); ii++) {
+			auto category = static_cast<MemoryTracker::CATEGORY>(ii);
+			MemoryTracker::Usage usage = MemoryTracker::GetUsage(category);
+			logger::info("Memory {}: {} KB, peak {} KB, budget {} KB, {} allocations", MemoryTracker::GetName(category), usage.current / 1024, usage.peak / 1024,
+				MemoryTracker::GetBudget(category) / 1024, usage.allocations);
+		}
+	}
+
+	// 씬 단위 함수는 액터 배열 순서대로 값을 주고받으며, 한 씬의 액터만 다루고 저장은 한 번만 수행
+	ActorData* GetSceneActorData(RE::Actor* a_actor, std::uint64_t a_sceneID) {
+		if (!a_actor) {
+			return nullptr;
+		}
+
+		ActorData* actorData = GetActorDataByFormID(a_actor->formID);
+		if (!actorData || actorData->SceneID != a_sceneID) {
+			return nullptr;
+		}
+
+		return actorData;
+	}
+
+	std::uint64_t GetSceneIDFromActorArray(const RE::BSTArray<RE::Actor*>& a_actors) {
+		for (auto actor : a_actors) {
+			if (!actor) {
+				continue;
+			}
+
+			ActorData* actorData = GetActorDataByFormID(actor->formID);
+			if (actorData) {
+				return actorData->SceneID;
+			}
+		}
+
+		return 0;
+	}
+
+	// 메뉴는 호출하는 쪽에서 락 밖에서 먼저 닫아야 함, 닫을 때 저장하면서 다시 락을 잡기 때문
+	std::uint64_t EndScene(const RE::BSTArray<RE::Actor*>& a_actors) {
+		std::uint64_t sceneId = GetSceneIDFromActorArray(a_actors);
+		if (!sceneId) {
+			return 0;
+		}
+
+		for (auto actor : a_actors) {
+			ActorData* actorData = GetSceneActorData(actor, sceneId);
+			if (!actorData) {
+				continue;
+			}
+
+			// 선택한 액터가 종료되는 씬에 포함되어있을 경우 선택한 액터를 초기화
+			if (actorData->FormID == GetSelectedActorFormID()) {
+				ClearHighlightSpellFromActor(actor);
+				ClearSelectedActorFormID();
+			}
+
+			g_blender.Cancel(actorData->FormID);
+			Mutators::Forget(actorData->Actor);
+			g_actorGrid.Remove(actorData->FormID);
+			g_actorMap.erase(actorData->FormID);
+		}
+
+		g_scheduler.Cancel(sceneId);
+		g_sceneMap.erase(sceneId);
+
+		Telemetry::UpdateCounts(static_cast<std::uint32_t>(g_sceneMap.size()), static_cast<std::uint32_t>(g_actorMap.size()));
+		return sceneId;
+	}
+
+	// 씬 맵을 건드리지 않는 통계와 저장은 락을 놓은 뒤 수행
+	void LogSceneEnd(std::uint64_t a_sceneId) {
+		logger::debug("ExtraRefrPath lookups: {} walks, {} cached", g_extraRefrPathWalks, g_extraRefrPathHits);
+		Mutators::LogStats();
+		Prefetchers::LogStats();
+		Prefetchers::Save();
+
+		std::uint64_t logInterval = static_cast<std::uint64_t>(Settings::GetUInt(Settings::ID::kMemoryLogInterval)) * 1000000;
+		if (logInterval > 0 && Telemetry::GetTimestamp() - g_lastMemoryLog >= logInterval) {
+			g_lastMemoryLog = Telemetry::GetTimestamp();
+			LogMemoryStats();
+		}
+
+		Telemetry::Push(Telemetry::EVENT::kSceneEnd, a_sceneId, 0, Vector3{}, 0, {});
+	}
+
+	// 플레이어 씬은 항상 먼저, 다른 씬은 플레이어와 가장 가까운 액터의 거리 순서이며 LOD 거리 밖이면 다음 프레임으로 미룸
+	std::optional<float> GetScenePriority(std::uint64_t a_sceneID) {
+		SceneData* sceneData = GetSceneDataByID(a_sceneID);
+		if (!sceneData || IsPlayerInScene(sceneData)) {
+			return -1.0f;
+		}
+
+		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
+		if (!g_player) {
+			return 0.0f;
+		}
+
+		float minDistanceSq = std::numeric_limits<float>::max();
+		for (auto formId : sceneData->ActorList) {
+			ActorData* actorData = GetActorDataByFormID(formId);
+			if (!actorData || !actorData->Actor) {
+				continue;
+			}
+
+			const RE::NiPoint3& location = actorData->Actor->data.location;
+			float dx = location.x - g_player->data.location.x;
+			float dy = location.y - g_player->data.location.y;
+			float dz = location.z - g_player->data.location.z;
+			minDistanceSq = std::min(minDistanceSq, dx * dx + dy * dy + dz * dz);
+		}
+
+		float lodDistance = Settings::GetFloat(Settings::ID::kLODDistance);
+		if (lodDistance > 0.0f && minDistanceSq > lodDistance * lodDistance) {
+			return std::nullopt;
+		}
+
+		return minDistanceSq;
+	}
+
+	void ScheduleFrame();
+
+	void TickFrame() {
+		std::lock_guard lock(g_lock);
+
+		g_frameScheduled = false;
+
+		g_scheduler.Run(Settings::GetUInt(Settings::ID::kFrameBudget), GetScenePriority);
+
+		// 미뤄진 씬이 범위 안으로 들어오는지 매 프레임 다시 확인
+		if (!g_scheduler.IsEmpty()) {
+			ScheduleFrame();
+		}
+	}
+
+	void ScheduleFrame() {
+		if (g_frameScheduled) {
+			return;
+		}
+
+		g_frameScheduled = true;
+		Executors::GetMainExecutor().Post(TickFrame);
+	}
+
+	// 예산과 LOD 거리를 모두 쓰지 않으면 바로 적용
+	void QueueAnimationChange(std::string a_position, std::uint64_t a_sceneID, std::vector<std::uint32_t> a_formIDs, std::vector<PositionData::Data> a_posDataVec, bool a_fromCache, std::uint64_t a_queuedTime) {
+		if (!GetSceneDataByID(a_sceneID)) {
+			return;
+		}
+
+		if ((Settings::GetUInt(Settings::ID::kFrameBudget) == 0 && Settings::GetFloat(Settings::ID::kLODDistance) <= 0.0f) || !F4SE::GetTaskInterface()) {
+			// 설정이 바뀌기 전에 대기 중이던 변경이 나중에 덮어쓰지 않도록 버림
+			g_scheduler.Cancel(a_sceneID);
+			ChangeAnimation(a_position, a_sceneID, a_formIDs, a_posDataVec, a_fromCache, a_queuedTime);
+			return;
+		}
+
+		g_scheduler.Submit(a_sceneID, [position = std::move(a_position), a_sceneID, formIDs = std::move(a_formIDs), posDataVec = std::move(a_posDataVec), a_fromCache, a_queuedTime]() {
+			ChangeAnimation(position, a_sceneID, formIDs, posDataVec, a_fromCache, a_queuedTime);
+		});
+		ScheduleFrame();
+	}
+
+	// 파일은 입출력 스레드에서 읽은 뒤 메인 스레드에서 적용
+	// 씬 ID는 초기화마다 새로 발급되므로 그 사이에 씬이 끝났다면 적용할 때 찾지 못하고 버려짐
+	Async::Task RunAnimationChange(std::uint32_t a_epoch, std::string a_position, std::uint64_t a_sceneID, std::vector<std::uint32_t> a_formIDs, bool a_hasPlayer, std::uint64_t a_queuedTime) {
+		co_await Async::ResumeOn{ Executors::GetIOExecutor() };
+		std::vector<PositionData::Data> posDataVec;
+		bool fromCache = false;
+		if (!IsBakedPosition(a_position, a_hasPlayer)) {
+			posDataVec = LoadPosition(a_position, a_hasPlayer, fromCache);
+		}
+
+		co_await Async::ResumeOn{ Executors::GetMainExecutor() };
+
+		std::lock_guard lock(g_lock);
+		if (a_epoch == g_epoch) {
+			QueueAnimationChange(std::move(a_position), a_sceneID, std::move(a_formIDs), std::move(posDataVec), fromCache, a_queuedTime);
+		}
+	}
+
+	// 씬 초기화와 종료는 파일을 읽지 않으므로 스크립트 스레드에서 바로 처리
+	void SceneInit(std::monostate, const RE::BSTArray<RE::Actor*>& a_actors, RE::Actor* a_doppelganger) {
+		std::lock_guard lock(g_lock);
+
+		InitScene(a_actors, a_doppelganger);
+	}
+
+	// 씬 ID와 폼 ID만 코루틴에 넘기고 액터는 적용할 때 다시 찾음
+	void AnimationChange(std::monostate, const std::string& a_position, const RE::BSTArray<RE::Actor*>& a_actors) {
+		std::uint64_t queuedTime = Telemetry::GetTimestamp();
+
+		std::uint64_t sceneID;
+		{
+			std::shared_lock lock(g_lock);
+			sceneID = GetSceneIDFromActorArray(a_actors);
+		}
+		if (!sceneID) {
+			return;
+		}
+
+		std::vector<std::uint32_t> formIDs;
+		formIDs.reserve(a_actors.size());
+		for (auto actor : a_actors) {
+			formIDs.push_back(actor ? actor->formID : 0);
+		}
+
+		RunAnimationChange(g_epoch, a_position, sceneID, std::move(formIDs), IsPlayerInActors(a_actors), queuedTime);
+	}
+
+	void SceneEnd(std::monostate, const RE::BSTArray<RE::Actor*>& a_actors) {
+		bool closeMenu = false;
+		{
+			std::shared_lock lock(g_lock);
+			std::uint64_t sceneID = GetSceneIDFromActorArray(a_actors);
+			ActorData* selectedActorData = GetSelectedActorData();
+			closeMenu = sceneID && selectedActorData && selectedActorData->SceneID == sceneID && Scaleforms::IsMenuOpen();
+		}
+
+		// 메뉴를 닫으면서 이동한 오프셋을 저장하므로 락 밖에서 닫음
+		if (closeMenu) {
+			Scaleforms::CloseMenu();
+		}
+
+		std::uint64_t sceneID;
+		{
+			std::lock_guard lock(g_lock);
+			sceneID = EndScene(a_actors);
+		}
+
+		if (sceneID) {
+			LogSceneEnd(sceneID);
+		}
+	}
+
+	std::uint32_t GetMovability(ActorData* a_actorData) {
+		if (!a_actorData) {
+			return CAN_MOVE::kNo_Selection;
+		}
+
+		std::uint32_t positionerType = GetPositionerType(a_actorData);
+
+		// 위치 조절 타입이 스케일이고 액터 스케일이 1이면 이동 불가
+		if (positionerType == POSITIONER_TYPE::kRelative && IsActorScale1(a_actorData->Actor)) {
+			return CAN_MOVE::kNo_Scale;
+		}
+
+		return CAN_MOVE::kYes;
+	}
+
+	std::uint32_t CanMovePosition(std::monostate) {
+		std::shared_lock lock(g_lock);
+
+		return GetMovability(GetSelectedActorData());
+	}
+
+	RE::Actor* ChangeSelectedActor() {
+		ActorData* actorData;
+		SceneData* sceneData;
+
+		// 현재 선택되어있는 액터를 가져옴
+		actorData = GetSelectedActorData();
+
+		// 현재 선택되어있는 액터가 없을 경우
+		if (!actorData) {
+			// 플레이어로 진행중인 씬이 있는지 확인
+			actorData = GetPlayerActorData();
+			if (actorData) {
+				// 플레이어로 진행중인 씬이 있을 때 씬 정보를 가져옴
+				SceneData* playerScene = GetSceneDataByID(actorData->SceneID);
+				if (!playerScene || playerScene->ActorList.empty()) {
+					return nullptr;
+				}
+
+				// 해당 씬의 가장 첫 액터를 선택하여 반환
+				actorData = GetActorDataByFormID(playerScene->ActorList.front());
+				if (!actorData) {
+					return nullptr;
+				}
+
+				SetSelectedActorFormID(actorData->FormID);
+				return actorData->Actor;
+			}
+
+			// 플레이어로 진행중인 씬이 없는 경우
+			// 첫 씬의 첫 액터를 선택하여 반환함
+			if (g_sceneMap.empty()) {
+				return nullptr;
+			}
+
+			sceneData = &g_sceneMap.begin()->second;
+			if (sceneData->ActorList.empty()) {
+				return nullptr;
+			}
+
+			actorData = GetActorDataByFormID(sceneData->ActorList.front());
+			if (!actorData) {
+				return nullptr;
+			}
+
+			SetSelectedActorFormID(actorData->FormID);
+			return actorData->Actor;
+		}
+
+		// 현재 선택되어있는 액터가 있을 경우 현재 액터가 포함된 씬을 가져옴
+		auto scene_iter = g_sceneMap.find(actorData->SceneID);
+		if (scene_iter == g_sceneMap.end()) {
+			return nullptr;
+		}
+
+		sceneData = &scene_iter->second;
+
+		// 현재 선택된 액터를 찾고 그 액터의 다음 액터를 찾아서 반환
+		auto actor_iter = std::find(sceneData->ActorList.begin(), sceneData->ActorList.end(), actorData->FormID);
+		if (actor_iter == sceneData->ActorList.end()) {
+			return nullptr;
+		}
+
+		actor_iter = std::next(actor_iter);
+		if (actor_iter != sceneData->ActorList.end()) {
+			actorData = GetActorDataByFormID(*actor_iter);
+			if (!actorData) {
+				return nullptr;
+			}
+
+			SetSelectedActorFormID(actorData->FormID);
+			return actorData->Actor;
+		}
+
+		// 선택된 액터가 해당 씬의 마지막 액터였을 경우
+		// 해당 씬의 다음 씬의 첫 액터를 찾아서 반환
+		scene_iter = std::next(scene_iter);
+		if (scene_iter != g_sceneMap.end()) {
+			sceneData = &scene_iter->second;
+			if (sceneData->ActorList.empty()) {
+				return nullptr;
+			}
+
+			actorData = GetActorDataByFormID(sceneData->ActorList.front());
+			if (!actorData) {
+				return nullptr;
+			}
+
+			SetSelectedActorFormID(actorData->FormID);
+			return actorData->Actor;
+		}
+
+		// 선택된 액터가 마지막 씬의 마지막 액터였을 경우
+		// 가장 첫 씬의 첫 액터를 찾아서 반환
+		sceneData = &g_sceneMap.begin()->second;
+		if (sceneData->ActorList.empty()) {
+			return nullptr;
+		}
+
+		actorData = GetActorDataByFormID(sceneData->ActorList.front());
+		if (!actorData) {
+			return nullptr;
+		}
+
+		SetSelectedActorFormID(actorData->FormID);
+		return actorData->Actor;
+	}
+
+	bool ChangeActor_Native(std::monostate) {
+		std::lock_guard lock(g_lock);
+
+		ActorData* selectedActorData = GetSelectedActorData();
+		if (selectedActorData) {
+			ClearHighlightSpellFromActor(selectedActorData->Actor);
+		}
+
+		RE::Actor* selectedActor = ChangeSelectedActor();
+		if (!selectedActor) {
+			return false;
+		}
+
+		if (GetMovability(GetSelectedActorData()) == CAN_MOVE::kYes) {
+			Mutators::AddSpell(selectedActor, GetHighlightSpell(true));
+		}
+		else {
+			Mutators::AddSpell(selectedActor, GetHighlightSpell(false));
+		}
+
+		return true;
+	}
+
+	void ClearActorSelection(std::monostate) {
+		std::lock_guard lock(g_lock);
+
+		ActorData* selectedActorData = GetSelectedActorData();
+		if (selectedActorData) {
+			ClearHighlightSpellFromActor(selectedActorData->Actor);
+		}
+		ClearSelectedActorFormID();
+	}
+
+	// 선택한 액터를 바꾸고 이동 가능 여부에 맞는 하이라이트를 적용
+	bool SelectActor(ActorData* a_actorData) {
+		if (!a_actorData) {
+			return false;
+		}
+
+		ActorData* selectedActorData = GetSelectedActorData();
+		if (selectedActorData == a_actorData) {
+			return true;
+		}
+
+		if (selectedActorData) {
+			ClearHighlightSpellFromActor(selectedActorData->Actor);
+		}
+
+		SetSelectedActorFormID(a_actorData->FormID);
+		Mutators::AddSpell(a_actorData->Actor, GetHighlightSpell(GetMovability(a_actorData) == CAN_MOVE::kYes));
+		return true;
+	}
+
+	bool SelectNearestActor(std::monostate, float a_x, float a_y, float a_z) {
+		std::lock_guard lock(g_lock);
+
+		auto formID = g_actorGrid.FindNearest(Vector3{ a_x, a_y, a_z });
+		return formID && SelectActor(GetActorDataByFormID(*formID));
+	}
+
+	// 광선에서 반경 안에 있는 액터 중 광선에 가장 가까운 액터를 선택, 카메라 시선으로 바라보는 액터를 고를 때 사용
+	bool SelectActorAlongRay(std::monostate, float a_originX, float a_originY, float a_originZ, float a_dirX, float a_dirY, float a_dirZ, float a_radius, float a_maxDistance) {
+		std::lock_guard lock(g_lock);
+
+		auto formID = g_actorGrid.FindNearestToRay(Vector3{ a_originX, a_originY, a_originZ }, Vector3{ a_dirX, a_dirY, a_dirZ }, a_radius, a_maxDistance);
+		return formID && SelectActor(GetActorDataByFormID(*formID));
+	}
+
+	// 플레이어와 가까운 순서로 다음 액터를 선택하고, 마지막 액터 다음에는 가장 가까운 액터로 돌아감
+	bool SelectNextNearestActor(std::monostate) {
+		std::lock_guard lock(g_lock);
+
+		RE::PlayerCharacter* g_player = RE::PlayerCharacter::GetSingleton();
+		if (!g_player) {
+			return false;
+		}
+
+		std::vector<std::uint32_t> sorted = g_actorGrid.SortByDistance(Utils::ToVector3(g_player->data.location));
+		if (sorted.empty()) {
+			return false;
+		}
+
+		auto it = std::find(sorted.begin(), sorted.end(), GetSelectedActorFormID());
+		if (it == sorted.end() || ++it == sorted.end()) {
+			it = sorted.begin();
+		}
+
+		return SelectActor(GetActorDataByFormID(*it));
+	}
+
+	// 액터마다 x, y, z 순서로 이어붙인 배열을 반환하고, 씬에 없는 액터는 0으로 채움
+	std::vector<float> GetSceneOffsets(std::monostate, const RE::BSTArray<RE::Actor*>& a_actors) {
+		std::shared_lock lock(g_lock);
+
+		std::vector<float> result;
+		result.reserve(a_actors.size() * 3);
+
+		std::uint64_t sceneID = GetSceneIDFromActorArray(a_actors);
+		for (auto actor : a_actors) {
+			ActorData* actorData = GetSceneActorData(actor, sceneID);
+			RE::NiPoint3 offset = actorData ? actorData->Offset : RE::NiPoint3{};
+
+			result.push_back(offset.x);
+			result.push_back(offset.y);
+			result.push_back(offset.z);
+		}
+
+		return result;
+	}
+
+	bool SetSceneOffsets(std::monostate, const RE::BSTArray<RE::Actor*>& a_actors, const RE::BSTArray<float>& a_offsets) {
+		if (a_offsets.size() != a_actors.size() * 3) {
+			logger::warn("SetSceneOffsets: expected {} offsets for {} actors, got {}", a_actors.size() * 3, a_actors.size(), a_offsets.size());
+			return false;
+		}
+
+		// NaN이나 무한대가 하나라도 있으면 아무것도 적용하지 않음
+		if (!std::all_of(a_offsets.begin(), a_offsets.end(), [](float a_value) { return std::isfinite(a_value); })) {
+			logger::warn("SetSceneOffsets: offsets must be finite");
+			return false;
+		}
+
+		std::lock_guard lock(g_lock);
+
+		std::uint64_t sceneID = GetSceneIDFromActorArray(a_actors);
+		if (!sceneID) {
+			return false;
+		}
+
+		float offsetLimit = Settings::GetFloat(Settings::ID::kOffsetLimit);
+
+		bool applied = false;
+		for (std::uint32_t ii = 0; ii < a_actors.size(); ii++) {
+			ActorData* actorData = GetSceneActorData(a_actors[ii], sceneID);
+			if (!actorData || !GetCachedExtraRefrPath(actorData)) {
+				continue;
+			}
+
+			// 다른 입력 경로와 같이 오프셋 한계로 제한
+			Vector3 offset{ a_offsets[ii * 3], a_offsets[ii * 3 + 1], a_offsets[ii * 3 + 2] };
+			actorData->Offset = Utils::ToNiPoint3(OffsetMath::Clamp(offset, offsetLimit));
+			ApplyOffset(actorData);
+			applied = true;
+
+			if (Scaleforms::IsMenuOpen() && actorData->FormID == GetSelectedActorFormID()) {
+				Scaleforms::UpdateMenu(actorData->Offset);
+			}
+		}
+
+		if (applied) {
+			SavePosition(GetSceneDataByID(sceneID));
+		}
+
+		return applied;
+	}
+
+	void ClearSceneOffsets(std::monostate, const RE::BSTArray<RE::Actor*>& a_actors) {
+		std::lock_guard lock(g_lock);
+
+		std::uint64_t sceneID = GetSceneIDFromActorArray(a_actors);
+		if (!sceneID) {
+			return;
+		}
+
+		bool applied = false;
+		for (auto actor : a_actors) {
+			ActorData* actorData = GetSceneActorData(actor, sceneID);
+			if (!actorData || !GetCachedExtraRefrPath(actorData)) {
+				continue;
+			}
+
+			actorData->Offset = RE::NiPoint3{};
+			ApplyOffset(actorData);
+			applied = true;
+
+			if (Scaleforms::IsMenuOpen() && actorData->FormID == GetSelectedActorFormID()) {
+				Scaleforms::UpdateMenu(actorData->Offset);
+			}
+		}
+
+		if (applied) {
+			SavePosition(GetSceneDataByID(sceneID));
+		}
+	}
+
+	// CanMovePosition과 같은 값을 액터마다 반환
+	std::vector<std::uint32_t> GetSceneMovability(std::monostate, const RE::BSTArray<RE::Actor*>& a_actors) {
+		std::shared_lock lock(g_lock);
+
+		std::vector<std::uint32_t> result;
+		result.reserve(a_actors.size());
+
+		std::uint64_t sceneID = GetSceneIDFromActorArray(a_actors);
+		for (auto actor : a_actors) {
+			result.push_back(GetMovability(GetSceneActorData(actor, sceneID)));
+		}
+
+		return result;
+	}
+
+	// 분류마다 현재 사용량과 최대 사용량을 KB 단위로 이어서 반환
+	std::vector<std::uint32_t> GetMemoryUsage(std::monostate) {
+		std::vector<std::uint32_t> result;
+		for (std::uint32_t ii = 0; ii < static_cast<std::uint32_t>(MemoryTracker::CATEGORY::kTotal); ii++) {
+			MemoryTracker::Usage usage = MemoryTracker::GetUsage(static_cast<MemoryTracker::CATEGORY>(ii));
+			result.push_back(static_cast<std::uint32_t>(std::min<std::size_t>(usage.current / 1024, 0xFFFFFFFF)));
+			result.push_back(static_cast<std::uint32_t>(std::min<std::size_t>(usage.peak / 1024, 0xFFFFFFFF)));
+		}
+		return result;
+	}
+
+	void LogMemoryUsage(std::monostate) {
+		LogMemoryStats();
+	}
+
+	void ShowPositionerMenu_Native(std::monostate) {
+		std::lock_guard lock(g_lock);
+
+		ActorData* actorData = GetSelectedActorData();
+		if (!actorData) {
+			return;
+		}
+
+		// 메뉴를 열 때는 캐시를 믿지 않고 extraList를 다시 확인
+		actorData->ExtraRefrPathGeneration = 0;
+		if (!GetCachedExtraRefrPath(actorData)) {
+			return;
+		}
+
+		if (Scaleforms::IsMenuOpen()) {
+			return;
+		}
+
+		Scaleforms::OpenMenu(actorData->Offset);
+	}
+
+	void Install(RE::BSScript::IVirtualMachine* a_vm) {
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SceneInit"sv, SceneInit);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "AnimationChange"sv, AnimationChange);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SceneEnd"sv, SceneEnd);
+
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "CanMovePosition"sv, CanMovePosition);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "ChangeActor_Native"sv, ChangeActor_Native);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "ClearActorSelection"sv, ClearActorSelection);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SelectNearestActor"sv, SelectNearestActor);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SelectActorAlongRay"sv, SelectActorAlongRay);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SelectNextNearestActor"sv, SelectNextNearestActor);
+
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "ShowPositionerMenu_Native"sv, ShowPositionerMenu_Native);
+
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "GetSceneOffsets"sv, GetSceneOffsets);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "SetSceneOffsets"sv, SetSceneOffsets);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "ClearSceneOffsets"sv, ClearSceneOffsets);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "GetSceneMovability"sv, GetSceneMovability);
+
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "GetMemoryUsage"sv, GetMemoryUsage);
+		a_vm->BindNativeMethod("AAFDynamicPositioner"sv, "LogMemoryUsage"sv, LogMemoryUsage);
+	}
+}
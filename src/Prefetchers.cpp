@@ -0,0 +1,108 @@
+#include "Prefetchers.h"
+
+#include "Core/PositionCache.h"
+#include "Core/Telemetry.h"
+#include "Core/Tokenizer.h"
+#include "Core/TransitionModel.h"
+#include "Executors.h"
+#include "PositionData.h"
+#include "Settings.h"
+
+namespace Prefetchers {
+	constexpr std::size_t kMaxPendingPrefetches = 64;
+
+	struct PendingPrefetch {
+		std::string position;
+		bool        isPlayerScene;
+	};
+
+	// Recently prefetched positions, only touched on the main thread
+	std::deque<PendingPrefetch> g_pending;
+	std::uint64_t g_hits = 0;
+	std::uint64_t g_misses = 0;
+
+	const std::string& GetModelPath() {
+		static const std::string modelPath = fmt::format("Data\\F4SE\\Plugins\\{}\\Transitions.dat", Version::PROJECT);
+		return modelPath;
+	}
+
+	void Load() {
+		PositionCache::SetMemoryLimit(static_cast<std::size_t>(Settings::GetUInt(Settings::ID::kPrewarmMemoryLimit)) * 1024 * 1024);
+
+		Executors::GetIOExecutor().Post([]() {
+			if (TransitionModel::Load(GetModelPath())) {
+				logger::info("Loaded the position transition model");
+			}
+		});
+	}
+
+	void Save() {
+		if (!TransitionModel::IsDirty()) {
+			return;
+		}
+
+		Executors::GetIOExecutor().Post([]() {
+			if (!TransitionModel::Save(GetModelPath())) {
+				logger::warn("Cannot save the position transition model: {}", GetModelPath());
+			}
+		});
+	}
+
+	bool TakePending(const std::string& a_position, bool a_isPlayerScene) {
+		auto it = std::find_if(g_pending.begin(), g_pending.end(), [&](const PendingPrefetch& a_pending) {
+			return a_pending.isPlayerScene == a_isPlayerScene && Tokenizer::IEquals(a_pending.position, a_position);
+		});
+
+		if (it == g_pending.end()) {
+			return false;
+		}
+
+		g_pending.erase(it);
+		return true;
+	}
+
+	// A hit is a predicted position whose load was served from the cache, a prediction the load missed anyway does not count
+	void OnAnimationChange(const std::string& a_prevPosition, const std::string& a_position, bool a_isPlayerScene, bool a_fromCache) {
+		if (!Settings::GetBool(Settings::ID::kPrefetch)) {
+			return;
+		}
+
+		if (TakePending(a_position, a_isPlayerScene) && a_fromCache) {
+			g_hits++;
+		}
+		else {
+			g_misses++;
+		}
+		Telemetry::UpdatePrefetch(g_hits, g_misses);
+
+		TransitionModel::Observe(a_prevPosition, a_position);
+
+		std::vector<std::string> predictions = TransitionModel::Predict(a_position, Settings::GetUInt(Settings::ID::kPrefetchCount));
+		for (const auto& prediction : predictions) {
+			// A prediction that is still pending only moves to the back instead of being read again
+			bool isPending = TakePending(prediction, a_isPlayerScene);
+
+			g_pending.push_back({ prediction, a_isPlayerScene });
+			if (g_pending.size() > kMaxPendingPrefetches) {
+				g_pending.pop_front();
+			}
+
+			if (isPending) {
+				continue;
+			}
+
+			Executors::GetIOExecutor().Post([prediction, a_isPlayerScene]() {
+				PositionData::Prefetch(prediction, a_isPlayerScene);
+			});
+		}
+	}
+
+	void LogStats() {
+		std::uint64_t total = g_hits + g_misses;
+		if (total == 0) {
+			return;
+		}
+
+		logger::debug("Prefetch hits: {}/{} ({:.1f}%)", g_hits, total, 100.0 * static_cast<double>(g_hits) / static_cast<double>(total));
+	}
+}
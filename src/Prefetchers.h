@@ -0,0 +1,8 @@
+#pragma once
+
+namespace Prefetchers {
+	void Load();
+	void Save();
+	void OnAnimationChange(const std::string& a_prevPosition, const std::string& a_position, bool a_isPlayerScene, bool a_fromCache);
+	void LogStats();
+}
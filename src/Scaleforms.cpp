@@ -1,383 +1,511 @@
-#include "Scaleforms.h"
-
-#include <fstream>
-
-#include "Positioners.h"
-#include "Inputs.h"
-#include "Utils.h"
-
-namespace Scaleforms {
-	constexpr const char* MenuName = "AAFDynamicPositionerMenu";
-
-	RE::NiPoint3 g_offset;
-	std::map<RE::BSInputEventUser*, bool> g_menuEnableMap;
-
-	class PositionerMenu : public RE::IMenu {
-	public:
-		PositionerMenu() : RE::IMenu() {
-			Instance = this;
-			Instance->menuFlags.set(RE::UI_MENU_FLAGS::kUsesCursor, RE::UI_MENU_FLAGS::kTopmostRenderedMenu);
-			Instance->depthPriority.set(RE::UI_DEPTH_PRIORITY::kTerminal);
-			Instance->inputEventHandlingEnabled = false;
-
-			RE::BSScaleformManager* scaleformManager = RE::BSScaleformManager::GetSingleton();
-			if (scaleformManager) {
-				scaleformManager->LoadMovie(*Instance, uiMovie, MenuName, "root1");
-			}
-		}
-
-		~PositionerMenu() {
-			Instance = nullptr;
-		}
-
-		bool ShouldHandleEvent(const RE::InputEvent*) override {
-			return true;
-		}
-
-		void OnButtonEvent(const RE::ButtonEvent* a_inputEvent) override {
-			std::uint32_t keyCode;
-
-			if (a_inputEvent->device == RE::INPUT_DEVICE::kMouse) {
-				keyCode = Inputs::GetMouseKeycode(a_inputEvent->idCode);
-			}
-			else if (a_inputEvent->device == RE::INPUT_DEVICE::kGamepad) {
-				keyCode = Inputs::GamepadMaskToKeycode(a_inputEvent->idCode);
-			}
-			else {
-				keyCode = a_inputEvent->idCode;
-			}
-
-			if (!Inputs::IsValidKeycode(keyCode)) {
-				return;
-			}
-
-			keyCode = Inputs::ReplaceKeyCodeForMenu(keyCode);
-
-			sendKeyEvent(keyCode, a_inputEvent->value == 1.0f);
-		}
-
-		void OnThumbstickEvent(const RE::ThumbstickEvent* a_inputEvent) override {
-			if (a_inputEvent->idCode != RE::ThumbstickEvent::THUMBSTICK_ID::kLeft) {
-				return;
-			}
-
-			std::uint32_t prevKeyCode = Inputs::DirectionToKeyCode(a_inputEvent->prevDir);
-			std::uint32_t currKeyCode = Inputs::DirectionToKeyCode(a_inputEvent->currDir);
-			if (currKeyCode != 0xFF) {
-				sendKeyEvent(currKeyCode, true);
-			}
-			else {
-				if (currKeyCode == prevKeyCode) {
-					sendKeyEvent(0x25, false);
-					sendKeyEvent(0x26, false);
-					sendKeyEvent(0x27, false);
-					sendKeyEvent(0x28, false);
-				}
-				else {
-					sendKeyEvent(prevKeyCode, false);
-				}
-			}
-		}
-
-		static PositionerMenu* GetSingleton() {
-			return Instance;
-		}
-
-	private:
-		void sendKeyEvent(uint32_t a_keyCode, bool a_isDown) {
-			PositionerMenu* positioner = PositionerMenu::GetSingleton();
-			if (!positioner) {
-				return;
-			}
-
-			RE::Scaleform::GFx::ASMovieRootBase* movieRoot = positioner->uiMovie->asMovieRoot.get();
-			RE::Scaleform::GFx::Value root;
-			if (!movieRoot || !movieRoot->GetVariable(&root, "root")) {
-				logger::critical("SendKeyEvent: Couldn't get a root");
-				return;
-			}
-
-			RE::Scaleform::GFx::Value params[2];
-			params[0] = a_keyCode;
-			params[1] = a_isDown;
-
-			root.Invoke("ProcessKeyEvent", nullptr, params, 2);
-		}
-
-		static inline PositionerMenu* Instance = nullptr;
-	};
-
-	class Localizations {
-	public:
-		Localizations() {}
-
-		static Localizations& GetSingleton() {
-			static Localizations loc;
-			return loc;
-		}
-
-		std::string lang;
-		std::unordered_map<std::string, std::string> translationsMap;
-	};
-
-	class ThrowHandler : public RE::Scaleform::GFx::FunctionHandler {
-	public:
-		virtual void Call(const Params& a_params) override {
-			if (a_params.argCount > 0) {
-				logger::critical("Throw Message: {}", a_params.args[0].GetString());
-			}
-			CloseMenu();
-		}
-	};
-
-	class CloseHandler : public RE::Scaleform::GFx::FunctionHandler {
-	public:
-		virtual void Call(const Params&) override {
-			CloseMenu();
-		}
-	};
-
-	class GetInitializationDataHandler : public RE::Scaleform::GFx::FunctionHandler {
-	public:
-		virtual void Call(const Params& a_params) override {
-			RE::IMenu* positioner = PositionerMenu::GetSingleton();
-			if (!positioner) {
-				logger::critical("GetInitializationDataHandler: Couldn't get a positioner!");
-				return;
-			}
-
-			positioner->inputEventHandlingEnabled = true;
-
-			RE::Scaleform::GFx::ASMovieRootBase* movieRoot = a_params.movie->asMovieRoot.get();
-			if (!movieRoot) {
-				logger::critical("GetInitializationDataHandler: Couldn't get a movieRoot!");
-				return;
-			}
-
-			movieRoot->CreateObject(a_params.retVal);
-
-			RE::Scaleform::GFx::Value locVal;
-			movieRoot->CreateObject(&locVal);
-
-			Localizations& loc = Localizations::GetSingleton();
-			for (const auto& transPair : loc.translationsMap) {
-				locVal.SetMember(transPair.first, RE::Scaleform::GFx::Value(transPair.second.c_str()));
-			}
-
-			a_params.retVal->SetMember("Language", loc.lang.c_str());
-			a_params.retVal->SetMember("Localizations", locVal);
-		}
-	};
-
-	class InitializationCompleteHandler : public RE::Scaleform::GFx::FunctionHandler {
-	public:
-		virtual void Call(const Params& a_params) override {
-			RE::Scaleform::GFx::ASMovieRootBase* movieRoot = a_params.movie->asMovieRoot.get();
-			RE::Scaleform::GFx::Value root;
-			if (!movieRoot || !movieRoot->GetVariable(&root, "root")) {
-				logger::critical("InitializationCompleteHandler: Couldn't get a root!");
-				return;
-			}
-
-			RE::Scaleform::GFx::Value offset[3];
-			offset[0] = g_offset.x;
-			offset[1] = g_offset.y;
-			offset[2] = g_offset.z;
-
-			root.Invoke("ShowMenu", nullptr, offset, 3);
-		}
-	};
-
-	class UpdateSettingsHandler : public RE::Scaleform::GFx::FunctionHandler {
-	public:
-		virtual void Call(const Params& a_params) override {
-			if (a_params.argCount == 0 || a_params.args[0].GetType() != RE::Scaleform::GFx::Value::ValueType::kString) {
-				return;
-			}
-
-			if (a_params.argCount == 2) {
-				if (strcmp(a_params.args[0].GetString(), "bSeparatePlayerOffset") == 0) {
-					Positioners::g_separatePlayerOffset = a_params.args[1].GetBoolean();
-				}
-				else if (strcmp(a_params.args[0].GetString(), "bUnifyAAFDoppelgangerScale") == 0) {
-					Positioners::g_unifyAAFDoppelgangerScale = a_params.args[1].GetBoolean();
-				}
-				else if (strcmp(a_params.args[0].GetString(), "iPlayerPositionerType") == 0) {
-					Positioners::g_playerPositionerType = a_params.args[1].GetInt();
-				}
-				else if (strcmp(a_params.args[0].GetString(), "iNPCPositionerType") == 0) {
-					Positioners::g_npcPositionerType = a_params.args[1].GetInt();
-				}
-			}
-		}
-	};
-
-	class SetPositionHandler : public RE::Scaleform::GFx::FunctionHandler {
-	public:
-		virtual void Call(const Params& a_params) override {
-			std::string axis = a_params.args[0].GetString();
-			float value = static_cast<float>(a_params.args[1].GetNumber());
-
-			Positioners::SetOffset(axis, value);
-		}
-	};
-
-	class ClearPositionHandler : public RE::Scaleform::GFx::FunctionHandler {
-	public:
-		virtual void Call(const Params&) override {
-			Positioners::ClearOffset();
-		}
-	};
-
-	void RegisterMenu() {
-		RE::UI* ui = RE::UI::GetSingleton();
-		if (!ui) {
-			logger::critical("Menu Registration Failed");
-			return;
-		}
-
-		ui->RegisterMenu(MenuName, [](const RE::UIMessage&) -> RE::IMenu* {
-			PositionerMenu* positioner = PositionerMenu::GetSingleton();
-			if (!positioner) {
-				positioner = new PositionerMenu();
-			}
-			return positioner;
-		});
-
-		logger::info("Menu Registered");
-	}
-
-	void LoadLocalizations() {
-		Localizations& loc = Localizations::GetSingleton();
-
-		loc.lang = "en";	// Default sLanguage
-		RE::INISettingCollection* iniSettings = RE::INISettingCollection::GetSingleton();
-		if (iniSettings) {
-			for (RE::Setting* set : iniSettings->settings) {
-				if (set->GetKey() == "sLanguage:General"sv) {
-					loc.lang = set->GetString();
-					break;
-				}
-			}
-		}
-
-		std::string transPath = fmt::format("Data\\Interface\\Translations\\{}_{}.txt", MenuName, loc.lang);
-		std::ifstream transFile(transPath);
-		if (!transFile.is_open()) {
-			bool found = false;
-
-			if (loc.lang != "en") {
-				logger::warn("Cannot open the translation file: {}", transPath);
-
-				transPath = fmt::format("Data\\Interface\\Translations\\{}_en.txt", MenuName);
-				transFile.clear();
-				transFile.open(transPath);
-				if (transFile.is_open()) {
-					found = true;
-				}
-			}
-
-			if (!found) {
-				logger::warn("Cannot find the translation file: {}", transPath);
-				return;
-			}
-		}
-
-		std::string line;
-		std::string name, value;
-		while (std::getline(transFile, line)) {
-			Utils::Trim(line);
-			if (line.empty() || line.starts_with('#')) {
-				continue;
-			}
-
-			std::uint32_t index = 0;
-
-			name = Utils::GetNextData(line, index, '\t');
-			if (name.empty()) {
-				logger::warn(FMT_STRING("Cannot read the name: {}"), line);
-				continue;
-			}
-
-			value = Utils::GetNextData(line, index, 0);
-			if (value.empty()) {
-				logger::warn(FMT_STRING("Cannot read the value: {}"), line);
-				continue;
-			}
-
-			loc.translationsMap.insert(std::make_pair(name, value));
-		}
-	}
-
-	void RegisterFunction(RE::Scaleform::GFx::Movie* a_view, RE::Scaleform::GFx::Value* a_f4se_root, RE::Scaleform::GFx::FunctionHandler* a_handler, F4SE::stl::zstring a_name) {
-		RE::Scaleform::GFx::Value fn;
-		a_view->CreateFunction(&fn, a_handler);
-		a_f4se_root->SetMember(a_name, fn);
-	}
-
-	void RegisterFunctions(RE::Scaleform::GFx::Movie* a_view, RE::Scaleform::GFx::Value* a_f4se_root) {
-		RegisterFunction(a_view, a_f4se_root, new ThrowHandler(), "Throw"sv);
-		RegisterFunction(a_view, a_f4se_root, new CloseHandler(), "Close"sv);
-		RegisterFunction(a_view, a_f4se_root, new GetInitializationDataHandler(), "GetInitializationData"sv);
-		RegisterFunction(a_view, a_f4se_root, new InitializationCompleteHandler(), "InitializationComplete"sv);
-		RegisterFunction(a_view, a_f4se_root, new UpdateSettingsHandler(), "UpdateSettings"sv);
-		RegisterFunction(a_view, a_f4se_root, new SetPositionHandler(), "SetPosition"sv);
-		RegisterFunction(a_view, a_f4se_root, new ClearPositionHandler(), "ClearPosition"sv);
-	}
-
-	void OpenMenu(RE::NiPoint3& a_offset) {
-		g_offset = a_offset;
-
-		Inputs::BlockPlayerControls(true);
-		Inputs::EnableMenuControls(g_menuEnableMap, false);
-		Inputs::SetInputEnableLayer();
-
-		RE::UIMessageQueue* uiMessageQueue = RE::UIMessageQueue::GetSingleton();
-		if (uiMessageQueue) {
-			uiMessageQueue->AddMessage(MenuName, RE::UI_MESSAGE_TYPE::kShow);
-		}
-	}
-
-	void UpdateMenu(RE::NiPoint3& a_offset) {
-		if (!IsMenuOpen()) {
-			return;
-		}
-
-		g_offset = a_offset;
-
-		PositionerMenu* positioner = PositionerMenu::GetSingleton();
-		if (!positioner) {
-			return;
-		}
-
-		RE::Scaleform::GFx::ASMovieRootBase* movieRoot = positioner->uiMovie->asMovieRoot.get();
-		RE::Scaleform::GFx::Value root;
-		if (!movieRoot || !movieRoot->GetVariable(&root, "root")) {
-			logger::critical("UpdateMenu: Couldn't get a root");
-			return;
-		}
-
-		RE::Scaleform::GFx::Value offset[3];
-		offset[0] = g_offset.x;
-		offset[1] = g_offset.y;
-		offset[2] = g_offset.z;
-
-		root.Invoke("UpdateOffset", nullptr, offset, 3);
-	}
-
-	void CloseMenu() {
-		Inputs::BlockPlayerControls(false);
-		Inputs::EnableMenuControls(g_menuEnableMap, true);
-		Inputs::ResetInputEnableLayer();
-
-		RE::UIMessageQueue* uiMessageQueue = RE::UIMessageQueue::GetSingleton();
-		if (uiMessageQueue) {
-			uiMessageQueue->AddMessage(MenuName, RE::UI_MESSAGE_TYPE::kHide);
-		}
-	}
-
-	bool IsMenuOpen() {
-		RE::UI* ui = RE::UI::GetSingleton();
-		return ui && ui->GetMenuOpen(MenuName);
-	}
-}
+#include "Scaleforms.h"
+
+#include "Positioners.h"
+#include "Inputs.h"
+#include "Movements.h"
+#include "Settings.h"
+#include "Utils.h"
+#include "Core/MemoryTracker.h"
+#include "Core/MenuArgs.h"
+#include "Core/Tokenizer.h"
+
+namespace Scaleforms {
+	constexpr const char* MenuName = "AAFDynamicPositionerMenu";
+
+	RE::NiPoint3 g_offset;
+
+	class PositionerMenu : public RE::IMenu {
+	public:
+		PositionerMenu() : RE::IMenu() {
+			Instance = this;
+			Instance->menuFlags.set(RE::UI_MENU_FLAGS::kUsesCursor, RE::UI_MENU_FLAGS::kTopmostRenderedMenu);
+			Instance->depthPriority.set(RE::UI_DEPTH_PRIORITY::kTerminal);
+			Instance->inputEventHandlingEnabled = false;
+
+			RE::BSScaleformManager* scaleformManager = RE::BSScaleformManager::GetSingleton();
+			if (scaleformManager) {
+				scaleformManager->LoadMovie(*Instance, uiMovie, MenuName, "root1");
+			}
+		}
+
+		~PositionerMenu() {
+			Instance = nullptr;
+		}
+
+		bool ShouldHandleEvent(const RE::InputEvent*) override {
+			return true;
+		}
+
+		void OnButtonEvent(const RE::ButtonEvent* a_inputEvent) override {
+			std::uint32_t keyCode;
+
+			if (a_inputEvent->device == RE::INPUT_DEVICE::kMouse) {
+				keyCode = Inputs::GetMouseKeycode(a_inputEvent->idCode);
+			}
+			else if (a_inputEvent->device == RE::INPUT_DEVICE::kGamepad) {
+				keyCode = Inputs::GamepadMaskToKeycode(a_inputEvent->idCode);
+			}
+			else {
+				keyCode = a_inputEvent->idCode;
+			}
+
+			if (!Inputs::IsValidKeycode(keyCode)) {
+				return;
+			}
+
+			keyCode = Inputs::ReplaceKeyCodeForMenu(keyCode);
+
+			// 좌우 입력은 메뉴로 넘기지 않고 AdvanceMovie에서 직접 적분
+			if (Movements::IsEnabled() && (keyCode == Inputs::ACTION_KEY::kActionKey_LEFT || keyCode == Inputs::ACTION_KEY::kActionKey_RIGHT)) {
+				Movements::SetHeldKey(keyCode, a_inputEvent->value == 1.0f);
+				return;
+			}
+
+			sendKeyEvent(keyCode, a_inputEvent->value == 1.0f);
+		}
+
+		void OnThumbstickEvent(const RE::ThumbstickEvent* a_inputEvent) override {
+			if (a_inputEvent->idCode != RE::ThumbstickEvent::THUMBSTICK_ID::kLeft) {
+				return;
+			}
+
+			std::uint32_t prevKeyCode = Inputs::DirectionToKeyCode(a_inputEvent->prevDir);
+			std::uint32_t currKeyCode = Inputs::DirectionToKeyCode(a_inputEvent->currDir);
+
+			// 가로 기울기는 선택된 축을 움직이고, 위아래만 메뉴로 넘김
+			if (Movements::IsEnabled()) {
+				Movements::SetStickDeflection(a_inputEvent->xValue);
+
+				if (prevKeyCode == Inputs::ACTION_KEY::kActionKey_LEFT || prevKeyCode == Inputs::ACTION_KEY::kActionKey_RIGHT) {
+					prevKeyCode = 0xFF;
+				}
+				if (currKeyCode == Inputs::ACTION_KEY::kActionKey_LEFT || currKeyCode == Inputs::ACTION_KEY::kActionKey_RIGHT) {
+					currKeyCode = 0xFF;
+				}
+			}
+
+			if (currKeyCode != 0xFF) {
+				sendKeyEvent(currKeyCode, true);
+			}
+			else {
+				if (currKeyCode == prevKeyCode) {
+					sendKeyEvent(0x25, false);
+					sendKeyEvent(0x26, false);
+					sendKeyEvent(0x27, false);
+					sendKeyEvent(0x28, false);
+				}
+				else {
+					sendKeyEvent(prevKeyCode, false);
+				}
+			}
+		}
+
+		void AdvanceMovie(float a_timeDelta, std::uint64_t a_time) override {
+			RE::NiPoint3 delta, offset;
+			if (Movements::Update(a_timeDelta, delta)) {
+				// 한 프레임 동안 받은 입력은 한 번의 적용과 메뉴 갱신으로 합침
+				if (Positioners::MoveOffset(delta, offset)) {
+					UpdateMenu(offset);
+				}
+			}
+			else if (Movements::ConsumePendingSave()) {
+				Positioners::SaveOffset();
+			}
+
+			RE::IMenu::AdvanceMovie(a_timeDelta, a_time);
+		}
+
+		static PositionerMenu* GetSingleton() {
+			return Instance;
+		}
+
+	private:
+		void sendKeyEvent(uint32_t a_keyCode, bool a_isDown) {
+			PositionerMenu* positioner = PositionerMenu::GetSingleton();
+			if (!positioner) {
+				return;
+			}
+
+			RE::Scaleform::GFx::ASMovieRootBase* movieRoot = positioner->uiMovie->asMovieRoot.get();
+			RE::Scaleform::GFx::Value root;
+			if (!movieRoot || !movieRoot->GetVariable(&root, "root")) {
+				logger::critical("SendKeyEvent: Couldn't get a root");
+				return;
+			}
+
+			RE::Scaleform::GFx::Value params[2];
+			params[0] = a_keyCode;
+			params[1] = a_isDown;
+
+			root.Invoke("ProcessKeyEvent", nullptr, params, 2);
+		}
+
+		static inline PositionerMenu* Instance = nullptr;
+	};
+
+	class Localizations {
+	public:
+		Localizations() {}
+
+		static Localizations& GetSingleton() {
+			static Localizations loc;
+			return loc;
+		}
+
+		std::string lang;
+		std::pmr::unordered_map<std::pmr::string, std::pmr::string> translationsMap{ MemoryTracker::GetResource(MemoryTracker::CATEGORY::kLocalizations) };
+	};
+
+	class ThrowHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			if (a_params.argCount > 0) {
+				logger::critical("Throw Message: {}", a_params.args[0].GetString());
+			}
+			CloseMenu();
+		}
+	};
+
+	class CloseHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params&) override {
+			CloseMenu();
+		}
+	};
+
+	class GetInitializationDataHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			RE::IMenu* positioner = PositionerMenu::GetSingleton();
+			if (!positioner) {
+				logger::critical("GetInitializationDataHandler: Couldn't get a positioner!");
+				return;
+			}
+
+			positioner->inputEventHandlingEnabled = true;
+
+			RE::Scaleform::GFx::ASMovieRootBase* movieRoot = a_params.movie->asMovieRoot.get();
+			if (!movieRoot) {
+				logger::critical("GetInitializationDataHandler: Couldn't get a movieRoot!");
+				return;
+			}
+
+			movieRoot->CreateObject(a_params.retVal);
+
+			RE::Scaleform::GFx::Value locVal;
+			movieRoot->CreateObject(&locVal);
+
+			Localizations& loc = Localizations::GetSingleton();
+			for (const auto& transPair : loc.translationsMap) {
+				locVal.SetMember(transPair.first.c_str(), RE::Scaleform::GFx::Value(transPair.second.c_str()));
+			}
+
+			a_params.retVal->SetMember("Language", loc.lang.c_str());
+			a_params.retVal->SetMember("Localizations", locVal);
+		}
+	};
+
+	class InitializationCompleteHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			RE::Scaleform::GFx::ASMovieRootBase* movieRoot = a_params.movie->asMovieRoot.get();
+			RE::Scaleform::GFx::Value root;
+			if (!movieRoot || !movieRoot->GetVariable(&root, "root")) {
+				logger::critical("InitializationCompleteHandler: Couldn't get a root!");
+				return;
+			}
+
+			RE::Scaleform::GFx::Value offset[3];
+			offset[0] = g_offset.x;
+			offset[1] = g_offset.y;
+			offset[2] = g_offset.z;
+
+			root.Invoke("ShowMenu", nullptr, offset, 3);
+		}
+	};
+
+	class UpdateSettingsHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			if (a_params.argCount == 0 || a_params.args[0].GetType() != RE::Scaleform::GFx::Value::ValueType::kString) {
+				return;
+			}
+
+			if (a_params.argCount == 2) {
+				const RE::Scaleform::GFx::Value& value = a_params.args[1];
+				double number;
+				switch (value.GetType()) {
+				case RE::Scaleform::GFx::Value::ValueType::kBoolean:
+					number = value.GetBoolean() ? 1.0 : 0.0;
+					break;
+				case RE::Scaleform::GFx::Value::ValueType::kInt:
+					number = value.GetInt();
+					break;
+				case RE::Scaleform::GFx::Value::ValueType::kUInt:
+					number = value.GetUInt();
+					break;
+				case RE::Scaleform::GFx::Value::ValueType::kNumber:
+					number = value.GetNumber();
+					break;
+				default:
+					return;
+				}
+
+				Settings::SetValue(a_params.args[0].GetString(), number);
+			}
+		}
+	};
+
+	// GFx 인자를 MenuArgs 값으로 바꿔 검증은 Core에서 하도록 함, kMaxArgs개 이상은 보지 않음
+	class Args {
+	public:
+		explicit Args(const RE::Scaleform::GFx::FunctionHandler::Params& a_params) {
+			count = std::min<std::size_t>(a_params.argCount, MenuArgs::kMaxArgs);
+			for (std::size_t ii = 0; ii < count; ii++) {
+				values[ii] = ToValue(a_params.args[ii]);
+			}
+		}
+
+		std::span<const MenuArgs::Value> Get() const { return { values.data(), count }; }
+
+	private:
+		static MenuArgs::Value ToValue(const RE::Scaleform::GFx::Value& a_value) {
+			switch (a_value.GetType()) {
+			case RE::Scaleform::GFx::Value::ValueType::kInt:
+				return { MenuArgs::TYPE::kNumber, static_cast<double>(a_value.GetInt()), {} };
+			case RE::Scaleform::GFx::Value::ValueType::kUInt:
+				return { MenuArgs::TYPE::kNumber, static_cast<double>(a_value.GetUInt()), {} };
+			case RE::Scaleform::GFx::Value::ValueType::kNumber:
+				return { MenuArgs::TYPE::kNumber, a_value.GetNumber(), {} };
+			case RE::Scaleform::GFx::Value::ValueType::kString:
+				return { MenuArgs::TYPE::kString, 0.0, a_value.GetString() };
+			case RE::Scaleform::GFx::Value::ValueType::kUndefined:
+				return {};
+			default:
+				return { MenuArgs::TYPE::kOther, 0.0, {} };
+			}
+		}
+
+		std::array<MenuArgs::Value, MenuArgs::kMaxArgs> values;
+		std::size_t                                     count;
+	};
+
+	class SetPositionHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			std::optional<MenuArgs::AxisValue> axisValue = MenuArgs::ParseSetPosition(Args(a_params).Get());
+			if (!axisValue) {
+				logger::warn("SetPosition: Invalid arguments");
+				return;
+			}
+
+			Positioners::SetOffset(axisValue->axis, axisValue->value);
+		}
+	};
+
+	// SetOffsets(x, y, z): 세 축을 한 번의 적용과 저장으로 모두 바꿈
+	class SetOffsetsHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			std::optional<Vector3> offset = MenuArgs::ParseSetOffsets(Args(a_params).Get());
+			if (!offset) {
+				logger::warn("SetOffsets: Invalid arguments");
+				return;
+			}
+
+			RE::NiPoint3 applied;
+			if (Positioners::SetOffsets(Utils::ToNiPoint3(*offset), applied)) {
+				UpdateMenu(applied);
+			}
+		}
+	};
+
+	// NudgeOffset(axis, delta): 한 축을 fNudgeStep 단위로 delta만큼 움직임
+	class NudgeOffsetHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			std::optional<MenuArgs::AxisValue> nudge = MenuArgs::ParseNudgeOffset(Args(a_params).Get());
+			if (!nudge) {
+				logger::warn("NudgeOffset: Invalid arguments");
+				return;
+			}
+
+			RE::NiPoint3 applied;
+			if (Positioners::NudgeOffset(nudge->axis, nudge->value, applied)) {
+				UpdateMenu(applied);
+			}
+		}
+	};
+
+	class SetActiveAxisHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params& a_params) override {
+			Movements::SetActiveAxis(MenuArgs::ParseActiveAxis(Args(a_params).Get()));
+		}
+	};
+
+	class ClearPositionHandler : public RE::Scaleform::GFx::FunctionHandler {
+	public:
+		virtual void Call(const Params&) override {
+			Positioners::ClearOffset();
+		}
+	};
+
+	void RegisterMenu() {
+		RE::UI* ui = RE::UI::GetSingleton();
+		if (!ui) {
+			logger::critical("Menu Registration Failed");
+			return;
+		}
+
+		ui->RegisterMenu(MenuName, [](const RE::UIMessage&) -> RE::IMenu* {
+			PositionerMenu* positioner = PositionerMenu::GetSingleton();
+			if (!positioner) {
+				positioner = new PositionerMenu();
+			}
+			return positioner;
+		});
+
+		logger::info("Menu Registered");
+	}
+
+	void LoadLocalizations() {
+		Localizations& loc = Localizations::GetSingleton();
+
+		loc.lang = "en";	// Default sLanguage
+		RE::INISettingCollection* iniSettings = RE::INISettingCollection::GetSingleton();
+		if (iniSettings) {
+			for (RE::Setting* set : iniSettings->settings) {
+				if (set->GetKey() == "sLanguage:General"sv) {
+					loc.lang = set->GetString();
+					break;
+				}
+			}
+		}
+
+		std::string transPath = fmt::format("Data\\Interface\\Translations\\{}_{}.txt", MenuName, loc.lang);
+		std::string buffer;
+		if (!Tokenizer::ReadFile(transPath, buffer)) {
+			bool found = false;
+
+			if (loc.lang != "en") {
+				logger::warn("Cannot open the translation file: {}", transPath);
+
+				transPath = fmt::format("Data\\Interface\\Translations\\{}_en.txt", MenuName);
+				if (Tokenizer::ReadFile(transPath, buffer)) {
+					found = true;
+				}
+			}
+
+			if (!found) {
+				logger::warn("Cannot find the translation file: {}", transPath);
+				return;
+			}
+		}
+
+		Tokenizer::LineReader reader(buffer);
+		std::string_view line;
+		while (reader.Next(line)) {
+			line = Tokenizer::Trim(line);
+			if (line.empty() || line.starts_with('#')) {
+				continue;
+			}
+
+			std::size_t index = 0;
+
+			std::string_view name = Tokenizer::GetNextData(line, index, '\t');
+			if (name.empty()) {
+				logger::warn(FMT_STRING("Cannot read the name: {}"), line);
+				continue;
+			}
+
+			std::string_view value = Tokenizer::GetNextData(line, index, 0);
+			if (value.empty()) {
+				logger::warn(FMT_STRING("Cannot read the value: {}"), line);
+				continue;
+			}
+
+			loc.translationsMap.emplace(name, value);
+		}
+	}
+
+	void RegisterFunction(RE::Scaleform::GFx::Movie* a_view, RE::Scaleform::GFx::Value* a_f4se_root, RE::Scaleform::GFx::FunctionHandler* a_handler, F4SE::stl::zstring a_name) {
+		RE::Scaleform::GFx::Value fn;
+		a_view->CreateFunction(&fn, a_handler);
+		a_f4se_root->SetMember(a_name, fn);
+	}
+
+	void RegisterFunctions(RE::Scaleform::GFx::Movie* a_view, RE::Scaleform::GFx::Value* a_f4se_root) {
+		RegisterFunction(a_view, a_f4se_root, new ThrowHandler(), "Throw"sv);
+		RegisterFunction(a_view, a_f4se_root, new CloseHandler(), "Close"sv);
+		RegisterFunction(a_view, a_f4se_root, new GetInitializationDataHandler(), "GetInitializationData"sv);
+		RegisterFunction(a_view, a_f4se_root, new InitializationCompleteHandler(), "InitializationComplete"sv);
+		RegisterFunction(a_view, a_f4se_root, new UpdateSettingsHandler(), "UpdateSettings"sv);
+		RegisterFunction(a_view, a_f4se_root, new SetPositionHandler(), "SetPosition"sv);
+		RegisterFunction(a_view, a_f4se_root, new SetOffsetsHandler(), "SetOffsets"sv);
+		RegisterFunction(a_view, a_f4se_root, new NudgeOffsetHandler(), "NudgeOffset"sv);
+		RegisterFunction(a_view, a_f4se_root, new ClearPositionHandler(), "ClearPosition"sv);
+		RegisterFunction(a_view, a_f4se_root, new SetActiveAxisHandler(), "SetActiveAxis"sv);
+	}
+
+	void OpenMenu(RE::NiPoint3& a_offset) {
+		g_offset = a_offset;
+
+		Inputs::BlockPlayerControls(true);
+		Inputs::EnableMenuControls(false);
+		Inputs::SetInputEnableLayer();
+
+		RE::UIMessageQueue* uiMessageQueue = RE::UIMessageQueue::GetSingleton();
+		if (uiMessageQueue) {
+			uiMessageQueue->AddMessage(MenuName, RE::UI_MESSAGE_TYPE::kShow);
+		}
+	}
+
+	void UpdateMenu(RE::NiPoint3& a_offset) {
+		if (!IsMenuOpen()) {
+			return;
+		}
+
+		g_offset = a_offset;
+
+		PositionerMenu* positioner = PositionerMenu::GetSingleton();
+		if (!positioner) {
+			return;
+		}
+
+		RE::Scaleform::GFx::ASMovieRootBase* movieRoot = positioner->uiMovie->asMovieRoot.get();
+		RE::Scaleform::GFx::Value root;
+		if (!movieRoot || !movieRoot->GetVariable(&root, "root")) {
+			logger::critical("UpdateMenu: Couldn't get a root");
+			return;
+		}
+
+		RE::Scaleform::GFx::Value offset[3];
+		offset[0] = g_offset.x;
+		offset[1] = g_offset.y;
+		offset[2] = g_offset.z;
+
+		root.Invoke("UpdateOffset", nullptr, offset, 3);
+	}
+
+	void CloseMenu() {
+		Movements::Reset();
+		if (Movements::ConsumePendingSave()) {
+			Positioners::SaveOffset();
+		}
+
+		Inputs::BlockPlayerControls(false);
+		Inputs::EnableMenuControls(true);
+		Inputs::ResetInputEnableLayer();
+
+		RE::UIMessageQueue* uiMessageQueue = RE::UIMessageQueue::GetSingleton();
+		if (uiMessageQueue) {
+			uiMessageQueue->AddMessage(MenuName, RE::UI_MESSAGE_TYPE::kHide);
+		}
+	}
+
+	bool IsMenuOpen() {
+		RE::UI* ui = RE::UI::GetSingleton();
+		return ui && ui->GetMenuOpen(MenuName);
+	}
+}
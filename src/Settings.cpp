@@ -0,0 +1,119 @@
+#include "Settings.h"
+
+#include <Windows.h>
+
+#include "Core/Tokenizer.h"
+
+namespace Settings {
+	RawValues g_lastValues;
+	std::filesystem::file_time_type g_lastWriteTime;
+	std::jthread g_watcher;
+
+	const std::string& GetConfigPath() {
+		static const std::string configPath = fmt::format("Data\\MCM\\Settings\\{}.ini", Version::PROJECT);
+		return configPath;
+	}
+
+	std::optional<std::filesystem::file_time_type> GetLastWriteTime() {
+		std::error_code ec;
+		auto writeTime = std::filesystem::last_write_time(GetConfigPath(), ec);
+		if (ec) {
+			return std::nullopt;
+		}
+		return writeTime;
+	}
+
+	// Reads the values before the logger exists so that the log options can be honored, Load logs them later
+	void Preload() {
+		std::string content;
+		if (Tokenizer::ReadFile(GetConfigPath(), content)) {
+			ApplyValues(ParseINI(content));
+		}
+	}
+
+	void Load() {
+		std::string content;
+		if (!Tokenizer::ReadFile(GetConfigPath(), content)) {
+			logger::warn("Cannot open the settings file: {}", GetConfigPath());
+			return;
+		}
+
+		g_lastWriteTime = GetLastWriteTime().value_or(std::filesystem::file_time_type{});
+		g_lastValues = ParseINI(content);
+		ApplyValues(g_lastValues);
+
+		for (std::uint32_t ii = 0; ii < static_cast<std::uint32_t>(ID::kTotal); ii++) {
+			LogValue(static_cast<ID>(ii));
+		}
+	}
+
+	// Returns false when a change could not be handed to the main thread yet, the watcher then retries
+	bool Reload() {
+		auto writeTime = GetLastWriteTime();
+		if (!writeTime || *writeTime == g_lastWriteTime) {
+			return true;
+		}
+
+		std::string content;
+		if (!Tokenizer::ReadFile(GetConfigPath(), content)) {
+			return false;
+		}
+
+		RawValues values = ParseINI(content);
+		std::vector<ID> changed = DiffValues(g_lastValues, values);
+		if (!changed.empty()) {
+			// Change callbacks expect to run on the main thread, so the changed values are applied there
+			const F4SE::TaskInterface* task = F4SE::GetTaskInterface();
+			if (!task) {
+				return false;
+			}
+
+			task->AddTask([values, changed]() {
+				logger::info("Settings file changed, reloading");
+				ApplyChanges(values, changed);
+
+				for (ID id : changed) {
+					LogValue(id);
+				}
+			});
+		}
+
+		// Only remembered once applied, so a change that could not be queued is not lost
+		g_lastWriteTime = *writeTime;
+		g_lastValues = std::move(values);
+		return true;
+	}
+
+	void StartWatcher() {
+		if (g_watcher.joinable()) {
+			return;
+		}
+
+		g_watcher = std::jthread([](std::stop_token a_token) {
+			std::string configDir = std::filesystem::path(GetConfigPath()).parent_path().string();
+			HANDLE changeHandle = FindFirstChangeNotificationA(configDir.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+			if (changeHandle == INVALID_HANDLE_VALUE) {
+				logger::warn("Cannot watch the settings directory: {}", configDir);
+				return;
+			}
+
+			bool pending = false;
+			while (!a_token.stop_requested()) {
+				if (WaitForSingleObject(changeHandle, 500) != WAIT_OBJECT_0) {
+					if (pending) {
+						pending = !Reload();
+					}
+					continue;
+				}
+
+				pending = !Reload();
+
+				if (!FindNextChangeNotification(changeHandle)) {
+					break;
+				}
+			}
+
+			FindCloseChangeNotification(changeHandle);
+		});
+	}
+}
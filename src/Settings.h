@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Core/SettingsRegistry.h"
+
+namespace Settings {
+	void Preload();
+	void Load();
+	void StartWatcher();
+}
@@ -0,0 +1,160 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/Async.h"
+
+namespace {
+	// Stand-in for the game's task queue, drained by the test thread like the main thread drains F4SE tasks
+	class ManualExecutor : public Async::Executor {
+	public:
+		void Post(std::function<void()> a_work) override {
+			std::lock_guard guard(lock);
+			queue.push_back(std::move(a_work));
+		}
+
+		std::size_t Drain() {
+			std::size_t count = 0;
+			for (;;) {
+				std::function<void()> work;
+				{
+					std::lock_guard guard(lock);
+					if (queue.empty()) {
+						return count;
+					}
+					work = std::move(queue.front());
+					queue.pop_front();
+				}
+				work();
+				count++;
+			}
+		}
+
+	private:
+		std::mutex                        lock;
+		std::deque<std::function<void()>> queue;
+	};
+
+	struct Event {
+		std::uint32_t scene;
+		std::uint32_t sequence;
+	};
+
+	// Same shape as RunAnimationChange: load on the I/O executor, apply on the main executor unless a game load bumped the epoch
+	Async::Task RunEvent(Async::Executor& a_io, Async::Executor& a_main, const std::atomic<std::uint32_t>& a_epoch, std::uint32_t a_queuedEpoch, Event a_event,
+		std::chrono::microseconds a_loadTime, std::vector<Event>& a_applied) {
+		co_await Async::ResumeOn{ a_io };
+		std::this_thread::sleep_for(a_loadTime);
+
+		co_await Async::ResumeOn{ a_main };
+		if (a_queuedEpoch == a_epoch) {
+			a_applied.push_back(a_event);
+		}
+	}
+}
+
+TEST(Async, ThreadExecutorRunsInOrderOnOneThread) {
+	std::vector<std::uint32_t> order;
+	std::vector<std::thread::id> threads;
+	{
+		Async::ThreadExecutor executor;
+		for (std::uint32_t ii = 0; ii < 100; ii++) {
+			executor.Post([&, ii]() {
+				order.push_back(ii);
+				threads.push_back(std::this_thread::get_id());
+			});
+		}
+	}
+
+	// Work still queued at destruction ran before the thread exited
+	ASSERT_EQ(order.size(), 100u);
+	for (std::uint32_t ii = 0; ii < 100; ii++) {
+		EXPECT_EQ(order[ii], ii);
+		EXPECT_EQ(threads[ii], threads[0]);
+	}
+	EXPECT_NE(threads[0], std::this_thread::get_id());
+}
+
+TEST(Async, EventsKeepTheirOrderWithinEachScene) {
+	ManualExecutor main;
+	std::atomic<std::uint32_t> epoch = 0;
+	std::vector<Event> applied;
+	std::map<std::uint32_t, std::uint32_t> issued;
+	{
+		Async::ThreadExecutor io;
+
+		// Interleave scenes with uneven load times, a slow load must not let a later event of its scene overtake it
+		for (std::uint32_t ii = 0; ii < 200; ii++) {
+			std::uint32_t scene = (ii * 7) % 5;
+			RunEvent(io, main, epoch, epoch, Event{ scene, issued[scene]++ }, std::chrono::microseconds((ii * 13) % 50), applied);
+			if (ii % 17 == 0) {
+				main.Drain();
+			}
+		}
+	}
+	main.Drain();
+
+	ASSERT_EQ(applied.size(), 200u);
+	std::map<std::uint32_t, std::uint32_t> next;
+	for (const auto& event : applied) {
+		EXPECT_EQ(event.sequence, next[event.scene]++) << "scene " << event.scene;
+	}
+}
+
+TEST(Async, EventsFromAnEarlierEpochAreDropped) {
+	ManualExecutor main;
+	std::atomic<std::uint32_t> epoch = 0;
+	std::vector<Event> applied;
+	{
+		Async::ThreadExecutor io;
+		for (std::uint32_t ii = 0; ii < 10; ii++) {
+			RunEvent(io, main, epoch, epoch, Event{ 1, ii }, std::chrono::microseconds(0), applied);
+		}
+
+		// A game load while the events are in flight
+		epoch++;
+		for (std::uint32_t ii = 0; ii < 3; ii++) {
+			RunEvent(io, main, epoch, epoch, Event{ 2, ii }, std::chrono::microseconds(0), applied);
+		}
+	}
+	main.Drain();
+
+	ASSERT_EQ(applied.size(), 3u);
+	for (std::uint32_t ii = 0; ii < 3; ii++) {
+		EXPECT_EQ(applied[ii].scene, 2u);
+		EXPECT_EQ(applied[ii].sequence, ii);
+	}
+}
+
+TEST(Async, TheCallingThreadDoesNotWaitForTheLoad) {
+	ManualExecutor main;
+	std::atomic<std::uint32_t> epoch = 0;
+	std::vector<Event> applied;
+	std::atomic<bool> release = false;
+	{
+		Async::ThreadExecutor io;
+
+		// Block the I/O thread, the event must still return to the caller at once
+		io.Post([&]() {
+			while (!release) {
+				std::this_thread::yield();
+			}
+		});
+		RunEvent(io, main, epoch, epoch, Event{ 1, 0 }, std::chrono::microseconds(0), applied);
+
+		EXPECT_EQ(main.Drain(), 0u);
+		EXPECT_TRUE(applied.empty());
+		release = true;
+	}
+
+	EXPECT_EQ(main.Drain(), 1u);
+	EXPECT_EQ(applied.size(), 1u);
+}
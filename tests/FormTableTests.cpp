@@ -0,0 +1,88 @@
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "Core/FormTable.h"
+
+using namespace std::literals;
+
+namespace {
+	struct Form {
+		std::uint32_t formID;
+	};
+
+	// Stands in for TESDataHandler::LookupForm and counts the lookups
+	struct DataHandler {
+		std::map<std::pair<std::string, std::uint32_t>, Form> forms;
+		std::uint32_t lookups = 0;
+
+		Form* LookupForm(std::uint32_t a_formID, std::string_view a_pluginName) {
+			lookups++;
+			auto it = forms.find({ std::string(a_pluginName), a_formID });
+			return it != forms.end() ? &it->second : nullptr;
+		}
+	};
+
+	constexpr std::array<FormTable::Identifier, 3> kIdentifiers{
+		FormTable::Identifier{ "AAFDynamicPositioner.esp"sv, 0x810 },
+		FormTable::Identifier{ "AAFDynamicPositioner.esp"sv, 0x811 },
+		FormTable::Identifier{ "Missing.esp"sv, 0x812 },
+	};
+}
+
+TEST(FormTable, ParsesHexFormIDs) {
+	EXPECT_EQ(FormTable::ParseFormID("810"sv), 0x810u);
+	EXPECT_EQ(FormTable::ParseFormID("0x810"sv), 0x810u);
+	EXPECT_EQ(FormTable::ParseFormID("0X00000aBc"sv), 0xABCu);
+	EXPECT_EQ(FormTable::ParseFormID("FE000810"sv), 0x810u);
+}
+
+TEST(FormTable, MalformedFormIDsAreZero) {
+	EXPECT_EQ(FormTable::ParseFormID(""sv), 0u);
+	EXPECT_EQ(FormTable::ParseFormID("0x"sv), 0u);
+	EXPECT_EQ(FormTable::ParseFormID("xyz"sv), 0u);
+	EXPECT_EQ(FormTable::ParseFormID("-810"sv), 0u);
+	EXPECT_EQ(FormTable::ParseFormID("1FFFFFFFF"sv), 0u);
+}
+
+TEST(FormTable, ResolvesEveryFormInOnePass) {
+	DataHandler handler;
+	handler.forms[{ "AAFDynamicPositioner.esp", 0x810 }] = Form{ 0x810 };
+	handler.forms[{ "AAFDynamicPositioner.esp", 0x811 }] = Form{ 0x811 };
+
+	FormTable::Table<Form, kIdentifiers.size()> table(kIdentifiers);
+	EXPECT_FALSE(table.IsResolved());
+	EXPECT_EQ(table.Get(0), nullptr);
+
+	EXPECT_EQ(table.Resolve([&](std::uint32_t a_formID, std::string_view a_pluginName) { return handler.LookupForm(a_formID, a_pluginName); }), 1u);
+	EXPECT_TRUE(table.IsResolved());
+	EXPECT_EQ(handler.lookups, 3u);
+
+	ASSERT_NE(table.Get(0), nullptr);
+	EXPECT_EQ(table.Get(0)->formID, 0x810u);
+	ASSERT_NE(table.Get(1), nullptr);
+	EXPECT_EQ(table.Get(1)->formID, 0x811u);
+	EXPECT_EQ(table.Get(2), nullptr);
+	EXPECT_EQ(table.Get(3), nullptr);
+
+	// Reads after resolution never touch the data handler
+	for (int ii = 0; ii < 100; ii++) {
+		table.Get(ii % 3);
+	}
+	EXPECT_EQ(handler.lookups, 3u);
+}
+
+TEST(FormTable, ResolvingAgainPicksUpNewForms) {
+	DataHandler handler;
+	FormTable::Table<Form, kIdentifiers.size()> table(kIdentifiers);
+	auto lookup = [&](std::uint32_t a_formID, std::string_view a_pluginName) { return handler.LookupForm(a_formID, a_pluginName); };
+
+	EXPECT_EQ(table.Resolve(lookup), 3u);
+	handler.forms[{ "Missing.esp", 0x812 }] = Form{ 0x812 };
+	EXPECT_EQ(table.Resolve(lookup), 2u);
+	ASSERT_NE(table.Get(2), nullptr);
+	EXPECT_EQ(table.Get(2)->formID, 0x812u);
+}
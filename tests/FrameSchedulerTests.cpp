@@ -0,0 +1,164 @@
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/FrameScheduler.h"
+#include "bench/Corpus.h"
+
+namespace {
+	std::optional<float> GetKeyPriority(std::uint64_t a_key) {
+		return static_cast<float>(a_key);
+	}
+
+	// Stand-in for the scenes of a settlement, the player's scene is key 0 and ranks first like in GetScenePriority
+	struct Scene {
+		float x;
+		float y;
+		int   applied = 0;
+	};
+
+	std::optional<float> GetScenePriority(const std::vector<Scene>& a_scenes, std::uint64_t a_key, float a_lodDistance) {
+		if (a_key == 0) {
+			return -1.0f;
+		}
+
+		const Scene& scene = a_scenes[a_key];
+		float distanceSq = scene.x * scene.x + scene.y * scene.y;
+		if (distanceSq > a_lodDistance * a_lodDistance) {
+			return std::nullopt;
+		}
+		return distanceSq;
+	}
+}
+
+TEST(FrameScheduler, NewerWorkReplacesOlderWorkOfTheSameKey) {
+	FrameScheduler::Scheduler scheduler;
+	std::vector<int> ran;
+	scheduler.Submit(1, [&]() { ran.push_back(1); });
+	scheduler.Submit(1, [&]() { ran.push_back(2); });
+	scheduler.Submit(2, [&]() { ran.push_back(3); });
+	EXPECT_EQ(scheduler.GetCount(), 2u);
+
+	EXPECT_EQ(scheduler.Run(0, GetKeyPriority), 2u);
+	EXPECT_EQ(ran, (std::vector<int>{ 2, 3 }));
+	EXPECT_TRUE(scheduler.IsEmpty());
+}
+
+TEST(FrameScheduler, CancelAndClear) {
+	FrameScheduler::Scheduler scheduler;
+	int ran = 0;
+	for (std::uint64_t key = 0; key < 5; key++) {
+		scheduler.Submit(key, [&]() { ran++; });
+	}
+
+	scheduler.Cancel(2);
+	scheduler.Cancel(42);
+	EXPECT_EQ(scheduler.GetCount(), 4u);
+	EXPECT_EQ(scheduler.Run(0, GetKeyPriority), 4u);
+	EXPECT_EQ(ran, 4);
+
+	scheduler.Submit(1, [&]() { ran++; });
+	scheduler.Clear();
+	EXPECT_EQ(scheduler.Run(0, GetKeyPriority), 0u);
+	EXPECT_EQ(ran, 4);
+}
+
+TEST(FrameScheduler, LowerPriorityRunsFirstAndNulloptDefers) {
+	FrameScheduler::Scheduler scheduler;
+	std::vector<std::uint64_t> ran;
+	for (std::uint64_t key : { 5, 3, 9, 1, 7 }) {
+		scheduler.Submit(key, [&ran, key]() { ran.push_back(key); });
+	}
+
+	// Odd keys above 4 are out of range this frame
+	auto getPriority = [](std::uint64_t a_key) -> std::optional<float> {
+		if (a_key > 4) {
+			return std::nullopt;
+		}
+		return static_cast<float>(a_key);
+	};
+	EXPECT_EQ(scheduler.Run(0, getPriority), 2u);
+	EXPECT_EQ(ran, (std::vector<std::uint64_t>{ 1, 3 }));
+	EXPECT_EQ(scheduler.GetCount(), 3u);
+
+	// Deferred jobs run once they come into range
+	EXPECT_EQ(scheduler.Run(0, GetKeyPriority), 3u);
+	EXPECT_EQ(ran, (std::vector<std::uint64_t>{ 1, 3, 5, 7, 9 }));
+}
+
+TEST(FrameScheduler, BudgetStopsTheFrameButOneJobAlwaysRuns) {
+	FrameScheduler::Scheduler scheduler;
+	int ran = 0;
+	for (std::uint64_t key = 0; key < 4; key++) {
+		scheduler.Submit(key, [&]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			ran++;
+		});
+	}
+
+	// A budget smaller than one job still makes progress
+	EXPECT_EQ(scheduler.Run(1, GetKeyPriority), 1u);
+	EXPECT_EQ(ran, 1);
+	EXPECT_EQ(scheduler.GetCount(), 3u);
+
+	EXPECT_EQ(scheduler.Run(0, GetKeyPriority), 3u);
+	EXPECT_EQ(ran, 4);
+}
+
+TEST(FrameScheduler, JobsMaySubmitAndCancelWhileRunning) {
+	FrameScheduler::Scheduler scheduler;
+	std::vector<std::uint64_t> ran;
+	scheduler.Submit(1, [&]() {
+		ran.push_back(1);
+		scheduler.Cancel(2);
+		scheduler.Submit(1, [&]() { ran.push_back(10); });
+	});
+	scheduler.Submit(2, [&]() { ran.push_back(2); });
+
+	EXPECT_EQ(scheduler.Run(0, GetKeyPriority), 1u);
+	EXPECT_EQ(ran, (std::vector<std::uint64_t>{ 1 }));
+	EXPECT_EQ(scheduler.Run(0, GetKeyPriority), 1u);
+	EXPECT_EQ(ran, (std::vector<std::uint64_t>{ 1, 10 }));
+}
+
+TEST(FrameScheduler, HundredsOfScenesReachEveryInRangeScene) {
+	constexpr float kLODDistance = 4000.0f;
+	Corpus::Random random(3);
+
+	std::vector<Scene> scenes(400);
+	for (auto& scene : scenes) {
+		scene.x = random.Next(-8000.0f, 8000.0f);
+		scene.y = random.Next(-8000.0f, 8000.0f);
+	}
+	scenes[0] = { 0.0f, 0.0f };
+
+	FrameScheduler::Scheduler scheduler;
+	auto getPriority = [&](std::uint64_t a_key) { return GetScenePriority(scenes, a_key, kLODDistance); };
+
+	// Every scene changes animation at once, two jobs fit into each frame
+	for (std::uint64_t key = 0; key < scenes.size(); key++) {
+		scheduler.Submit(key, [&scenes, key]() {
+			std::this_thread::sleep_for(std::chrono::microseconds(300));
+			scenes[key].applied++;
+		});
+	}
+
+	EXPECT_GE(scheduler.Run(500, getPriority), 1u);
+	EXPECT_EQ(scenes[0].applied, 1);
+
+	while (scheduler.Run(500, getPriority) > 0) {}
+
+	for (std::uint64_t key = 1; key < scenes.size(); key++) {
+		bool inRange = GetScenePriority(scenes, key, kLODDistance).has_value();
+		EXPECT_EQ(scenes[key].applied, inRange ? 1 : 0) << key;
+	}
+
+	// Out of range scenes stay queued until the player comes closer
+	std::size_t deferred = scheduler.GetCount();
+	EXPECT_GT(deferred, 0u);
+	EXPECT_EQ(scheduler.Run(0, [&](std::uint64_t a_key) { return GetScenePriority(scenes, a_key, 1e9f); }), deferred);
+}
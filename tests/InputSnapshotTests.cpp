@@ -0,0 +1,123 @@
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/InputSnapshot.h"
+
+namespace {
+	// Stand-in for BSInputEventUser, the snapshot only touches this flag
+	struct Handler {
+		bool inputEventHandlingEnabled = true;
+	};
+
+	using Snapshot = InputSnapshot::Snapshot<Handler>;
+
+	// The engine's MenuControls list: a few handlers of its own before the ones mods add
+	class InputSnapshotTest : public ::testing::Test {
+	protected:
+		static constexpr std::size_t kFirst = 2;
+
+		void SetUp() override {
+			for (bool enabled : { true, true, true, false, true, false }) {
+				Add(enabled);
+			}
+		}
+
+		Handler* Add(bool a_enabled) {
+			owned.push_back(std::make_unique<Handler>());
+			owned.back()->inputEventHandlingEnabled = a_enabled;
+			handlers.push_back(owned.back().get());
+			return owned.back().get();
+		}
+
+		std::vector<bool> GetStates() const {
+			std::vector<bool> result;
+			for (const auto* handler : handlers) {
+				result.push_back(handler && handler->inputEventHandlingEnabled);
+			}
+			return result;
+		}
+
+		std::vector<std::unique_ptr<Handler>> owned;
+		std::vector<Handler*>                 handlers;
+		Snapshot                              snapshot;
+	};
+}
+
+TEST_F(InputSnapshotTest, DisableAndRestoreFromTheFirstHandler) {
+	auto before = GetStates();
+
+	snapshot.Disable(handlers, kFirst);
+	EXPECT_TRUE(snapshot.IsActive());
+	EXPECT_EQ(snapshot.GetCount(), handlers.size() - kFirst);
+	// The engine's own handlers keep working
+	EXPECT_EQ(GetStates(), (std::vector<bool>{ true, true, false, false, false, false }));
+
+	snapshot.Restore(handlers, kFirst);
+	EXPECT_FALSE(snapshot.IsActive());
+	EXPECT_EQ(GetStates(), before);
+}
+
+TEST_F(InputSnapshotTest, TakingOverTwiceKeepsTheFirstRecord) {
+	auto before = GetStates();
+
+	snapshot.Disable(handlers, kFirst);
+	snapshot.Disable(handlers, kFirst);
+	snapshot.Restore(handlers, kFirst);
+	EXPECT_EQ(GetStates(), before);
+
+	// Restoring again without a take over leaves the handlers alone
+	handlers[2]->inputEventHandlingEnabled = false;
+	snapshot.Restore(handlers, kFirst);
+	EXPECT_FALSE(handlers[2]->inputEventHandlingEnabled);
+}
+
+TEST_F(InputSnapshotTest, ListChangedWhileDisabled) {
+	handlers.push_back(nullptr);
+	auto before = GetStates();
+	snapshot.Disable(handlers, kFirst);
+
+	// A mod registers a handler in the middle and the list shifts
+	Handler* added = Add(true);
+	handlers.pop_back();
+	handlers.insert(handlers.begin() + 3, added);
+
+	// The new handler keeps its own state and the shifted ones are found by search
+	snapshot.Restore(handlers, kFirst);
+	EXPECT_TRUE(added->inputEventHandlingEnabled);
+	EXPECT_EQ(handlers[2]->inputEventHandlingEnabled, before[2]);
+	EXPECT_EQ(handlers[4]->inputEventHandlingEnabled, before[3]);
+	EXPECT_EQ(handlers[5]->inputEventHandlingEnabled, before[4]);
+	EXPECT_EQ(handlers[6]->inputEventHandlingEnabled, before[5]);
+}
+
+TEST_F(InputSnapshotTest, RemovedHandlersAreSkipped) {
+	auto before = GetStates();
+	snapshot.Disable(handlers, kFirst);
+
+	Handler* removed = handlers[3];
+	handlers.erase(handlers.begin() + 3);
+
+	snapshot.Restore(handlers, kFirst);
+	EXPECT_FALSE(removed->inputEventHandlingEnabled);
+	EXPECT_EQ(handlers[3]->inputEventHandlingEnabled, before[4]);
+	EXPECT_EQ(handlers[4]->inputEventHandlingEnabled, before[5]);
+}
+
+TEST_F(InputSnapshotTest, RepeatedMenusRestoreTheSameStates) {
+	auto before = GetStates();
+	for (int ii = 0; ii < 1000; ii++) {
+		snapshot.Disable(handlers, kFirst);
+		ASSERT_EQ(snapshot.GetCount(), handlers.size() - kFirst);
+		snapshot.Restore(handlers, kFirst);
+		ASSERT_EQ(GetStates(), before) << ii;
+	}
+
+	// A list shorter than the engine's own handlers has nothing to take over
+	Snapshot empty;
+	std::vector<Handler*> few(handlers.begin(), handlers.begin() + 1);
+	empty.Disable(few, kFirst);
+	EXPECT_EQ(empty.GetCount(), 0u);
+	EXPECT_TRUE(few[0]->inputEventHandlingEnabled);
+}
@@ -0,0 +1,209 @@
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include "Core/Logging.h"
+
+namespace {
+	// Collects the lines that reach the end of the sink chain, optionally holding the writer until released
+	class CaptureSink : public spdlog::sinks::base_sink<std::mutex> {
+	public:
+		std::vector<std::string> GetLines() {
+			std::lock_guard guard(mutex_);
+			return lines;
+		}
+
+		void Hold() { held = true; }
+		void Release() { held = false; }
+
+	protected:
+		void sink_it_(const spdlog::details::log_msg& a_msg) override {
+			while (held) {
+				std::this_thread::yield();
+			}
+			lines.emplace_back(a_msg.payload.data(), a_msg.payload.size());
+		}
+
+		void flush_() override {}
+
+	private:
+		std::vector<std::string> lines;
+		std::atomic<bool>        held = false;
+	};
+
+	Logging::Options GetPlainOptions() {
+		Logging::Options options;
+		options.duplicateWindow = std::chrono::milliseconds(0);
+		return options;
+	}
+
+	// The background thread writes on its own schedule, so wait until the expected line arrived
+	bool WaitForLine(CaptureSink& a_sink, const std::string& a_line) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (std::chrono::steady_clock::now() < deadline) {
+			auto lines = a_sink.GetLines();
+			if (!lines.empty() && lines.back() == a_line) {
+				return true;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return false;
+	}
+}
+
+TEST(Logging, SyncLoggerWritesEveryLine) {
+	auto sink = std::make_shared<CaptureSink>();
+	auto log = Logging::CreateLogger("test", sink, GetPlainOptions());
+
+	log->info("one");
+	log->info("one");
+	log->warn("two {}", 2);
+
+	std::vector<std::string> expected{ "one", "one", "two 2" };
+	EXPECT_EQ(sink->GetLines(), expected);
+}
+
+TEST(Logging, DuplicatesAreCollapsed) {
+	auto sink = std::make_shared<CaptureSink>();
+	auto log = Logging::CreateLogger("test", sink, Logging::Options{});
+
+	for (int ii = 0; ii < 5; ii++) {
+		log->info("same");
+	}
+	log->info("other");
+
+	auto lines = sink->GetLines();
+	ASSERT_EQ(lines.size(), 3u);
+	EXPECT_EQ(lines[0], "same");
+	EXPECT_EQ(lines[1], "Skipped 4 duplicate messages..");
+	EXPECT_EQ(lines[2], "other");
+}
+
+TEST(Logging, RateLimitDropsAndReports) {
+	auto sink = std::make_shared<CaptureSink>();
+	auto options = GetPlainOptions();
+	options.rateLimit = 10;
+	auto log = Logging::CreateLogger("test", sink, options);
+
+	// Critical lines pass the limit
+	for (int ii = 0; ii < 50; ii++) {
+		log->info("line {}", ii);
+	}
+	log->critical("critical");
+	auto lines = sink->GetLines();
+	ASSERT_EQ(lines.size(), 11u);
+	EXPECT_EQ(lines[9], "line 9");
+	EXPECT_EQ(lines[10], "critical");
+
+	// The first line of the next second reports what was dropped
+	std::this_thread::sleep_for(std::chrono::milliseconds(1050));
+	log->info("next");
+	lines = sink->GetLines();
+	ASSERT_EQ(lines.size(), 13u);
+	EXPECT_EQ(lines[11], "Dropped 40 log lines over the rate limit");
+	EXPECT_EQ(lines[12], "next");
+}
+
+TEST(Logging, AsyncLoggerKeepsOrder) {
+	auto sink = std::make_shared<CaptureSink>();
+	auto options = GetPlainOptions();
+	options.async = true;
+	auto log = Logging::CreateLogger("test", sink, options);
+
+	for (int ii = 0; ii < 1000; ii++) {
+		log->info("line {}", ii);
+	}
+	ASSERT_TRUE(WaitForLine(*sink, "line 999"));
+
+	auto lines = sink->GetLines();
+	ASSERT_EQ(lines.size(), 1000u);
+	for (std::size_t ii = 0; ii < lines.size(); ii++) {
+		EXPECT_EQ(lines[ii], "line " + std::to_string(ii));
+	}
+}
+
+TEST(Logging, FullAsyncQueueDropsTheOldestLines) {
+	auto sink = std::make_shared<CaptureSink>();
+	auto options = GetPlainOptions();
+	options.async = true;
+	options.queueSize = 16;
+	auto log = Logging::CreateLogger("test", sink, options);
+
+	// A stalled writer must not stall the caller
+	sink->Hold();
+	auto start = std::chrono::steady_clock::now();
+	for (int ii = 0; ii < 1000; ii++) {
+		log->info("line {}", ii);
+	}
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+	sink->Release();
+	ASSERT_TRUE(WaitForLine(*sink, "line 999"));
+	EXPECT_LE(sink->GetLines().size(), 18u);
+}
+
+TEST(Logging, FlushPendingGivesUpOnAStuckWriter) {
+	auto sink = std::make_shared<CaptureSink>();
+	auto options = GetPlainOptions();
+	options.async = true;
+	auto previous = spdlog::default_logger();
+	spdlog::set_default_logger(Logging::CreateLogger("test", sink, options));
+
+	spdlog::info("written");
+	EXPECT_TRUE(Logging::FlushPending(std::chrono::seconds(5)));
+	EXPECT_EQ(sink->GetLines(), std::vector<std::string>{ "written" });
+
+	// A writer that never returns only costs the timeout, the crash path must not wait for it
+	sink->Hold();
+	spdlog::info("held");
+	auto start = std::chrono::steady_clock::now();
+	EXPECT_FALSE(Logging::FlushPending(std::chrono::milliseconds(50)));
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+	sink->Release();
+	EXPECT_TRUE(WaitForLine(*sink, "held"));
+	spdlog::set_default_logger(std::move(previous));
+}
+
+TEST(LoggingDeathTest, CrashHandlerWritesPendingLines) {
+	::testing::GTEST_FLAG(death_test_style) = "threadsafe";
+
+	// The threadsafe style runs the test again in the child, so the path cannot come from a fresh temporary directory
+	auto path = std::filesystem::temp_directory_path() / "AAFDynamicPositionerTests-crash.log";
+	std::filesystem::remove(path);
+
+	// Info lines are only flushed once a second, the crash comes first
+	EXPECT_DEATH(
+		{
+			auto options = GetPlainOptions();
+			options.async = true;
+			auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path.string(), true);
+			spdlog::set_default_logger(Logging::CreateLogger("test", std::move(sink), options));
+			Logging::InstallCrashHandler(options);
+
+			for (int ii = 0; ii < 100; ii++) {
+				spdlog::info("line {}", ii);
+			}
+			std::terminate();
+		},
+		"");
+
+	std::ifstream file(path);
+	std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	EXPECT_NE(content.find("line 0"), std::string::npos);
+	EXPECT_NE(content.find("line 99"), std::string::npos);
+
+	file.close();
+	std::filesystem::remove(path);
+}
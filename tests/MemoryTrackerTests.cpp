@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstdlib>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <malloc.h>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Core/MemoryTracker.h"
+#include "bench/Corpus.h"
+
+namespace {
+	std::size_t GetBlockSize(void* a_ptr) {
+#ifdef _WIN32
+		return _msize(a_ptr);
+#else
+		return malloc_usable_size(a_ptr);
+#endif
+	}
+
+	// Takes its memory straight from malloc and keeps its own book of every live block, the reference the counters are checked against
+	class RecordingResource : public std::pmr::memory_resource {
+	public:
+		std::size_t GetRequested() const { return requested; }
+		std::size_t GetPeak() const { return peak; }
+		std::size_t GetBlockCount() const { return blocks.size(); }
+		std::uint64_t GetAllocationCount() const { return allocations; }
+
+		// What the heap really holds for the live blocks, including the rounding of the allocator
+		std::size_t GetReal() const {
+			std::size_t result = 0;
+			for (const auto& [ptr, bytes] : blocks) {
+				result += GetBlockSize(ptr);
+			}
+			return result;
+		}
+
+	private:
+		void* do_allocate(std::size_t a_bytes, std::size_t a_alignment) override {
+			EXPECT_LE(a_alignment, alignof(std::max_align_t));
+			void* result = std::malloc(a_bytes);
+			if (!result) {
+				throw std::bad_alloc();
+			}
+
+			blocks.emplace(result, a_bytes);
+			requested += a_bytes;
+			peak = std::max(peak, requested);
+			allocations++;
+			return result;
+		}
+
+		void do_deallocate(void* a_ptr, std::size_t a_bytes, std::size_t) override {
+			auto it = blocks.find(a_ptr);
+			ASSERT_NE(it, blocks.end());
+			EXPECT_EQ(it->second, a_bytes);
+			requested -= it->second;
+			blocks.erase(it);
+			std::free(a_ptr);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& a_other) const noexcept override {
+			return this == &a_other;
+		}
+
+		std::unordered_map<void*, std::size_t> blocks;
+		std::size_t requested = 0;
+		std::size_t peak = 0;
+		std::uint64_t allocations = 0;
+	};
+
+	// The shapes the plugin keeps per category: actors by form ID, scenes with their position and actor list, and translations
+	struct Actor {
+		std::uint64_t sceneID;
+		float         offset[3];
+	};
+
+	// Allocator aware like the plugin's scene data, otherwise the members would allocate outside the map's resource
+	struct Scene {
+		using allocator_type = std::pmr::polymorphic_allocator<>;
+
+		explicit Scene(const allocator_type& a_allocator) : position(a_allocator), actors(a_allocator) {}
+		Scene(const Scene& a_other, const allocator_type& a_allocator) : position(a_other.position, a_allocator), actors(a_other.actors, a_allocator) {}
+
+		std::pmr::string                position;
+		std::pmr::vector<std::uint32_t> actors;
+	};
+}
+
+TEST(MemoryTracker, BudgetsAndPeaks) {
+	auto category = MemoryTracker::CATEGORY::kScenes;
+	EXPECT_EQ(MemoryTracker::GetName(category), "Scenes");
+	EXPECT_EQ(MemoryTracker::GetName(MemoryTracker::CATEGORY::kTotal), "");
+
+	std::size_t before = MemoryTracker::GetUsage(category).current;
+	{
+		std::pmr::vector<char> buffer(4096, 0, MemoryTracker::GetResource(category));
+		EXPECT_EQ(MemoryTracker::GetUsage(category).current, before + 4096);
+
+		MemoryTracker::SetBudget(category, before + 1024);
+		EXPECT_TRUE(MemoryTracker::IsOverBudget(category));
+		MemoryTracker::SetBudget(category, 0);
+		EXPECT_FALSE(MemoryTracker::IsOverBudget(category));
+	}
+
+	EXPECT_EQ(MemoryTracker::GetUsage(category).current, before);
+	EXPECT_GE(MemoryTracker::GetUsage(category).peak, before + 4096);
+	MemoryTracker::ResetPeaks();
+	EXPECT_EQ(MemoryTracker::GetUsage(category).peak, before);
+}
+
+// Four hours of one event a second: scenes start and end, change animations many times, and translations are read again on
+// every menu open. Every ten minutes the counters must equal the bytes really held, and nothing may be left at the end.
+TEST(MemoryTracker, CountersMatchTheHeapOverALongSession) {
+	constexpr std::uint32_t kSeconds = 4 * 60 * 60;
+	constexpr std::size_t   kMallocSlack = 32;
+
+	RecordingResource heap;
+	MemoryTracker::CountingResource actorCounter(&heap);
+	MemoryTracker::CountingResource sceneCounter(&heap);
+	MemoryTracker::CountingResource translationCounter(&heap);
+
+	auto check = [&](std::uint32_t a_second) {
+		std::size_t counted = actorCounter.GetCurrent() + sceneCounter.GetCurrent() + translationCounter.GetCurrent();
+		EXPECT_EQ(counted, heap.GetRequested()) << "second " << a_second;
+		EXPECT_EQ(actorCounter.GetUsage().allocations + sceneCounter.GetUsage().allocations + translationCounter.GetUsage().allocations, heap.GetAllocationCount());
+
+		// The heap rounds every block up a little, but never by more than its headers
+		std::size_t real = heap.GetReal();
+		EXPECT_GE(real, counted);
+		EXPECT_LE(real, counted + heap.GetBlockCount() * kMallocSlack) << "second " << a_second;
+	};
+
+	{
+		std::pmr::unordered_map<std::uint32_t, Actor> actors(&actorCounter);
+		std::pmr::unordered_map<std::uint64_t, Scene> scenes(&sceneCounter);
+		std::pmr::unordered_map<std::pmr::string, std::pmr::string> translations(&translationCounter);
+
+		Corpus::Random random(49);
+		std::uint64_t nextSceneID = 1;
+		std::uint32_t nextFormID = 0x100000;
+		std::size_t maxScenes = 0;
+
+		for (std::uint32_t second = 0; second < kSeconds; second++) {
+			std::uint32_t event = random.Next(100);
+			if (event < 5 && scenes.size() < 40) {
+				std::uint64_t sceneID = nextSceneID++;
+				Scene& scene = scenes.try_emplace(sceneID).first->second;
+				std::uint32_t actorCount = 2 + random.Next(3);
+				for (std::uint32_t ii = 0; ii < actorCount; ii++) {
+					std::uint32_t formID = nextFormID++;
+					scene.actors.push_back(formID);
+					actors.emplace(formID, Actor{ sceneID, { 0.0f, 0.0f, 0.0f } });
+				}
+				maxScenes = std::max(maxScenes, scenes.size());
+			}
+			else if (event < 10 && !scenes.empty()) {
+				auto it = std::next(scenes.begin(), random.Next(static_cast<std::uint32_t>(scenes.size())));
+				for (auto formID : it->second.actors) {
+					actors.erase(formID);
+				}
+				scenes.erase(it);
+			}
+			else if (event < 60 && !scenes.empty()) {
+				// Position names are long enough to leave the small string buffer
+				auto it = std::next(scenes.begin(), random.Next(static_cast<std::uint32_t>(scenes.size())));
+				it->second.position = Corpus::GetPositionName(random.Next(10000)) + "_Stage" + std::to_string(random.Next(20));
+			}
+			else if (event == 99 && random.Next(10) == 0) {
+				translations.clear();
+				std::uint32_t count = 200 + random.Next(100);
+				for (std::uint32_t ii = 0; ii < count; ii++) {
+					translations.emplace(fmt::format("$AAFDynamicPositioner_Translation_Key_{}", ii), fmt::format("Translated text number {} of the menu", ii));
+				}
+			}
+
+			if (second % 600 == 0) {
+				check(second);
+			}
+		}
+
+		check(kSeconds);
+		EXPECT_GT(maxScenes, 10u);
+
+		// The members share the map's resource, so position names and actor lists are counted with their scene
+		for (const auto& [sceneID, scene] : scenes) {
+			EXPECT_EQ(scene.position.get_allocator().resource(), &sceneCounter);
+			EXPECT_EQ(scene.actors.get_allocator().resource(), &sceneCounter);
+		}
+		EXPECT_FALSE(translations.empty());
+	}
+
+	// Every container is gone, so every counted byte must have come back
+	EXPECT_EQ(actorCounter.GetCurrent(), 0u);
+	EXPECT_EQ(sceneCounter.GetCurrent(), 0u);
+	EXPECT_EQ(translationCounter.GetCurrent(), 0u);
+	EXPECT_EQ(heap.GetBlockCount(), 0u);
+	EXPECT_LE(sceneCounter.GetUsage().peak, heap.GetPeak());
+	EXPECT_GE(actorCounter.GetUsage().peak + sceneCounter.GetUsage().peak + translationCounter.GetUsage().peak, heap.GetPeak());
+}
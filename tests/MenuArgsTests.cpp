@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/MenuArgs.h"
+#include "Core/MovementCurve.h"
+
+namespace {
+	using MenuArgs::TYPE;
+	using MenuArgs::Value;
+
+	// Mock of the handler Params: the argument list the menu passed, cut to kMaxArgs like Scaleforms::Args
+	struct Params {
+		std::vector<Value> args;
+
+		std::span<const Value> Get() const { return { args.data(), std::min(args.size(), MenuArgs::kMaxArgs) }; }
+	};
+
+	Value Number(double a_value) {
+		return { TYPE::kNumber, a_value, {} };
+	}
+
+	Value String(std::string_view a_value) {
+		return { TYPE::kString, 0.0, a_value };
+	}
+
+	Value Other() {
+		return { TYPE::kOther, 0.0, {} };
+	}
+
+	constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+	constexpr double kInfinity = std::numeric_limits<double>::infinity();
+}
+
+TEST(MenuArgs, SetOffsetsTakesThreeFiniteNumbers) {
+	auto offset = MenuArgs::ParseSetOffsets(Params{ { Number(1.5), Number(-2.0), Number(30.0) } }.Get());
+	ASSERT_TRUE(offset);
+	EXPECT_EQ(*offset, (Vector3{ 1.5f, -2.0f, 30.0f }));
+
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{}.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{ { Number(1.0), Number(2.0) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{ { Number(1.0), Number(2.0), Number(3.0), Number(4.0) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{ { Number(1.0), String("2"), Number(3.0) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{ { Number(1.0), Number(2.0), Value{} } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{ { Number(kNaN), Number(2.0), Number(3.0) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{ { Number(1.0), Number(-kInfinity), Number(3.0) } }.Get()));
+
+	// Finite doubles past the float range would turn into infinity
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(Params{ { Number(1.0), Number(2.0), Number(1e300) } }.Get()));
+}
+
+TEST(MenuArgs, LongArgumentListsAreRejected) {
+	Params params;
+	for (int ii = 0; ii < 10; ii++) {
+		params.args.push_back(Number(ii));
+	}
+
+	EXPECT_FALSE(MenuArgs::ParseSetOffsets(params.Get()));
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(params.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetPosition(params.Get()));
+}
+
+TEST(MenuArgs, NudgeOffsetTakesAnAxisAndFiniteSteps) {
+	auto nudge = MenuArgs::ParseNudgeOffset(Params{ { String("Y"), Number(-3.0) } }.Get());
+	ASSERT_TRUE(nudge);
+	EXPECT_EQ(nudge->axis, MovementCurve::kAxis_Y);
+	EXPECT_EQ(nudge->value, -3.0f);
+
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(Params{ { String("Y") } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(Params{ { String("W"), Number(1.0) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(Params{ { String("y"), Number(1.0) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(Params{ { Number(0.0), Number(1.0) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(Params{ { String("X"), String("1") } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(Params{ { String("X"), Number(kNaN) } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseNudgeOffset(Params{ { String("X"), Number(kInfinity) } }.Get()));
+}
+
+TEST(MenuArgs, SetPositionTakesAnAxisAndAValue) {
+	auto axisValue = MenuArgs::ParseSetPosition(Params{ { String("Z"), Number(12.5) } }.Get());
+	ASSERT_TRUE(axisValue);
+	EXPECT_EQ(axisValue->axis, MovementCurve::kAxis_Z);
+	EXPECT_EQ(axisValue->value, 12.5f);
+
+	EXPECT_FALSE(MenuArgs::ParseSetPosition(Params{ { String("Z"), Other() } }.Get()));
+	EXPECT_FALSE(MenuArgs::ParseSetPosition(Params{ { String(""), Number(1.0) } }.Get()));
+}
+
+TEST(MenuArgs, ActiveAxisFallsBackToNone) {
+	EXPECT_EQ(MenuArgs::ParseActiveAxis(Params{ { String("X") } }.Get()), MovementCurve::kAxis_X);
+	EXPECT_EQ(MenuArgs::ParseActiveAxis(Params{ { String("Z"), Number(1.0) } }.Get()), MovementCurve::kAxis_Z);
+	EXPECT_EQ(MenuArgs::ParseActiveAxis(Params{}.Get()), MovementCurve::kAxis_None);
+	EXPECT_EQ(MenuArgs::ParseActiveAxis(Params{ { String("XY") } }.Get()), MovementCurve::kAxis_None);
+	EXPECT_EQ(MenuArgs::ParseActiveAxis(Params{ { Number(0.0) } }.Get()), MovementCurve::kAxis_None);
+	EXPECT_EQ(MenuArgs::ParseActiveAxis(Params{ { Value{} } }.Get()), MovementCurve::kAxis_None);
+}
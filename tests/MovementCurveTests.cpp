@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "Core/MovementCurve.h"
+
+namespace {
+	constexpr MovementCurve::Config kConfig{ 5.0f, 20.0f, 40.0f, 0.2f };
+}
+
+TEST(MovementCurve, KeysCancelEachOther) {
+	EXPECT_EQ(MovementCurve::CoalesceInput(false, false, 0.0f, 0.2f), 0.0f);
+	EXPECT_EQ(MovementCurve::CoalesceInput(false, true, 0.0f, 0.2f), 1.0f);
+	EXPECT_EQ(MovementCurve::CoalesceInput(true, false, 0.0f, 0.2f), -1.0f);
+	EXPECT_EQ(MovementCurve::CoalesceInput(true, true, 0.0f, 0.2f), 0.0f);
+}
+
+TEST(MovementCurve, StickIsRescaledPastTheDeadzone) {
+	EXPECT_EQ(MovementCurve::CoalesceInput(false, false, 0.2f, 0.2f), 0.0f);
+	EXPECT_EQ(MovementCurve::CoalesceInput(false, false, -0.1f, 0.2f), 0.0f);
+	EXPECT_FLOAT_EQ(MovementCurve::CoalesceInput(false, false, 0.6f, 0.2f), 0.25f);
+	EXPECT_FLOAT_EQ(MovementCurve::CoalesceInput(false, false, -0.6f, 0.2f), -0.25f);
+	EXPECT_FLOAT_EQ(MovementCurve::CoalesceInput(false, false, 1.5f, 0.2f), 1.0f);
+	EXPECT_FLOAT_EQ(MovementCurve::CoalesceInput(false, true, 0.6f, 0.2f), 1.0f);
+	EXPECT_FLOAT_EQ(MovementCurve::CoalesceInput(true, false, 0.6f, 0.2f), -0.75f);
+}
+
+TEST(MovementCurve, IntegratesTheRampAndTheCap) {
+	EXPECT_FLOAT_EQ(MovementCurve::Integrate({ 5.0f, 0.0f, 40.0f, 0.2f }, 3.0f, 0.5f), 2.5f);
+
+	// The ramp from 5 to 40 at 20 per second ends after 1.75 seconds
+	EXPECT_FLOAT_EQ(MovementCurve::Integrate(kConfig, 0.0f, 1.0f), 5.0f + 10.0f);
+	EXPECT_FLOAT_EQ(MovementCurve::Integrate(kConfig, 2.0f, 1.0f), 40.0f);
+	EXPECT_FLOAT_EQ(MovementCurve::Integrate(kConfig, 0.0f, 2.75f), 5.0f * 1.75f + 10.0f * 1.75f * 1.75f + 40.0f);
+
+	// A max speed below the base speed never slows the movement down
+	EXPECT_FLOAT_EQ(MovementCurve::Integrate({ 5.0f, 20.0f, 1.0f, 0.2f }, 0.0f, 1.0f), 5.0f);
+}
+
+TEST(MovementCurve, IntegrationIsAdditive) {
+	for (float split : { 0.1f, 1.0f, 1.75f, 2.5f }) {
+		float whole = MovementCurve::Integrate(kConfig, 0.0f, 3.0f);
+		float parts = MovementCurve::Integrate(kConfig, 0.0f, split) + MovementCurve::Integrate(kConfig, split, 3.0f - split);
+		EXPECT_NEAR(whole, parts, 1e-4f) << split;
+	}
+}
+
+TEST(MovementCurve, DoesNothingWithoutAnAxis) {
+	MovementCurve::Integrator integrator;
+	integrator.SetRightHeld(true);
+
+	Vector3 delta;
+	EXPECT_FALSE(integrator.IsEnabled());
+	EXPECT_FALSE(integrator.Update(kConfig, 0.016f, delta));
+
+	integrator.SetAxis(7);
+	EXPECT_FALSE(integrator.IsEnabled());
+}
+
+TEST(MovementCurve, MovesOnlyTheActiveAxis) {
+	MovementCurve::Integrator integrator;
+	integrator.SetAxis(MovementCurve::kAxis_Y);
+	integrator.SetLeftHeld(true);
+
+	Vector3 delta;
+	ASSERT_TRUE(integrator.Update(kConfig, 1.0f, delta));
+	EXPECT_EQ(delta.x, 0.0f);
+	EXPECT_FLOAT_EQ(delta.y, -15.0f);
+	EXPECT_EQ(delta.z, 0.0f);
+}
+
+TEST(MovementCurve, FrameRateDoesNotChangeTheDistance) {
+	auto run = [](std::uint32_t a_frames) {
+		MovementCurve::Integrator integrator;
+		integrator.SetAxis(MovementCurve::kAxis_X);
+		integrator.SetRightHeld(true);
+
+		float total = 0.0f;
+		for (std::uint32_t ii = 0; ii < a_frames; ii++) {
+			Vector3 delta;
+			integrator.Update(kConfig, 3.0f / static_cast<float>(a_frames), delta);
+			total += delta.x;
+		}
+		return total;
+	};
+
+	float expected = MovementCurve::Integrate(kConfig, 0.0f, 3.0f);
+	EXPECT_NEAR(run(1), expected, 1e-3f);
+	EXPECT_NEAR(run(30), expected, 1e-3f);
+	EXPECT_NEAR(run(144 * 3), expected, 1e-2f);
+}
+
+TEST(MovementCurve, EventsWithinAFrameAreCoalesced) {
+	MovementCurve::Integrator integrator;
+	integrator.SetAxis(MovementCurve::kAxis_X);
+
+	// Pressed and released between two frames, nothing is held when the frame is integrated
+	integrator.SetRightHeld(true);
+	integrator.SetRightHeld(false);
+	Vector3 delta;
+	EXPECT_FALSE(integrator.Update(kConfig, 0.016f, delta));
+
+	// Only the last stick value of the frame counts
+	integrator.SetStick(1.0f);
+	integrator.SetStick(-0.2f);
+	integrator.SetStick(1.0f);
+	ASSERT_TRUE(integrator.Update(kConfig, 0.5f, delta));
+	EXPECT_FLOAT_EQ(delta.x, MovementCurve::Integrate(kConfig, 0.0f, 0.5f));
+}
+
+TEST(MovementCurve, DirectionAndAxisChangesRestartTheRamp) {
+	MovementCurve::Integrator integrator;
+	integrator.SetAxis(MovementCurve::kAxis_X);
+	integrator.SetRightHeld(true);
+
+	Vector3 delta;
+	integrator.Update(kConfig, 2.0f, delta);
+
+	integrator.SetRightHeld(false);
+	integrator.SetLeftHeld(true);
+	ASSERT_TRUE(integrator.Update(kConfig, 0.5f, delta));
+	EXPECT_FLOAT_EQ(delta.x, -MovementCurve::Integrate(kConfig, 0.0f, 0.5f));
+
+	integrator.SetAxis(MovementCurve::kAxis_Z);
+	ASSERT_TRUE(integrator.Update(kConfig, 0.5f, delta));
+	EXPECT_FLOAT_EQ(delta.z, -MovementCurve::Integrate(kConfig, 0.0f, 0.5f));
+}
+
+TEST(MovementCurve, SavesOnceTheInputIsReleased) {
+	MovementCurve::Integrator integrator;
+	integrator.SetAxis(MovementCurve::kAxis_X);
+	EXPECT_FALSE(integrator.ConsumePendingSave());
+
+	integrator.SetRightHeld(true);
+	Vector3 delta;
+	integrator.Update(kConfig, 0.1f, delta);
+	EXPECT_FALSE(integrator.ConsumePendingSave());
+
+	integrator.SetRightHeld(false);
+	integrator.Update(kConfig, 0.1f, delta);
+	EXPECT_TRUE(integrator.ConsumePendingSave());
+	EXPECT_FALSE(integrator.ConsumePendingSave());
+
+	// Closing the menu mid movement still saves
+	integrator.SetRightHeld(true);
+	integrator.Update(kConfig, 0.1f, delta);
+	integrator.Reset();
+	EXPECT_TRUE(integrator.ConsumePendingSave());
+}
@@ -0,0 +1,140 @@
+#include <cmath>
+#include <cstdint>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "Core/OffsetBlend.h"
+
+namespace {
+	struct Sample {
+		Vector3 offset;
+		bool    finished = false;
+		int     calls = 0;
+	};
+
+	std::map<std::uint32_t, Sample> Advance(OffsetBlend::Blender& a_blender, float a_interval) {
+		std::map<std::uint32_t, Sample> samples;
+		a_blender.Advance(a_interval, [&](std::uint32_t a_id, const Vector3& a_offset, bool a_finished) {
+			Sample& sample = samples[a_id];
+			sample.offset = a_offset;
+			sample.finished = a_finished;
+			sample.calls++;
+		});
+		return samples;
+	}
+}
+
+TEST(OffsetBlend, EaseIsASmoothstep) {
+	EXPECT_EQ(OffsetBlend::Ease(0.0f), 0.0f);
+	EXPECT_EQ(OffsetBlend::Ease(1.0f), 1.0f);
+	EXPECT_NEAR(OffsetBlend::Ease(0.5f), 0.5f, 1e-6f);
+	EXPECT_NEAR(OffsetBlend::Ease(0.25f), 0.15625f, 1e-6f);
+	EXPECT_NEAR(OffsetBlend::Ease(0.25f) + OffsetBlend::Ease(0.75f), 1.0f, 1e-6f);
+
+	// Out of range values are clamped
+	EXPECT_EQ(OffsetBlend::Ease(-1.0f), 0.0f);
+	EXPECT_EQ(OffsetBlend::Ease(2.0f), 1.0f);
+
+	// Monotonic with a flat start and end
+	float previous = 0.0f;
+	for (int ii = 1; ii <= 100; ii++) {
+		float value = OffsetBlend::Ease(static_cast<float>(ii) / 100.0f);
+		EXPECT_GE(value, previous);
+		previous = value;
+	}
+	EXPECT_LT(OffsetBlend::Ease(0.01f), 0.001f);
+	EXPECT_GT(OffsetBlend::Ease(0.99f), 0.999f);
+}
+
+TEST(OffsetBlend, BlendsConvergeExactlyOnTheTarget) {
+	OffsetBlend::Blender blender;
+	Vector3 from{ 0.0f, 10.0f, -5.0f };
+	Vector3 to{ 3.3f, -7.1f, 100.0f / 3.0f };
+	ASSERT_TRUE(blender.Start(1, from, to, 0.3f));
+
+	// Uneven frame times that do not add up to the duration exactly
+	const float intervals[] = { 0.016f, 0.033f, 0.007f, 0.05f, 0.016f, 0.1f, 0.016f, 0.2f };
+	float lastDistance = 1e9f;
+	bool finished = false;
+	for (float interval : intervals) {
+		auto samples = Advance(blender, interval);
+		ASSERT_EQ(samples.size(), 1u);
+
+		const Vector3& offset = samples[1].offset;
+		float distance = std::sqrt((offset.x - to.x) * (offset.x - to.x) + (offset.y - to.y) * (offset.y - to.y) + (offset.z - to.z) * (offset.z - to.z));
+		EXPECT_LE(distance, lastDistance);
+		lastDistance = distance;
+
+		if (samples[1].finished) {
+			EXPECT_EQ(offset, to);
+			finished = true;
+			break;
+		}
+	}
+
+	EXPECT_TRUE(finished);
+	EXPECT_TRUE(blender.IsEmpty());
+	EXPECT_TRUE(Advance(blender, 0.016f).empty());
+}
+
+TEST(OffsetBlend, ZeroDurationFinishesOnTheFirstFrame) {
+	OffsetBlend::Blender blender;
+	ASSERT_TRUE(blender.Start(7, Vector3{}, Vector3{ 1.0f, 2.0f, 3.0f }, 0.0f));
+	ASSERT_TRUE(blender.Start(8, Vector3{}, Vector3{ 4.0f, 5.0f, 6.0f }, -1.0f));
+
+	auto samples = Advance(blender, 0.0f);
+	EXPECT_TRUE(samples[7].finished);
+	EXPECT_EQ(samples[7].offset, (Vector3{ 1.0f, 2.0f, 3.0f }));
+	EXPECT_TRUE(samples[8].finished);
+	EXPECT_EQ(samples[8].offset, (Vector3{ 4.0f, 5.0f, 6.0f }));
+	EXPECT_TRUE(blender.IsEmpty());
+}
+
+TEST(OffsetBlend, RestartReplacesTheRunningBlend) {
+	OffsetBlend::Blender blender;
+	ASSERT_TRUE(blender.Start(1, Vector3{}, Vector3{ 10.0f, 0.0f, 0.0f }, 1.0f));
+	auto samples = Advance(blender, 0.5f);
+	EXPECT_NEAR(samples[1].offset.x, 5.0f, 1e-4f);
+
+	// A new position mid-blend starts from where the actor is now
+	ASSERT_TRUE(blender.Start(1, samples[1].offset, Vector3{ 0.0f, 0.0f, 0.0f }, 1.0f));
+	EXPECT_EQ(blender.GetCount(), 1u);
+
+	samples = Advance(blender, 0.5f);
+	EXPECT_NEAR(samples[1].offset.x, 2.5f, 1e-4f);
+	EXPECT_FALSE(samples[1].finished);
+}
+
+TEST(OffsetBlend, CancelAndCapacity) {
+	OffsetBlend::Blender blender;
+	for (std::uint32_t ii = 0; ii < OffsetBlend::kCapacity; ii++) {
+		ASSERT_TRUE(blender.Start(ii, Vector3{}, Vector3{ static_cast<float>(ii), 0.0f, 0.0f }, 1.0f));
+	}
+	EXPECT_FALSE(blender.Start(1000, Vector3{}, Vector3{}, 1.0f));
+
+	// Restarting a running blend needs no new slot
+	EXPECT_TRUE(blender.Start(5, Vector3{}, Vector3{ 50.0f, 0.0f, 0.0f }, 1.0f));
+
+	blender.Cancel(3);
+	blender.Cancel(3);
+	blender.Cancel(2000);
+	EXPECT_EQ(blender.GetCount(), OffsetBlend::kCapacity - 1);
+	EXPECT_TRUE(blender.Start(1000, Vector3{}, Vector3{}, 1.0f));
+
+	// Every blend is reported once per frame, the removed slot was refilled by the last one
+	auto samples = Advance(blender, 2.0f);
+	EXPECT_EQ(samples.size(), OffsetBlend::kCapacity);
+	EXPECT_EQ(samples.count(3), 0u);
+	EXPECT_EQ(samples[5].offset.x, 50.0f);
+	EXPECT_EQ(samples[63].offset.x, 63.0f);
+	for (const auto& [id, sample] : samples) {
+		EXPECT_EQ(sample.calls, 1) << id;
+		EXPECT_TRUE(sample.finished) << id;
+	}
+	EXPECT_TRUE(blender.IsEmpty());
+
+	blender.Start(1, Vector3{}, Vector3{}, 1.0f);
+	blender.Clear();
+	EXPECT_TRUE(blender.IsEmpty());
+}
@@ -0,0 +1,53 @@
+#include <cmath>
+#include <numbers>
+
+#include <gtest/gtest.h>
+
+#include "Core/OffsetMath.h"
+
+namespace {
+	void ExpectNear(const Vector3& a_actual, const Vector3& a_expected) {
+		EXPECT_NEAR(a_actual.x, a_expected.x, 1e-4f);
+		EXPECT_NEAR(a_actual.y, a_expected.y, 1e-4f);
+		EXPECT_NEAR(a_actual.z, a_expected.z, 1e-4f);
+	}
+}
+
+TEST(OffsetMath, RotateKeepsZAndLength) {
+	ExpectNear(OffsetMath::Rotate({ 1.0f, 0.0f, 5.0f }, 0.0f), { 1.0f, 0.0f, 5.0f });
+	ExpectNear(OffsetMath::Rotate({ 1.0f, 0.0f, 5.0f }, std::numbers::pi_v<float> / 2.0f), { 0.0f, -1.0f, 5.0f });
+	ExpectNear(OffsetMath::Rotate({ 0.0f, 1.0f, 0.0f }, std::numbers::pi_v<float> / 2.0f), { 1.0f, 0.0f, 0.0f });
+
+	Vector3 rotated = OffsetMath::Rotate({ 3.0f, 4.0f, 0.0f }, 1.234f);
+	EXPECT_NEAR(std::hypot(rotated.x, rotated.y), 5.0f, 1e-4f);
+}
+
+TEST(OffsetMath, AbsoluteModeAddsTheWholeOffset) {
+	ExpectNear(OffsetMath::GetGoalPosition({ 100.0f, 200.0f, 300.0f }, { 1.0f, 2.0f, 3.0f }, 0.0f, 0.9f, false), { 101.0f, 202.0f, 303.0f });
+}
+
+TEST(OffsetMath, RelativeModeScalesByDistanceFromOne) {
+	ExpectNear(OffsetMath::GetGoalPosition({ 100.0f, 200.0f, 300.0f }, { 10.0f, 20.0f, 30.0f }, 0.0f, 0.9f, true), { 101.0f, 202.0f, 303.0f });
+	ExpectNear(OffsetMath::GetGoalPosition({ 100.0f, 200.0f, 300.0f }, { 10.0f, 20.0f, 30.0f }, 0.0f, 1.0f, true), { 100.0f, 200.0f, 300.0f });
+	ExpectNear(OffsetMath::GetGoalPosition({ 0.0f, 0.0f, 0.0f }, { 10.0f, 0.0f, 0.0f }, 0.0f, 1.5f, true), { -5.0f, 0.0f, 0.0f });
+}
+
+TEST(OffsetMath, ClampLimitsEachAxis) {
+	ExpectNear(OffsetMath::Clamp({ 50.0f, -50.0f, 5.0f }, 10.0f), { 10.0f, -10.0f, 5.0f });
+	ExpectNear(OffsetMath::Clamp({ 50.0f, -50.0f, 5.0f }, 0.0f), { 50.0f, -50.0f, 5.0f });
+	ExpectNear(OffsetMath::Clamp({ 50.0f, -50.0f, 5.0f }, -1.0f), { 50.0f, -50.0f, 5.0f });
+}
+
+TEST(OffsetMath, NudgeMovesOneAxis) {
+	ExpectNear(OffsetMath::Nudge({}, 0, 2.0f, 0.5f, 0.0f), { 1.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetMath::Nudge({}, 1, -3.0f, 1.0f, 0.0f), { 0.0f, -3.0f, 0.0f });
+	ExpectNear(OffsetMath::Nudge({}, 2, 1.0f, 4.0f, 2.0f), { 0.0f, 0.0f, 2.0f });
+	ExpectNear(OffsetMath::Nudge({ 1.0f, 2.0f, 3.0f }, 3, 1.0f, 1.0f, 0.0f), { 1.0f, 2.0f, 3.0f });
+}
+
+TEST(OffsetMath, SetAxisReplacesOneAxis) {
+	ExpectNear(OffsetMath::SetAxis({ 1.0f, 2.0f, 3.0f }, 0, -4.0f, 0.0f), { -4.0f, 2.0f, 3.0f });
+	ExpectNear(OffsetMath::SetAxis({ 1.0f, 2.0f, 3.0f }, 1, 0.0f, 0.0f), { 1.0f, 0.0f, 3.0f });
+	ExpectNear(OffsetMath::SetAxis({ 1.0f, 2.0f, 3.0f }, 2, 9.0f, 5.0f), { 1.0f, 2.0f, 5.0f });
+	ExpectNear(OffsetMath::SetAxis({ 1.0f, 2.0f, 3.0f }, 3, 9.0f, 0.0f), { 1.0f, 2.0f, 3.0f });
+}
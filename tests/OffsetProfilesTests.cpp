@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/OffsetProfiles.h"
+
+namespace {
+	using PositionFile::Entry;
+
+	constexpr float kBucketSize = 0.05f;
+
+	std::vector<Entry> MakeEntries() {
+		std::vector<Entry> entries{
+			{ 1, { 10.0f, 0.0f, 0.0f }, 1.1f },
+			{ 0, { 1.0f, 1.0f, 1.0f } },
+			{ 1, { 0.0f, 0.0f, 0.0f }, 0.9f },
+			{ 1, { 7.0f, 7.0f, 7.0f } },
+			{ 2, { 3.0f, 0.0f, 0.0f }, 1.0f },
+		};
+		OffsetProfiles::Sort(entries);
+		return entries;
+	}
+
+	void ExpectNear(const std::optional<Vector3>& a_actual, const Vector3& a_expected) {
+		ASSERT_TRUE(a_actual);
+		EXPECT_NEAR(a_actual->x, a_expected.x, 1e-4f);
+		EXPECT_NEAR(a_actual->y, a_expected.y, 1e-4f);
+		EXPECT_NEAR(a_actual->z, a_expected.z, 1e-4f);
+	}
+}
+
+TEST(OffsetProfiles, BucketScalesRoundToTheBucketSize) {
+	EXPECT_NEAR(OffsetProfiles::GetBucketScale(1.0f, kBucketSize), 1.0f, 1e-6f);
+	EXPECT_NEAR(OffsetProfiles::GetBucketScale(1.024f, kBucketSize), 1.0f, 1e-6f);
+	EXPECT_NEAR(OffsetProfiles::GetBucketScale(1.026f, kBucketSize), 1.05f, 1e-6f);
+	EXPECT_NEAR(OffsetProfiles::GetBucketScale(0.01f, kBucketSize), kBucketSize, 1e-6f);
+	EXPECT_EQ(OffsetProfiles::GetBucketScale(1.234f, 0.0f), 1.234f);
+	EXPECT_EQ(OffsetProfiles::GetBucketScale(PositionFile::kNoScale, kBucketSize), PositionFile::kNoScale);
+}
+
+TEST(OffsetProfiles, SortPutsTheUnscaledEntryFirst) {
+	auto entries = MakeEntries();
+	ASSERT_EQ(entries.size(), 5u);
+	EXPECT_EQ(entries[0].index, 0u);
+	EXPECT_EQ(entries[1].index, 1u);
+	EXPECT_EQ(entries[1].scale, PositionFile::kNoScale);
+	EXPECT_FLOAT_EQ(entries[2].scale, 0.9f);
+	EXPECT_FLOAT_EQ(entries[3].scale, 1.1f);
+	EXPECT_EQ(entries[4].index, 2u);
+}
+
+TEST(OffsetProfiles, ExactAndNearbyBucketsWin) {
+	auto entries = MakeEntries();
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 0.9f, kBucketSize), { 0.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 0.91f, kBucketSize), { 0.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 1.09f, kBucketSize), { 10.0f, 0.0f, 0.0f });
+}
+
+TEST(OffsetProfiles, InterpolatesBetweenNeighboringBuckets) {
+	auto entries = MakeEntries();
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 1.0f, kBucketSize), { 5.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 0.95f, kBucketSize), { 2.5f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 1.05f, kBucketSize), { 7.5f, 0.0f, 0.0f });
+}
+
+TEST(OffsetProfiles, ClampsToTheOutermostBuckets) {
+	auto entries = MakeEntries();
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 0.5f, kBucketSize), { 0.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 2.0f, kBucketSize), { 10.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 2, 0.5f, kBucketSize), { 3.0f, 0.0f, 0.0f });
+}
+
+TEST(OffsetProfiles, FallsBackToTheUnscaledEntry) {
+	auto entries = MakeEntries();
+	ExpectNear(OffsetProfiles::Resolve(entries, 0, 1.3f, kBucketSize), { 1.0f, 1.0f, 1.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, PositionFile::kNoScale, kBucketSize), { 7.0f, 7.0f, 7.0f });
+
+	// An actor with buckets but no unscaled entry has nothing to use without a scale
+	EXPECT_FALSE(OffsetProfiles::Resolve(entries, 2, PositionFile::kNoScale, kBucketSize));
+	EXPECT_FALSE(OffsetProfiles::Resolve(entries, 3, 1.0f, kBucketSize));
+	EXPECT_FALSE(OffsetProfiles::Resolve({}, 0, 1.0f, kBucketSize));
+}
+
+TEST(OffsetProfiles, MergeReplacesTheSameBucket) {
+	auto entries = MakeEntries();
+	OffsetProfiles::Merge(entries, { { 1, { 11.0f, 0.0f, 0.0f }, 1.1001f }, { 1, { 4.0f, 0.0f, 0.0f }, 1.0f }, { 0, { 2.0f, 2.0f, 2.0f } } }, kBucketSize);
+
+	ASSERT_EQ(entries.size(), 6u);
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 1.1f, kBucketSize), { 11.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 1, 1.0f, kBucketSize), { 4.0f, 0.0f, 0.0f });
+	ExpectNear(OffsetProfiles::Resolve(entries, 0, PositionFile::kNoScale, kBucketSize), { 2.0f, 2.0f, 2.0f });
+	EXPECT_TRUE(std::is_sorted(entries.begin(), entries.end(), [](const Entry& a_lhs, const Entry& a_rhs) {
+		return a_lhs.index != a_rhs.index ? a_lhs.index < a_rhs.index : a_lhs.scale < a_rhs.scale;
+	}));
+}
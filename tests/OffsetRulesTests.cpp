@@ -0,0 +1,139 @@
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Core/MemoryTracker.h"
+#include "Core/OffsetRules.h"
+
+namespace {
+	using OffsetRules::KIND;
+	using OffsetRules::Rule;
+
+	// Each rule's single entry carries its declaration order in x, so a match tells which rule won
+	std::vector<Rule> MakeRules(const std::vector<std::string>& a_patterns) {
+		std::string buffer;
+		for (std::size_t ii = 0; ii < a_patterns.size(); ii++) {
+			buffer += fmt::format("[{}]\n0|{},0,0\n", a_patterns[ii], ii);
+		}
+		return OffsetRules::Parse(buffer);
+	}
+
+	int MatchRule(OffsetRules::Matcher& a_matcher, std::string_view a_position) {
+		OffsetRules::Entries entries;
+		if (!a_matcher.Match(a_position, entries)) {
+			return -1;
+		}
+		return static_cast<int>(entries.at(0).offset.x);
+	}
+}
+
+TEST(OffsetRules, ParseReadsKindsAndEntries) {
+	auto rules = OffsetRules::Parse(
+		"# comment\n"
+		"0|1,1,1\n"
+		"[AAF_Bed_01]\n"
+		"0|1,2,3\n"
+		"1|4,5,6\n"
+		"[AAF_*_Bed]\n"
+		"0|7,8,9\n"
+		"[bad\n"
+		"0|1,1,1\n"
+		"[re:AAF_(Floor|Bed)_\\d+]\n"
+		"0|0,0,1\n");
+
+	ASSERT_EQ(rules.size(), 3u);
+	EXPECT_EQ(rules[0].kind, KIND::kExact);
+	EXPECT_EQ(rules[0].pattern, "aaf_bed_01");
+	EXPECT_EQ(rules[0].entries.size(), 2u);
+	EXPECT_EQ(rules[1].kind, KIND::kGlob);
+	EXPECT_EQ(rules[1].pattern, "aaf_*_bed");
+	// The lines after an unreadable pattern are dropped with it
+	EXPECT_EQ(rules[1].entries.size(), 1u);
+	EXPECT_EQ(rules[2].kind, KIND::kRegex);
+	EXPECT_EQ(rules[2].pattern, "AAF_(Floor|Bed)_\\d+");
+}
+
+TEST(OffsetRules, ExactBeatsGlobBeatsRegex) {
+	OffsetRules::Matcher matcher;
+	matcher.Compile(MakeRules({ "re:aaf_.*", "aaf_*", "aaf_bed_01" }));
+
+	EXPECT_EQ(MatchRule(matcher, "AAF_Bed_01"), 2);
+	EXPECT_EQ(MatchRule(matcher, "AAF_Bed_02"), 1);
+	EXPECT_EQ(MatchRule(matcher, "Other"), -1);
+}
+
+TEST(OffsetRules, LongerGlobsWin) {
+	OffsetRules::Matcher matcher;
+	matcher.Compile(MakeRules({ "*", "aaf_*", "aaf_*_bed", "*_bed" }));
+
+	EXPECT_EQ(MatchRule(matcher, "aaf_double_bed"), 2);
+	EXPECT_EQ(MatchRule(matcher, "aaf_floor"), 1);
+	EXPECT_EQ(MatchRule(matcher, "x_bed"), 3);
+	EXPECT_EQ(MatchRule(matcher, "x"), 0);
+}
+
+TEST(OffsetRules, FirstDeclaredWinsWithinAPrecedence) {
+	OffsetRules::Matcher matcher;
+	matcher.Compile(MakeRules({ "a?c*", "ab*", "re:.*bed", "re:aaf_.*", "re:aaf_b.d", "same", "same" }));
+
+	// Globs with the same number of literals
+	EXPECT_EQ(MatchRule(matcher, "abcc"), 0);
+	// Regexes under different prefixes and within the same combined automaton
+	EXPECT_EQ(MatchRule(matcher, "aaf_bed"), 2);
+	EXPECT_EQ(MatchRule(matcher, "aaf_floor"), 3);
+	EXPECT_EQ(MatchRule(matcher, "same"), 5);
+}
+
+TEST(OffsetRules, RegexesWithBackreferencesKeepTheirGroups) {
+	OffsetRules::Matcher matcher;
+	matcher.Compile(MakeRules({ "re:(\\w+)_bed", "re:(\\w)(\\w)_\\2\\1", "re:(\\d)(\\d)_floor", "re:x(y)?z" }));
+
+	// Combined with the other rules the backreferences would point at their groups
+	EXPECT_EQ(MatchRule(matcher, "ab_ba"), 1);
+	EXPECT_EQ(MatchRule(matcher, "ab_"), -1);
+	EXPECT_EQ(MatchRule(matcher, "ab_ab"), -1);
+
+	// The rules combined without it still find their own group
+	EXPECT_EQ(MatchRule(matcher, "double_bed"), 0);
+	EXPECT_EQ(MatchRule(matcher, "12_floor"), 2);
+	EXPECT_EQ(MatchRule(matcher, "xz"), 3);
+}
+
+TEST(OffsetRules, InvalidRegexesAreDropped) {
+	OffsetRules::Matcher matcher;
+	EXPECT_EQ(matcher.Compile(MakeRules({ "re:(", "re:bed" })), 1u);
+	EXPECT_EQ(MatchRule(matcher, "BED"), 1);
+
+	matcher.Clear();
+	EXPECT_EQ(matcher.GetRuleCount(), 0u);
+	EXPECT_EQ(MatchRule(matcher, "bed"), -1);
+}
+
+TEST(OffsetRules, MemoStartsOverEmptyWhenOverBudget) {
+	auto category = MemoryTracker::CATEGORY::kRuleMemo;
+	constexpr std::size_t kBudget = 64 * 1024;
+	MemoryTracker::SetBudget(category, kBudget);
+
+	OffsetRules::Matcher matcher;
+	matcher.Compile(MakeRules({ "aaf_*" }));
+
+	// Every drop in usage is a reset, which must leave no more than the one entry just added
+	std::size_t resets = 0;
+	std::size_t previous = MemoryTracker::GetUsage(category).current;
+	for (int ii = 0; ii < 20000; ii++) {
+		ASSERT_EQ(MatchRule(matcher, fmt::format("aaf_{}", ii)), 0);
+
+		std::size_t current = MemoryTracker::GetUsage(category).current;
+		if (current < previous) {
+			resets++;
+			EXPECT_LT(current, 1024u) << ii;
+		}
+		previous = current;
+	}
+
+	EXPECT_GT(resets, 0u);
+	EXPECT_LT(resets, 100u);
+	MemoryTracker::SetBudget(category, 0);
+}
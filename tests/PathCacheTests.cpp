@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/PathCache.h"
+
+namespace {
+	// Stand-ins for ExtraRefrPath and an actor's extraList, counting the walks a lookup costs
+	struct Path {
+		float goal = 0.0f;
+	};
+
+	struct Actor {
+		Path*         current = nullptr;
+		Path*         cached = nullptr;
+		std::uint32_t cachedGeneration = 0;
+		std::uint32_t walks = 0;
+		float         original = 0.0f;
+	};
+
+	struct Scene {
+		PathCache::Generation generation;
+		std::vector<Actor>    actors;
+	};
+
+	Path* Lookup(Actor& a_actor, const PathCache::Generation& a_generation, std::uint64_t& a_hits) {
+		return PathCache::Lookup(a_actor.cached, a_actor.cachedGeneration, a_generation.Get(), a_hits,
+			[&](Path* a_cached) { return a_actor.current == a_cached; },
+			[&]() {
+				a_actor.walks++;
+				return a_actor.current;
+			},
+			[&](Path* a_path) { a_actor.original = a_path->goal; });
+	}
+
+	std::uint32_t LookupAll(Scene& a_scene, std::uint64_t& a_hits) {
+		std::uint32_t walks = 0;
+		for (auto& actor : a_scene.actors) {
+			std::uint32_t before = actor.walks;
+			Lookup(actor, a_scene.generation, a_hits);
+			walks += actor.walks - before;
+		}
+		return walks;
+	}
+}
+
+TEST(PathCache, RepeatedLookupsWalkOnce) {
+	Path path{ 5.0f };
+	Actor actor{ &path };
+	PathCache::Generation generation;
+	std::uint64_t hits = 0;
+
+	for (int ii = 0; ii < 10; ii++) {
+		EXPECT_EQ(Lookup(actor, generation, hits), &path);
+	}
+	EXPECT_EQ(actor.walks, 1u);
+	EXPECT_EQ(hits, 9u);
+	EXPECT_EQ(actor.original, 5.0f);
+}
+
+TEST(PathCache, ChangingOneSceneKeepsOtherScenesCached) {
+	std::vector<Path> paths(6);
+	Scene sceneA;
+	Scene sceneB;
+	for (std::size_t ii = 0; ii < 3; ii++) {
+		sceneA.actors.push_back({ &paths[ii] });
+		sceneB.actors.push_back({ &paths[ii + 3] });
+	}
+
+	std::uint64_t hits = 0;
+	EXPECT_EQ(LookupAll(sceneA, hits), 3u);
+	EXPECT_EQ(LookupAll(sceneB, hits), 3u);
+
+	// An animation change in scene A only re-walks scene A's actors
+	sceneA.generation.Bump();
+	EXPECT_EQ(LookupAll(sceneA, hits), 3u);
+	EXPECT_EQ(LookupAll(sceneB, hits), 0u);
+	EXPECT_EQ(LookupAll(sceneA, hits), 0u);
+	EXPECT_EQ(hits, 6u);
+}
+
+TEST(PathCache, MissingOrMovedPathsAreWalkedAgain) {
+	Path first{ 1.0f };
+	Path second{ 2.0f };
+	Actor actor{ &first };
+	PathCache::Generation generation;
+	std::uint64_t hits = 0;
+
+	EXPECT_EQ(Lookup(actor, generation, hits), &first);
+
+	// The path left the extraList, the lookup walks and finds nothing
+	actor.current = nullptr;
+	EXPECT_EQ(Lookup(actor, generation, hits), nullptr);
+	EXPECT_EQ(actor.walks, 2u);
+
+	// A new path replaces the cached one and refreshes the original position
+	actor.current = &second;
+	generation.Bump();
+	EXPECT_EQ(Lookup(actor, generation, hits), &second);
+	EXPECT_EQ(actor.original, 2.0f);
+	EXPECT_EQ(hits, 0u);
+}
+
+TEST(PathCache, ReplacedPathIsWalkedAgain) {
+	Path first{ 1.0f };
+	Path second{ 2.0f };
+	Actor actor{ &first };
+	PathCache::Generation generation;
+	std::uint64_t hits = 0;
+
+	EXPECT_EQ(Lookup(actor, generation, hits), &first);
+	EXPECT_EQ(Lookup(actor, generation, hits), &first);
+	EXPECT_EQ(hits, 1u);
+
+	// The engine rebuilt the path within the same generation, the actor still has one but not the cached one
+	actor.current = &second;
+	EXPECT_EQ(Lookup(actor, generation, hits), &second);
+	EXPECT_EQ(actor.walks, 2u);
+	EXPECT_EQ(actor.original, 2.0f);
+
+	EXPECT_EQ(Lookup(actor, generation, hits), &second);
+	EXPECT_EQ(actor.walks, 2u);
+	EXPECT_EQ(hits, 2u);
+}
+
+TEST(PathCache, GenerationSkipsZero) {
+	PathCache::Generation generation;
+	EXPECT_NE(generation.Get(), 0u);
+
+	Path path;
+	Actor actor{ &path };
+	std::uint64_t hits = 0;
+
+	// An entry stored under generation 0 never matches a live scene
+	EXPECT_EQ(PathCache::Lookup(actor.cached, actor.cachedGeneration, 0, hits, [](Path*) { return true; }, [&] { return &path; }, [](Path*) {}), &path);
+	EXPECT_EQ(Lookup(actor, generation, hits), &path);
+	EXPECT_EQ(hits, 0u);
+}
@@ -0,0 +1,157 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/PositionBaker.h"
+#include "tests/TestUtils.h"
+
+namespace {
+	using PositionBaker::Entries;
+	using PositionBaker::TOKEN;
+
+	std::string ReadAll(const std::filesystem::path& a_path) {
+		std::ifstream file(a_path, std::ios::binary);
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		return stream.str();
+	}
+
+	Entries LoadOffsets(std::string_view a_name) {
+		Entries entries;
+		PositionFile::Load(TestUtils::GetFixture("Bake/Offsets").append(a_name).string() + ".txt", entries);
+		return entries;
+	}
+
+	// The positions of the sample pack, keyed like the position tool does
+	std::unordered_map<std::string, PositionBaker::Position> ReadSamplePositions() {
+		std::vector<PositionBaker::Position> list;
+		EXPECT_TRUE(PositionBaker::ReadPositions(TestUtils::GetFixture("Bake/XML/Positions/Sample_positionData.xml"), list));
+
+		std::unordered_map<std::string, PositionBaker::Position> result;
+		for (auto& position : list) {
+			result.emplace(PositionBaker::MakeKey(position.id), std::move(position));
+		}
+		return result;
+	}
+}
+
+TEST(PositionBaker, ReaderCopiesEveryByte) {
+	std::string content = ReadAll(TestUtils::GetFixture("Bake/XML/Animations/Sample_animationData.xml"));
+	ASSERT_FALSE(content.empty());
+
+	std::istringstream stream(content);
+	PositionBaker::XmlReader reader(stream);
+
+	std::string copy;
+	std::size_t animations = 0;
+	for (TOKEN token = reader.Next(); token != TOKEN::kEnd; token = reader.Next()) {
+		copy += reader.GetRaw();
+		animations += token == TOKEN::kStartTag && reader.GetName() == "animation";
+	}
+
+	EXPECT_EQ(copy, content);
+	// The animation inside the comment is not a tag
+	EXPECT_EQ(animations, 3u);
+}
+
+TEST(PositionBaker, ReaderEditsAttributes) {
+	std::istringstream stream("<actor gender='F' offset=\"1,2,3\"/><actor skeleton=\"a>b\" ><idle/></actor>");
+	PositionBaker::XmlReader reader(stream);
+
+	ASSERT_EQ(reader.Next(), TOKEN::kStartTag);
+	EXPECT_EQ(reader.GetName(), "actor");
+	EXPECT_TRUE(reader.IsSelfClosing());
+
+	std::string value;
+	ASSERT_TRUE(reader.GetAttribute("gender", value));
+	EXPECT_EQ(value, "F");
+	reader.SetAttribute("offset", "4,5,6");
+	EXPECT_EQ(reader.GetRaw(), "<actor gender='F' offset=\"4,5,6\"/>");
+
+	// A > inside a quoted value does not end the tag
+	ASSERT_EQ(reader.Next(), TOKEN::kStartTag);
+	EXPECT_FALSE(reader.IsSelfClosing());
+	EXPECT_FALSE(reader.GetAttribute("offset", value));
+	reader.SetAttribute("offset", "1,0,0");
+	EXPECT_EQ(reader.GetRaw(), "<actor skeleton=\"a>b\" offset=\"1,0,0\" >");
+
+	ASSERT_EQ(reader.Next(), TOKEN::kStartTag);
+	ASSERT_EQ(reader.Next(), TOKEN::kEndTag);
+	EXPECT_EQ(reader.GetName(), "actor");
+	EXPECT_EQ(reader.Next(), TOKEN::kEnd);
+}
+
+TEST(PositionBaker, ReadPositionsReadsTheSamplePack) {
+	auto positions = ReadSamplePositions();
+	ASSERT_EQ(positions.size(), 6u);
+	EXPECT_EQ(positions["sample_bed_02"].animation, "Sample_Bed_Anim");
+	EXPECT_EQ(positions["sample_quoted"].animation, "Sample_Quoted_Anim");
+	// Trees have no single animation
+	EXPECT_TRUE(positions["sample_tree"].animation.empty());
+
+	std::vector<PositionBaker::Position> list;
+	EXPECT_FALSE(PositionBaker::ReadPositions(TestUtils::GetFixture("Bake/Missing.xml"), list));
+}
+
+TEST(PositionBaker, CheckBakeableGivesTheReason) {
+	auto positions = ReadSamplePositions();
+	Entries bed = LoadOffsets("Sample_Bed_01");
+
+	EXPECT_EQ(PositionBaker::CheckBakeable(nullptr, bed, false, nullptr), "no AAF position");
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_tree"], bed, false, nullptr), "not a single animation");
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_floor"], LoadOffsets("Sample_Floor"), false, nullptr), "has scale buckets");
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_quoted"], { { 0, Vector3{} } }, false, nullptr), "no offsets");
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_bed_01"], bed, false, nullptr), "");
+}
+
+TEST(PositionBaker, SeparatePlayerOffsetsMustMatch) {
+	auto positions = ReadSamplePositions();
+	Entries bed = LoadOffsets("Sample_Bed_01");
+	Entries playerBed = LoadOffsets("Player/Sample_Bed_01");
+	Entries chair = LoadOffsets("Sample_Chair");
+	Entries playerChair = LoadOffsets("Player/Sample_Chair");
+
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_bed_01"], bed, true, &playerBed), "");
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_bed_02"], bed, true, nullptr), "no player offsets");
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_chair"], chair, true, &playerChair), "player offsets differ");
+	// Player files only matter when the plugin reads them
+	EXPECT_EQ(PositionBaker::CheckBakeable(&positions["sample_chair"], chair, false, &playerChair), "");
+}
+
+TEST(PositionBaker, BakeMatchesTheExpectedXml) {
+	std::unordered_map<std::string, Entries> animations{
+		{ PositionBaker::MakeKey("Sample_Bed_Anim"), LoadOffsets("Sample_Bed_01") },
+		{ PositionBaker::MakeKey("Sample_Chair_Anim"), LoadOffsets("Sample_Chair") },
+		{ PositionBaker::MakeKey("Sample_Missing_Anim"), LoadOffsets("Sample_Chair") }
+	};
+
+	TestUtils::TemporaryDirectory directory;
+	auto outPath = directory.Get() / "Animations" / "Sample_animationData.xml";
+
+	PositionBaker::Result result;
+	ASSERT_TRUE(PositionBaker::Bake(TestUtils::GetFixture("Bake/XML/Animations/Sample_animationData.xml"), outPath, animations, result));
+	EXPECT_EQ(result.actorCount, 3u);
+	EXPECT_EQ(result.animations, (std::vector<std::string>{ "sample_bed_anim", "sample_chair_anim" }));
+
+	EXPECT_EQ(ReadAll(outPath), ReadAll(TestUtils::GetFixture("Bake/Expected/Animations/Sample_animationData.xml")));
+	EXPECT_FALSE(std::filesystem::exists(outPath.string() + ".tmp"));
+}
+
+TEST(PositionBaker, UnchangedFilesAreNotWritten) {
+	std::unordered_map<std::string, Entries> animations{ { PositionBaker::MakeKey("Sample_Floor_Anim"), { { 0, Vector3{} } } } };
+
+	TestUtils::TemporaryDirectory directory;
+	auto outPath = directory.Get() / "Sample_animationData.xml";
+
+	PositionBaker::Result result;
+	ASSERT_TRUE(PositionBaker::Bake(TestUtils::GetFixture("Bake/XML/Animations/Sample_animationData.xml"), outPath, animations, result));
+	EXPECT_EQ(result.actorCount, 0u);
+	EXPECT_FALSE(std::filesystem::exists(outPath));
+	EXPECT_FALSE(std::filesystem::exists(outPath.string() + ".tmp"));
+
+	EXPECT_FALSE(PositionBaker::Bake(TestUtils::GetFixture("Bake/Missing.xml"), outPath, animations, result));
+}
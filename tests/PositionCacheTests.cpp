@@ -0,0 +1,173 @@
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/MemoryTracker.h"
+#include "Core/PositionCache.h"
+#include "bench/Corpus.h"
+#include "tests/TestUtils.h"
+
+namespace {
+	class PositionCache : public ::testing::Test {
+	protected:
+		void SetUp() override { ::PositionCache::Clear(); }
+		void TearDown() override {
+			::PositionCache::Clear();
+			::PositionCache::SetMemoryLimit(0);
+		}
+	};
+}
+
+TEST_F(PositionCache, PrewarmServesEveryFileOfBothFolders) {
+	TestUtils::TemporaryDirectory dir;
+	Corpus::PositionOptions options;
+	options.count = 500;
+	Corpus::WritePositions(dir.Get(), options);
+
+	auto stats = ::PositionCache::Prewarm({ { dir.Get(), false }, { dir.Get() / "Player", true } }, 4, 0, {});
+	EXPECT_EQ(stats.files, 550u);
+	EXPECT_GT(stats.entries, stats.files);
+	EXPECT_FALSE(stats.limitReached);
+	EXPECT_FALSE(stats.cancelled);
+
+	std::vector<PositionFile::Entry> entries;
+	std::vector<PositionFile::Entry> expected;
+	ASSERT_TRUE(PositionFile::Load((dir.Get() / (Corpus::GetPositionName(123) + ".txt")).string(), expected));
+	ASSERT_TRUE(::PositionCache::Find(Corpus::GetPositionName(123), false, entries));
+	EXPECT_EQ(entries.size(), expected.size());
+
+	// Lookups ignore case like the game's file system
+	EXPECT_TRUE(::PositionCache::Contains("LEITO_DOGGY_000", false));
+	EXPECT_TRUE(::PositionCache::Find(Corpus::GetPositionName(10), true, entries));
+	EXPECT_FALSE(entries.empty());
+
+	// Even a complete scan does not prove a position has no file, one can be added after it
+	EXPECT_FALSE(::PositionCache::Find("NoSuchPosition", false, entries));
+	EXPECT_FALSE(::PositionCache::Contains("NoSuchPosition", true));
+}
+
+TEST_F(PositionCache, FilesAddedAfterAScanAreFound) {
+	TestUtils::TemporaryDirectory dir;
+	dir.Write("First.txt", "0|1,1,1\n");
+	::PositionCache::Prewarm({ { dir.Get(), false } }, 1, 0, {});
+
+	std::vector<PositionFile::Entry> entries;
+	EXPECT_TRUE(::PositionCache::Find("First", false, entries));
+	EXPECT_FALSE(::PositionCache::Find("Added", false, entries));
+
+	// Only a lookup that found no file answers for that one position
+	::PositionCache::StoreMissing("Checked", false);
+	EXPECT_TRUE(::PositionCache::Contains("checked", false));
+	ASSERT_TRUE(::PositionCache::Find("CHECKED", false, entries));
+	EXPECT_TRUE(entries.empty());
+	EXPECT_FALSE(::PositionCache::Contains("Checked", true));
+	EXPECT_FALSE(::PositionCache::Find("Added", false, entries));
+
+	// A save replaces the missing answer
+	::PositionCache::Store("Checked", false, { { 0, { 2.0f, 2.0f, 2.0f } } });
+	ASSERT_TRUE(::PositionCache::Find("Checked", false, entries));
+	ASSERT_EQ(entries.size(), 1u);
+	EXPECT_EQ(entries[0].offset, (Vector3{ 2.0f, 2.0f, 2.0f }));
+}
+
+TEST_F(PositionCache, MissesGoToDiskUntilTheFileWasRead) {
+	std::vector<PositionFile::Entry> entries;
+	EXPECT_FALSE(::PositionCache::Find("Position", false, entries));
+	EXPECT_FALSE(::PositionCache::Contains("Position", false));
+
+	::PositionCache::Store("Position", false, { { 0, { 1.0f, 2.0f, 3.0f } } });
+	ASSERT_TRUE(::PositionCache::Find("position", false, entries));
+	ASSERT_EQ(entries.size(), 1u);
+	EXPECT_EQ(entries[0].offset, (Vector3{ 1.0f, 2.0f, 3.0f }));
+
+	// NPC and player offsets are kept apart
+	EXPECT_FALSE(::PositionCache::Find("Position", true, entries));
+	EXPECT_FALSE(::PositionCache::Find("Other", false, entries));
+}
+
+TEST_F(PositionCache, StoreReplacesThePrewarmedEntries) {
+	TestUtils::TemporaryDirectory dir;
+	dir.Write("Position.txt", "0|1,1,1\n");
+	::PositionCache::Prewarm({ { dir.Get(), false } }, 1, 0, {});
+
+	::PositionCache::Store("Position", false, { { 0, { 5.0f, 5.0f, 5.0f } }, { 1, { 6.0f, 6.0f, 6.0f } } });
+
+	std::vector<PositionFile::Entry> entries;
+	ASSERT_TRUE(::PositionCache::Find("Position", false, entries));
+	ASSERT_EQ(entries.size(), 2u);
+	EXPECT_EQ(entries[0].offset, (Vector3{ 5.0f, 5.0f, 5.0f }));
+}
+
+TEST_F(PositionCache, PrewarmStopsAtTheMemoryLimit) {
+	TestUtils::TemporaryDirectory dir;
+	Corpus::PositionOptions options;
+	options.count = 2000;
+	options.player = false;
+	Corpus::WritePositions(dir.Get(), options);
+
+	auto stats = ::PositionCache::Prewarm({ { dir.Get(), false } }, 4, 64 * 1024, {});
+	EXPECT_TRUE(stats.limitReached);
+	EXPECT_LT(stats.files, 2000u);
+	EXPECT_LE(stats.memoryUsage, 64u * 1024u);
+
+	// An incomplete scan cannot answer for positions it did not read
+	std::vector<PositionFile::Entry> entries;
+	EXPECT_FALSE(::PositionCache::Find("NoSuchPosition", false, entries));
+}
+
+TEST_F(PositionCache, PrewarmCanBeCancelled) {
+	TestUtils::TemporaryDirectory dir;
+	Corpus::PositionOptions options;
+	options.count = 100;
+	options.player = false;
+	Corpus::WritePositions(dir.Get(), options);
+
+	std::stop_source stopSource;
+	stopSource.request_stop();
+
+	auto stats = ::PositionCache::Prewarm({ { dir.Get(), false } }, 2, 0, stopSource.get_token());
+	EXPECT_TRUE(stats.cancelled);
+	EXPECT_EQ(stats.files, 0u);
+
+	std::vector<PositionFile::Entry> entries;
+	EXPECT_FALSE(::PositionCache::Find("NoSuchPosition", false, entries));
+}
+
+TEST_F(PositionCache, EvictionLeavesRoomForTheNextStores) {
+	TestUtils::TemporaryDirectory dir;
+	Corpus::PositionOptions options;
+	options.count = 4000;
+	options.player = false;
+	Corpus::WritePositions(dir.Get(), options);
+
+	// A limit lowered after a full prewarm, the bucket array sized for every file must not stay counted
+	::PositionCache::Prewarm({ { dir.Get(), false } }, 4, 0, {});
+	std::size_t budget = MemoryTracker::GetUsage(MemoryTracker::CATEGORY::kPositionCache).current / 16;
+	::PositionCache::SetMemoryLimit(budget);
+	EXPECT_LE(MemoryTracker::GetUsage(MemoryTracker::CATEGORY::kPositionCache).current, budget);
+
+	std::size_t kept = 0;
+	for (std::size_t ii = 0; ii < options.count; ii++) {
+		kept += ::PositionCache::Contains(Corpus::GetPositionName(ii), false);
+	}
+	EXPECT_GT(kept, options.count / 32);
+
+	// Saving positions one after another evicts in batches instead of on every store
+	std::size_t evictions = 0;
+	std::size_t previous = MemoryTracker::GetUsage(MemoryTracker::CATEGORY::kPositionCache).current;
+	for (int ii = 0; ii < 500; ii++) {
+		::PositionCache::Store("Saved" + std::to_string(ii), false, { { 0, { 1.0f, 2.0f, 3.0f } }, { 1, { 4.0f, 5.0f, 6.0f } } });
+
+		std::size_t current = MemoryTracker::GetUsage(MemoryTracker::CATEGORY::kPositionCache).current;
+		ASSERT_LE(current, budget) << ii;
+		evictions += current < previous;
+		previous = current;
+
+		std::vector<PositionFile::Entry> entries;
+		EXPECT_TRUE(::PositionCache::Find("Saved" + std::to_string(ii), false, entries));
+	}
+	EXPECT_GT(evictions, 0u);
+	EXPECT_LT(evictions, 50u);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "Core/PositionFile.h"
+#include "bench/Corpus.h"
+#include "tests/TestUtils.h"
+
+TEST(PositionFile, ParsesIndexAndOffsets) {
+	auto entries = PositionFile::Parse("0|1,2,3\n1| -4.5 , +5 ,6e1 \n");
+	ASSERT_EQ(entries.size(), 2u);
+	EXPECT_EQ(entries[0].index, 0u);
+	EXPECT_EQ(entries[0].offset, (Vector3{ 1.0f, 2.0f, 3.0f }));
+	EXPECT_EQ(entries[0].scale, PositionFile::kNoScale);
+	EXPECT_EQ(entries[1].index, 1u);
+	EXPECT_EQ(entries[1].offset, (Vector3{ -4.5f, 5.0f, 60.0f }));
+}
+
+TEST(PositionFile, SkipsCommentsBlankAndCRLFLines) {
+	auto entries = PositionFile::Parse("# header\r\n\r\n   \r\n2|1,1,1 # trailing\r\n#3|9,9,9\r\n");
+	ASSERT_EQ(entries.size(), 1u);
+	EXPECT_EQ(entries[0].index, 2u);
+	EXPECT_EQ(entries[0].offset, (Vector3{ 1.0f, 1.0f, 1.0f }));
+}
+
+TEST(PositionFile, RejectsMalformedLines) {
+	auto entries = PositionFile::Parse("|1,2,3\n0|1,2\n0|1,2,\nx|1,2,3\n0|1,a,3\n-1|1,2,3\n0@0|1,2,3\n0@-1|1,2,3\n0@x|1,2,3\n5|1,2,3\n");
+	ASSERT_EQ(entries.size(), 1u);
+	EXPECT_EQ(entries[0].index, 5u);
+}
+
+TEST(PositionFile, ParsesScaleBuckets) {
+	auto entries = PositionFile::Parse("0|1,2,3\n0@1.05|4,5,6\n1 @ 0.9 |7,8,9\n");
+	ASSERT_EQ(entries.size(), 3u);
+	EXPECT_EQ(entries[1].index, 0u);
+	EXPECT_FLOAT_EQ(entries[1].scale, 1.05f);
+	EXPECT_EQ(entries[2].index, 1u);
+	EXPECT_FLOAT_EQ(entries[2].scale, 0.9f);
+}
+
+TEST(PositionFile, SerializeRoundTrips) {
+	Corpus::Random random(7);
+	for (int ii = 0; ii < 100; ii++) {
+		auto entries = Corpus::MakeEntries(random, 5, true);
+		auto parsed = PositionFile::Parse(PositionFile::Serialize(entries));
+		ASSERT_EQ(parsed.size(), entries.size());
+		for (std::size_t jj = 0; jj < entries.size(); jj++) {
+			EXPECT_EQ(parsed[jj].index, entries[jj].index);
+			EXPECT_EQ(parsed[jj].offset, entries[jj].offset);
+			EXPECT_EQ(parsed[jj].scale, entries[jj].scale);
+		}
+	}
+}
+
+TEST(PositionFile, SavesAndLoads) {
+	TestUtils::TemporaryDirectory dir;
+	std::string path = (dir.Get() / "Position.txt").string();
+
+	std::vector<PositionFile::Entry> entries{ { 0, { 1.5f, -2.0f, 0.0f } }, { 1, { 0.0f, 0.0f, 10.0f }, 1.1f } };
+	ASSERT_TRUE(PositionFile::Save(path, entries));
+
+	std::vector<PositionFile::Entry> loaded;
+	ASSERT_TRUE(PositionFile::Load(path, loaded));
+	ASSERT_EQ(loaded.size(), 2u);
+	EXPECT_EQ(loaded[0].offset, entries[0].offset);
+	EXPECT_EQ(loaded[1].scale, entries[1].scale);
+
+	EXPECT_FALSE(PositionFile::Load((dir.Get() / "Missing.txt").string(), loaded));
+}
+
+TEST(PositionFile, LoadsGeneratedCorpus) {
+	TestUtils::TemporaryDirectory dir;
+	Corpus::PositionOptions options;
+	options.count = 200;
+	EXPECT_EQ(Corpus::WritePositions(dir.Get(), options), 220u);
+
+	std::vector<PositionFile::Entry> entries;
+	ASSERT_TRUE(PositionFile::Load((dir.Get() / (Corpus::GetPositionName(199) + ".txt")).string(), entries));
+	EXPECT_FALSE(entries.empty());
+	ASSERT_TRUE(PositionFile::Load((dir.Get() / "Player" / (Corpus::GetPositionName(190) + ".txt")).string(), entries));
+	EXPECT_FALSE(entries.empty());
+}
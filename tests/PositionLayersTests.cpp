@@ -0,0 +1,154 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/PositionLayers.h"
+#include "tests/TestUtils.h"
+
+namespace {
+	using PositionFile::Entry;
+	using PositionLayers::Entries;
+	using PositionLayers::Positions;
+
+	constexpr float kBucketSize = 0.05f;
+
+	// Packs, the plugin folder, a profile and the player layer, like the plugin builds them
+	enum SLOT : std::size_t {
+		kPack,
+		kUser,
+		kProfile,
+		kPlayer
+	};
+
+	class PositionLayersTest : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			index.Reset({ { "Packs/Base", false }, { "", false }, { "Profiles/Nora", false }, { "Player", true } }, kBucketSize);
+		}
+
+		Entries Find(std::string_view a_position, bool a_isPlayer) {
+			Entries entries;
+			EXPECT_TRUE(index.Find(a_position, a_isPlayer, entries)) << a_position;
+			return entries;
+		}
+
+		PositionLayers::Index index;
+	};
+
+	void ExpectOffset(const Entries& a_entries, std::uint32_t a_index, float a_x) {
+		for (const auto& entry : a_entries) {
+			if (entry.index == a_index && entry.scale == PositionFile::kNoScale) {
+				EXPECT_EQ(entry.offset.x, a_x) << "index " << a_index;
+				return;
+			}
+		}
+		ADD_FAILURE() << "index " << a_index << " is missing";
+	}
+}
+
+TEST(PositionLayers, KeysIgnoreCase) {
+	EXPECT_EQ(PositionLayers::MakeKey("AAF_Bed_01"), "aaf_bed_01");
+	EXPECT_EQ(PositionLayers::MakeKey(""), "");
+}
+
+TEST_F(PositionLayersTest, HigherLayersOverrideOnlyWhatTheyHold) {
+	index.Assign(kPack, Positions{ { "bed", { { 0, { 1.0f, 0.0f, 0.0f } }, { 1, { 2.0f, 0.0f, 0.0f } } } } });
+	index.Assign(kUser, Positions{ { "bed", { { 1, { 20.0f, 0.0f, 0.0f } } } } });
+	index.Assign(kProfile, Positions{ { "bed", { { 0, { 100.0f, 0.0f, 0.0f } } } } });
+
+	auto entries = Find("BED", false);
+	ASSERT_EQ(entries.size(), 2u);
+	ExpectOffset(entries, 0, 100.0f);
+	ExpectOffset(entries, 1, 20.0f);
+	EXPECT_EQ(index.GetPositionCount(), 1u);
+}
+
+TEST_F(PositionLayersTest, PlayerLayerOnlyAppliesToPlayerScenes) {
+	index.Assign(kPack, Positions{ { "bed", { { 0, { 1.0f, 0.0f, 0.0f } }, { 1, { 2.0f, 0.0f, 0.0f } } } }, { "chair", { { 0, { 3.0f, 0.0f, 0.0f } } } } });
+	index.Assign(kPlayer, Positions{ { "bed", { { 1, { 50.0f, 0.0f, 0.0f } } } }, { "couch", { { 0, { 9.0f, 0.0f, 0.0f } } } } });
+
+	ExpectOffset(Find("bed", false), 1, 2.0f);
+	ExpectOffset(Find("bed", true), 0, 1.0f);
+	ExpectOffset(Find("bed", true), 1, 50.0f);
+
+	// Positions the player layer does not hold are the same for both scene kinds
+	EXPECT_EQ(Find("chair", true).size(), 1u);
+	ExpectOffset(Find("chair", true), 0, 3.0f);
+
+	// A position only the player layer holds does not exist for NPC scenes
+	Entries entries;
+	EXPECT_FALSE(index.Find("couch", false, entries));
+	ExpectOffset(Find("couch", true), 0, 9.0f);
+}
+
+TEST_F(PositionLayersTest, ScaleBucketsMergeSeparately) {
+	index.Assign(kPack, Positions{ { "bed", { { 0, { 1.0f, 0.0f, 0.0f } }, { 0, { 2.0f, 0.0f, 0.0f }, 1.1f } } } });
+	index.Assign(kUser, Positions{ { "bed", { { 0, { 3.0f, 0.0f, 0.0f }, 1.1f } } } });
+
+	auto entries = Find("bed", false);
+	ASSERT_EQ(entries.size(), 2u);
+	ExpectOffset(entries, 0, 1.0f);
+	EXPECT_FLOAT_EQ(entries[1].scale, 1.1f);
+	EXPECT_EQ(entries[1].offset.x, 3.0f);
+}
+
+TEST_F(PositionLayersTest, AssignReplacesTheWholeLayer) {
+	index.Assign(kPack, Positions{ { "bed", { { 0, { 1.0f, 0.0f, 0.0f } } } } });
+	index.Assign(kProfile, Positions{ { "bed", { { 0, { 5.0f, 0.0f, 0.0f } } } }, { "chair", { { 0, { 6.0f, 0.0f, 0.0f } } } } });
+	ExpectOffset(Find("bed", false), 0, 5.0f);
+
+	// Switching to another profile drops what only the old one held
+	index.Assign(kProfile, "Profiles/Piper", Positions{ { "couch", { { 0, { 7.0f, 0.0f, 0.0f } } } } });
+	EXPECT_EQ(index.GetLayer(kProfile).directory, "Profiles/Piper");
+	ExpectOffset(Find("bed", false), 0, 1.0f);
+	ExpectOffset(Find("couch", false), 0, 7.0f);
+
+	Entries entries;
+	EXPECT_FALSE(index.Find("chair", false, entries));
+	EXPECT_EQ(index.GetPositionCount(), 2u);
+}
+
+TEST_F(PositionLayersTest, StoreUpdatesOnePosition) {
+	index.Assign(kPack, Positions{ { "bed", { { 0, { 1.0f, 0.0f, 0.0f } }, { 1, { 2.0f, 0.0f, 0.0f } } } } });
+	index.Store(kUser, "Bed", { { 1, { 8.0f, 0.0f, 0.0f } } });
+
+	ExpectOffset(Find("bed", false), 0, 1.0f);
+	ExpectOffset(Find("bed", false), 1, 8.0f);
+
+	// The layer itself only holds the saved delta
+	Entries entries;
+	ASSERT_TRUE(index.FindInLayer(kUser, "bed", entries));
+	ASSERT_EQ(entries.size(), 1u);
+	EXPECT_EQ(entries[0].index, 1u);
+	EXPECT_FALSE(index.FindInLayer(kProfile, "bed", entries));
+}
+
+TEST_F(PositionLayersTest, InvalidSlotsAreIgnored) {
+	index.Assign(10, Positions{ { "bed", { { 0, { 1.0f, 0.0f, 0.0f } } } } });
+	index.Store(10, "bed", { { 0, { 1.0f, 0.0f, 0.0f } } });
+
+	Entries entries;
+	EXPECT_FALSE(index.Find("bed", false, entries));
+	EXPECT_FALSE(index.FindInLayer(10, "bed", entries));
+	EXPECT_EQ(index.GetLayerCount(), 4u);
+}
+
+TEST(PositionLayers, ReadLayerReadsEveryPositionFile) {
+	TestUtils::TemporaryDirectory directory;
+	for (int ii = 0; ii < 20; ii++) {
+		directory.Write("Bed" + std::to_string(ii) + ".txt", PositionFile::Serialize({ { 0, { static_cast<float>(ii), 0.0f, 0.0f } } }));
+	}
+	directory.Write("Notes.md", "not a position");
+	directory.Write("Player/Bed0.txt", PositionFile::Serialize({ { 0, { 1.0f, 0.0f, 0.0f } } }));
+
+	// The thread count does not change the result
+	for (std::uint32_t threads : { 1u, 4u }) {
+		auto positions = PositionLayers::ReadLayer(directory.Get(), threads);
+		ASSERT_EQ(positions.size(), 20u);
+		ASSERT_TRUE(positions.contains("bed7"));
+		EXPECT_EQ(positions["bed7"][0].offset.x, 7.0f);
+	}
+
+	EXPECT_TRUE(PositionLayers::ReadLayer(directory.Get() / "Missing", 2).empty());
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/SettingsRegistry.h"
+
+using namespace std::literals;
+
+namespace {
+	using Settings::ID;
+
+	const std::pair<std::string_view, ID> kKeys[] = {
+		{ "bSeparatePlayerOffset"sv, ID::kSeparatePlayerOffset },
+		{ "bUnifyAAFDoppelgangerScale"sv, ID::kUnifyAAFDoppelgangerScale },
+		{ "iPlayerPositionerType"sv, ID::kPlayerPositionerType },
+		{ "iNPCPositionerType"sv, ID::kNPCPositionerType },
+		{ "fMoveSpeed"sv, ID::kMoveSpeed },
+		{ "fMoveAcceleration"sv, ID::kMoveAcceleration },
+		{ "fMoveMaxSpeed"sv, ID::kMoveMaxSpeed },
+		{ "fStickDeadzone"sv, ID::kStickDeadzone },
+		{ "bTelemetry"sv, ID::kTelemetry },
+		{ "bPrewarm"sv, ID::kPrewarm },
+		{ "iPrewarmThreads"sv, ID::kPrewarmThreads },
+		{ "iPrewarmMemoryLimitMB"sv, ID::kPrewarmMemoryLimit },
+		{ "bScaleProfiles"sv, ID::kScaleProfiles },
+		{ "fScaleBucketSize"sv, ID::kScaleBucketSize },
+		{ "bPrefetch"sv, ID::kPrefetch },
+		{ "iPrefetchCount"sv, ID::kPrefetchCount },
+		{ "fBlendDuration"sv, ID::kBlendDuration },
+		{ "fLODDistance"sv, ID::kLODDistance },
+		{ "iFrameBudgetUS"sv, ID::kFrameBudget },
+		{ "fNudgeStep"sv, ID::kNudgeStep },
+		{ "fOffsetLimit"sv, ID::kOffsetLimit },
+		{ "bAsyncLog"sv, ID::kAsyncLog },
+		{ "iLogRateLimit"sv, ID::kLogRateLimit },
+		{ "bLayers"sv, ID::kLayers },
+		{ "iRuleMemoBudgetKB"sv, ID::kRuleMemoBudget },
+		{ "iLogIntervalSec"sv, ID::kMemoryLogInterval },
+	};
+
+	// The registry is global, every test puts the values it touched back to their defaults
+	class SettingsRegistry : public ::testing::Test {
+	protected:
+		void TearDown() override {
+			for (std::uint32_t ii = 0; ii < static_cast<std::uint32_t>(ID::kTotal); ii++) {
+				Settings::ResetValue(static_cast<ID>(ii));
+			}
+		}
+	};
+}
+
+TEST_F(SettingsRegistry, EveryKeyHasItsOwnSlot) {
+	ASSERT_EQ(std::size(kKeys), static_cast<std::size_t>(ID::kTotal));
+	for (const auto& [key, id] : kKeys) {
+		EXPECT_EQ(Settings::FindID(key), id) << key;
+	}
+}
+
+TEST_F(SettingsRegistry, LookupIgnoresCase) {
+	for (const auto& [key, id] : kKeys) {
+		std::string upper(key);
+		std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char a_ch) { return static_cast<char>(std::toupper(a_ch)); });
+		EXPECT_EQ(Settings::FindID(upper), id) << upper;
+	}
+}
+
+TEST_F(SettingsRegistry, RejectsUnknownNames) {
+	EXPECT_FALSE(Settings::FindID(""sv));
+	EXPECT_FALSE(Settings::FindID("fMoveSpee"sv));
+	EXPECT_FALSE(Settings::FindID("fMoveSpeedX"sv));
+	EXPECT_FALSE(Settings::FindID("sUnknown"sv));
+	for (const auto& [key, id] : kKeys) {
+		std::string changed(key);
+		changed.back() = changed.back() == 'z' ? 'y' : 'z';
+		EXPECT_FALSE(Settings::FindID(changed)) << changed;
+	}
+}
+
+TEST_F(SettingsRegistry, ParsesKnownKeysOfTheirSection) {
+	auto values = Settings::ParseINI(
+		"; comment\n"
+		"[Settings]\n"
+		"bSeparatePlayerOffset = 1 ; trailing\n"
+		"fMoveSpeed=9\n"
+		"[ Movement ]\r\n"
+		"fMoveSpeed = \"12.5\"\r\n"
+		"sUnknown=1\n"
+		"# comment=1\n"
+		"fNudgeStep=2\n"
+		"fNudgeStep=3\n");
+
+	// Text after a ';' stays in the value, as GetPrivateProfileString returns it
+	EXPECT_EQ(values[static_cast<std::size_t>(ID::kSeparatePlayerOffset)], "1 ; trailing");
+	EXPECT_EQ(values[static_cast<std::size_t>(ID::kMoveSpeed)], "12.5");
+	EXPECT_EQ(values[static_cast<std::size_t>(ID::kNudgeStep)], "3");
+	EXPECT_FALSE(values[static_cast<std::size_t>(ID::kTelemetry)]);
+}
+
+TEST_F(SettingsRegistry, AppliesParsedValues) {
+	Settings::ApplyValues(Settings::ParseINI("[Settings]\nbSeparatePlayerOffset=true\niNPCPositionerType=1\n[Movement]\nfMoveSpeed=5000\nfNudgeStep=abc\n"));
+	EXPECT_TRUE(Settings::GetBool(ID::kSeparatePlayerOffset));
+	EXPECT_EQ(Settings::GetUInt(ID::kNPCPositionerType), 1u);
+	EXPECT_FLOAT_EQ(Settings::GetFloat(ID::kMoveSpeed), 1000.0f);
+	EXPECT_FLOAT_EQ(Settings::GetFloat(ID::kNudgeStep), 1.0f);
+
+	// Only the leading number is read, like the std::stoul of the old reader
+	Settings::ApplyValues(Settings::ParseINI("[Settings]\nbSeparatePlayerOffset=0 ; on\n[Movement]\nfNudgeStep=2.5;x\n"));
+	EXPECT_FALSE(Settings::GetBool(ID::kSeparatePlayerOffset));
+	EXPECT_FLOAT_EQ(Settings::GetFloat(ID::kNudgeStep), 2.5f);
+}
+
+TEST_F(SettingsRegistry, DiffReportsEditedAddedAndRemovedKeys) {
+	auto previous = Settings::ParseINI("[Movement]\nfMoveSpeed=10\nfNudgeStep=2\nfOffsetLimit=50\n");
+	auto current = Settings::ParseINI("[Movement]\nfMoveSpeed=10\nfNudgeStep=3\nfStickDeadzone=0.5\n");
+
+	auto changed = Settings::DiffValues(previous, current);
+	std::sort(changed.begin(), changed.end());
+	EXPECT_EQ(changed, (std::vector<ID>{ ID::kStickDeadzone, ID::kNudgeStep, ID::kOffsetLimit }));
+	EXPECT_TRUE(Settings::DiffValues(current, current).empty());
+}
+
+TEST_F(SettingsRegistry, RemovedKeysGoBackToTheirDefault) {
+	auto previous = Settings::ParseINI("[Movement]\nfNudgeStep=2\nfOffsetLimit=50\n");
+	Settings::ApplyValues(previous);
+	ASSERT_FLOAT_EQ(Settings::GetFloat(ID::kOffsetLimit), 50.0f);
+
+	auto current = Settings::ParseINI("[Movement]\nfNudgeStep=4\n");
+	Settings::ApplyChanges(current, Settings::DiffValues(previous, current));
+	EXPECT_FLOAT_EQ(Settings::GetFloat(ID::kNudgeStep), 4.0f);
+	EXPECT_FLOAT_EQ(Settings::GetFloat(ID::kOffsetLimit), 0.0f);
+}
+
+TEST_F(SettingsRegistry, ResetRestoresEveryType) {
+	Settings::SetValue(ID::kUnifyAAFDoppelgangerScale, 0.0);
+	Settings::SetValue(ID::kPrewarmThreads, 9.0);
+	Settings::SetValue(ID::kStickDeadzone, 0.5);
+
+	Settings::ResetValue(ID::kUnifyAAFDoppelgangerScale);
+	Settings::ResetValue(ID::kPrewarmThreads);
+	Settings::ResetValue(ID::kStickDeadzone);
+	EXPECT_TRUE(Settings::GetBool(ID::kUnifyAAFDoppelgangerScale));
+	EXPECT_EQ(Settings::GetUInt(ID::kPrewarmThreads), 4u);
+	EXPECT_FLOAT_EQ(Settings::GetFloat(ID::kStickDeadzone), 0.2f);
+}
+
+TEST_F(SettingsRegistry, ValidatesAndClampsAgainstTheSchema) {
+	EXPECT_TRUE(Settings::SetValue(ID::kPrefetchCount, 99.0));
+	EXPECT_EQ(Settings::GetUInt(ID::kPrefetchCount), 4u);
+	EXPECT_TRUE(Settings::SetValue(ID::kPrefetchCount, 2.6));
+	EXPECT_EQ(Settings::GetUInt(ID::kPrefetchCount), 3u);
+
+	EXPECT_FALSE(Settings::SetValue(ID::kNPCPositionerType, 2.0));
+	EXPECT_FALSE(Settings::SetValue(ID::kNPCPositionerType, 0.5));
+	EXPECT_EQ(Settings::GetUInt(ID::kNPCPositionerType), 0u);
+
+	EXPECT_FALSE(Settings::SetValue(ID::kMoveSpeed, std::nan("")));
+	EXPECT_FALSE(Settings::SetValue(ID::kTotal, 1.0));
+	EXPECT_FALSE(Settings::SetValue("sUnknown"sv, 1.0));
+	EXPECT_TRUE(Settings::SetValue("FMOVESPEED"sv, 7.5));
+	EXPECT_FLOAT_EQ(Settings::GetFloat(ID::kMoveSpeed), 7.5f);
+}
+
+// Callbacks cannot be unregistered, so this is the only test that registers any
+TEST_F(SettingsRegistry, CallbacksFireOnlyOnChange) {
+	static std::atomic<std::uint32_t> speedCalls = 0;
+	static std::atomic<std::uint32_t> typeCalls = 0;
+	Settings::RegisterCallback(ID::kMoveSpeed, [](ID a_id) {
+		EXPECT_EQ(a_id, ID::kMoveSpeed);
+		speedCalls++;
+	});
+	Settings::RegisterCallback(ID::kNPCPositionerType, [](ID) { typeCalls++; });
+
+	Settings::SetValue(ID::kMoveSpeed, 10.0);
+	Settings::SetValue(ID::kMoveSpeed, 10.0);
+	Settings::SetValue(ID::kMoveSpeed, 2000.0);
+	Settings::SetValue(ID::kMoveSpeed, 3000.0);
+	EXPECT_EQ(speedCalls, 2u);
+
+	Settings::SetValue(ID::kNPCPositionerType, 5.0);
+	Settings::SetValue(ID::kNPCPositionerType, 1.0);
+	Settings::ApplyValues(Settings::ParseINI("[Settings]\niNPCPositionerType=1\n"));
+	EXPECT_EQ(typeCalls, 1u);
+
+	Settings::ResetValue(ID::kNPCPositionerType);
+	EXPECT_EQ(typeCalls, 2u);
+}
+
+// Readers only ever see one of the written values, never a mix of two floats
+TEST_F(SettingsRegistry, ConcurrentReadsSeeWholeValues) {
+	std::atomic<bool> stop = false;
+	std::atomic<std::uint32_t> torn = 0;
+
+	std::vector<std::jthread> readers;
+	for (int ii = 0; ii < 4; ii++) {
+		readers.emplace_back([&]() {
+			while (!stop) {
+				float value = Settings::GetFloat(ID::kMoveMaxSpeed);
+				if (value != 40.0f && value != 123.25f && value != 0.001953125f) {
+					torn++;
+				}
+			}
+		});
+	}
+
+	for (int ii = 0; ii < 100000; ii++) {
+		Settings::SetValue(ID::kMoveMaxSpeed, ii % 2 ? 123.25 : 0.001953125);
+	}
+	stop = true;
+	readers.clear();
+
+	EXPECT_EQ(torn, 0u);
+}
+
+TEST_F(SettingsRegistry, ConcurrentWritersKeepTheirOwnSlots) {
+	const ID ids[] = { ID::kMoveSpeed, ID::kNudgeStep, ID::kLODDistance, ID::kBlendDuration };
+
+	std::vector<std::jthread> writers;
+	for (std::size_t ii = 0; ii < std::size(ids); ii++) {
+		writers.emplace_back([&, ii]() {
+			for (int jj = 1; jj <= 10000; jj++) {
+				Settings::SetValue(ids[ii], static_cast<double>(jj % 5) + static_cast<double>(ii));
+			}
+		});
+	}
+	writers.clear();
+
+	for (std::size_t ii = 0; ii < std::size(ids); ii++) {
+		EXPECT_FLOAT_EQ(Settings::GetFloat(ids[ii]), static_cast<float>(ii)) << ii;
+	}
+}
@@ -0,0 +1,191 @@
+#include <cstdint>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "Core/ShadowState.h"
+
+namespace {
+	struct Spell {};
+
+	struct Reference {
+		std::uint32_t    formID = 0;
+		std::uint16_t    refScale = 100;
+		float            position[3]{};
+		std::set<Spell*> spells;
+	};
+
+	// Stand-in for the engine calls, counting the ones that reach it
+	struct Engine {
+		using Reference = ::Reference;
+		using Spell = ::Spell;
+
+		std::uint32_t GetID(Reference* a_refr) { return a_refr->formID; }
+
+		bool HasSpell(Reference* a_actor, Spell* a_spell) {
+			calls++;
+			return a_actor->spells.contains(a_spell);
+		}
+
+		void AddSpell(Reference* a_actor, Spell* a_spell) {
+			calls++;
+			a_actor->spells.insert(a_spell);
+		}
+
+		void RemoveSpell(Reference* a_actor, Spell* a_spell) {
+			calls++;
+			a_actor->spells.erase(a_spell);
+		}
+
+		void SetRefScale(Reference* a_refr, float a_scale) {
+			calls++;
+			a_refr->refScale = static_cast<std::uint16_t>(a_scale * 100.0f);
+		}
+
+		std::uint16_t GetRefScale(Reference* a_refr) { return a_refr->refScale; }
+
+		void ModPos(Reference* a_refr, char a_axis, float a_value) {
+			calls++;
+			a_refr->position[a_axis - 'X'] = a_value;
+		}
+
+		float GetPosition(Reference* a_refr, std::size_t a_axis) { return a_refr->position[a_axis]; }
+
+		std::uint32_t calls = 0;
+	};
+
+	using Tracker = ShadowState::Tracker<Engine>;
+
+	// What ClearHighlightSpellFromActor does for every actor the selection is not on
+	void ClearHighlight(Tracker& a_tracker, Reference* a_actor, Spell* a_movable, Spell* a_immovable) {
+		a_tracker.RemoveSpell(a_actor, a_movable);
+		a_tracker.RemoveSpell(a_actor, a_immovable);
+	}
+}
+
+TEST(ShadowState, RepeatedMutationsAreElided) {
+	Tracker tracker;
+	Reference actor;
+	actor.formID = 0x14;
+	Spell spell;
+
+	tracker.AddSpell(&actor, &spell);
+	tracker.AddSpell(&actor, &spell);
+	tracker.SetRefScale(&actor, 1.1f);
+	tracker.SetRefScale(&actor, 1.1f);
+	tracker.ModPos(&actor, 'X', 10.0f);
+	tracker.ModPos(&actor, 'X', 10.0f);
+	tracker.ModPos(&actor, 'Y', 10.0f);
+
+	EXPECT_EQ(tracker.GetEngine().calls, 4u);
+	EXPECT_EQ(tracker.GetCounter(ShadowState::kSpell).elided, 1u);
+	EXPECT_EQ(tracker.GetCounter(ShadowState::kRefScale).elided, 1u);
+	EXPECT_EQ(tracker.GetCounter(ShadowState::kPosition).elided, 1u);
+	EXPECT_EQ(tracker.GetCounter(ShadowState::kPosition).requested, 3u);
+	EXPECT_TRUE(actor.spells.contains(&spell));
+}
+
+TEST(ShadowState, UnknownSpellsAreCheckedOnce) {
+	Tracker tracker;
+	Reference actor;
+	actor.formID = 0x14;
+	Spell spell;
+
+	// The first removal asks the engine, later ones know the spell is gone
+	tracker.RemoveSpell(&actor, &spell);
+	EXPECT_EQ(tracker.GetEngine().calls, 1u);
+	tracker.RemoveSpell(&actor, &spell);
+	EXPECT_EQ(tracker.GetEngine().calls, 1u);
+
+	// A known spell is removed without the HasSpell check
+	tracker.AddSpell(&actor, &spell);
+	tracker.RemoveSpell(&actor, &spell);
+	EXPECT_EQ(tracker.GetEngine().calls, 3u);
+	EXPECT_FALSE(actor.spells.contains(&spell));
+}
+
+TEST(ShadowState, OutsideChangesAreAppliedAgain) {
+	Tracker tracker;
+	Reference actor;
+	actor.formID = 0x14;
+
+	tracker.SetRefScale(&actor, 1.2f);
+	tracker.ModPos(&actor, 'Z', 5.0f);
+	EXPECT_EQ(tracker.GetEngine().calls, 2u);
+
+	// Another mod rescaled and moved the actor, the read back notices it
+	actor.refScale = 100;
+	actor.position[2] = 0.0f;
+	tracker.SetRefScale(&actor, 1.2f);
+	tracker.ModPos(&actor, 'Z', 5.0f);
+	EXPECT_EQ(tracker.GetEngine().calls, 4u);
+	EXPECT_EQ(actor.refScale, 120);
+	EXPECT_EQ(actor.position[2], 5.0f);
+}
+
+TEST(ShadowState, ReloadedReferencesStartOver) {
+	Tracker tracker;
+	Reference actor;
+	actor.formID = 0x14;
+	Spell spell;
+
+	tracker.AddSpell(&actor, &spell);
+	EXPECT_EQ(tracker.GetEngine().calls, 1u);
+
+	// Same form ID, new reference after a cell reload
+	Reference reloaded;
+	reloaded.formID = 0x14;
+	tracker.AddSpell(&reloaded, &spell);
+	EXPECT_EQ(tracker.GetEngine().calls, 2u);
+	EXPECT_EQ(tracker.GetCount(), 1u);
+
+	// Forgotten state is unknown again
+	tracker.Forget(&reloaded);
+	EXPECT_EQ(tracker.GetCount(), 0u);
+	tracker.AddSpell(&reloaded, &spell);
+	EXPECT_EQ(tracker.GetEngine().calls, 3u);
+}
+
+TEST(ShadowState, InvalidArgumentsAreIgnored) {
+	Tracker tracker;
+	Reference actor;
+	actor.formID = 0x14;
+
+	tracker.AddSpell(&actor, nullptr);
+	tracker.RemoveSpell(static_cast<Reference*>(nullptr), nullptr);
+	tracker.SetRefScale(nullptr, 1.0f);
+	tracker.ModPos(&actor, 'W', 1.0f);
+	tracker.Forget(nullptr);
+
+	EXPECT_EQ(tracker.GetEngine().calls, 0u);
+	EXPECT_EQ(tracker.GetCount(), 0u);
+}
+
+TEST(ShadowState, SceneWorkloadElidesMostCalls) {
+	Tracker tracker;
+	Spell movable;
+	Spell immovable;
+	Reference actors[4];
+	for (std::uint32_t ii = 0; ii < 4; ii++) {
+		actors[ii].formID = ii + 1;
+	}
+
+	// Every change rescales, clears the highlight and moves each actor, then highlights the next selection
+	std::uint32_t calls = 0;
+	for (std::uint32_t change = 0; change < 20; change++) {
+		for (auto& actor : actors) {
+			tracker.SetRefScale(&actor, 1.0f);
+			ClearHighlight(tracker, &actor, &movable, &immovable);
+			tracker.ModPos(&actor, 'X', static_cast<float>(actor.formID * 10));
+			tracker.ModPos(&actor, 'Y', 0.0f);
+			tracker.ModPos(&actor, 'Z', static_cast<float>(change / 5));
+			calls += 6;
+		}
+		tracker.AddSpell(&actors[change % 4], &movable);
+		calls++;
+	}
+
+	std::uint32_t reached = tracker.GetEngine().calls;
+	RecordProperty("elided", static_cast<int>(calls - reached));
+	EXPECT_LT(reached * 5, calls);
+}
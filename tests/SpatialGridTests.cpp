@@ -0,0 +1,195 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/SpatialGrid.h"
+#include "bench/Corpus.h"
+
+namespace {
+	constexpr float kCellSize = 512.0f;
+
+	struct Point {
+		std::uint32_t id;
+		Vector3       position;
+	};
+
+	float GetDistanceSq(const Vector3& a_lhs, const Vector3& a_rhs) {
+		float dx = a_lhs.x - a_rhs.x;
+		float dy = a_lhs.y - a_rhs.y;
+		float dz = a_lhs.z - a_rhs.z;
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	// Brute force answers the grid is checked against
+	std::optional<std::uint32_t> FindNearest(const std::vector<Point>& a_points, const Vector3& a_point) {
+		std::optional<std::uint32_t> result;
+		float bestDistanceSq = std::numeric_limits<float>::max();
+		for (const auto& point : a_points) {
+			float distanceSq = GetDistanceSq(point.position, a_point);
+			if (distanceSq < bestDistanceSq) {
+				bestDistanceSq = distanceSq;
+				result = point.id;
+			}
+		}
+		return result;
+	}
+
+	std::optional<std::uint32_t> FindNearestToRay(const std::vector<Point>& a_points, const Vector3& a_origin, const Vector3& a_direction, float a_radius, float a_maxDistance) {
+		float length = std::sqrt(a_direction.x * a_direction.x + a_direction.y * a_direction.y + a_direction.z * a_direction.z);
+		std::optional<std::uint32_t> result;
+		float bestDistanceSq = a_radius * a_radius;
+		float bestAlong = std::numeric_limits<float>::max();
+		for (const auto& point : a_points) {
+			Vector3 diff{ point.position.x - a_origin.x, point.position.y - a_origin.y, point.position.z - a_origin.z };
+			float along = (diff.x * a_direction.x + diff.y * a_direction.y + diff.z * a_direction.z) / length;
+			if (along < 0.0f || along > a_maxDistance) {
+				continue;
+			}
+			float distanceSq = diff.x * diff.x + diff.y * diff.y + diff.z * diff.z - along * along;
+			if (distanceSq < bestDistanceSq || (distanceSq == bestDistanceSq && along < bestAlong)) {
+				bestDistanceSq = distanceSq;
+				bestAlong = along;
+				result = point.id;
+			}
+		}
+		return result;
+	}
+
+	std::vector<Point> MakeActors(std::size_t a_scenes, std::uint32_t a_actors) {
+		Corpus::SceneOptions options;
+		options.count = a_scenes;
+		options.actors = a_actors;
+
+		std::vector<Point> points;
+		for (const auto& scene : Corpus::MakeScenes(options)) {
+			for (const auto& actor : scene.actors) {
+				points.push_back({ actor.formID, actor.position });
+			}
+		}
+		return points;
+	}
+}
+
+TEST(SpatialGrid, UpdateRemoveAndClear) {
+	SpatialGrid::Grid grid(kCellSize);
+	EXPECT_FALSE(grid.FindNearest(Vector3{}));
+
+	grid.Update(1, Vector3{ 0.0f, 0.0f, 0.0f });
+	grid.Update(2, Vector3{ 1000.0f, 0.0f, 0.0f });
+	grid.Update(1, Vector3{ 10.0f, 0.0f, 0.0f });
+	EXPECT_EQ(grid.GetCount(), 2u);
+	EXPECT_EQ(grid.FindNearest(Vector3{ 0.0f, 0.0f, 0.0f }), 1u);
+
+	grid.Remove(1);
+	grid.Remove(3);
+	EXPECT_EQ(grid.GetCount(), 1u);
+	EXPECT_EQ(grid.FindNearest(Vector3{ 0.0f, 0.0f, 0.0f }), 2u);
+
+	grid.Clear();
+	EXPECT_EQ(grid.GetCount(), 0u);
+	EXPECT_FALSE(grid.FindNearest(Vector3{}));
+}
+
+TEST(SpatialGrid, MovedActorsAreFoundInTheirNewCell) {
+	SpatialGrid::Grid grid(kCellSize);
+	grid.Update(1, Vector3{ 0.0f, 0.0f, 0.0f });
+	grid.Update(2, Vector3{ 5000.0f, 5000.0f, 0.0f });
+
+	// An animation change moves actor 1 next to actor 2, several cells away
+	grid.Update(1, Vector3{ 4990.0f, 5000.0f, 0.0f });
+	EXPECT_EQ(grid.FindNearest(Vector3{ 4980.0f, 5000.0f, 0.0f }), 1u);
+	EXPECT_EQ(grid.FindNearest(Vector3{ 0.0f, 0.0f, 0.0f }), 1u);
+
+	grid.Remove(1);
+	EXPECT_EQ(grid.FindNearest(Vector3{ 0.0f, 0.0f, 0.0f }), 2u);
+}
+
+TEST(SpatialGrid, FindNearestMatchesBruteForce) {
+	auto points = MakeActors(100, 10);
+	SpatialGrid::Grid grid(kCellSize);
+	for (const auto& point : points) {
+		grid.Update(point.id, point.position);
+	}
+	ASSERT_EQ(grid.GetCount(), 1000u);
+
+	// Queries inside scenes, between them and far outside the populated area
+	Corpus::Random random(7);
+	for (std::uint32_t ii = 0; ii < 500; ii++) {
+		float range = ii % 10 == 0 ? 50000.0f : 10000.0f;
+		Vector3 query{ random.Next(-range, range), random.Next(-range, range), random.Next(-500.0f, 500.0f) };
+		auto expected = FindNearest(points, query);
+		auto found = grid.FindNearest(query);
+		ASSERT_TRUE(found);
+		// Equal distances may pick either point
+		EXPECT_EQ(GetDistanceSq(points[*found - points[0].id].position, query), GetDistanceSq(points[*expected - points[0].id].position, query)) << ii;
+	}
+}
+
+TEST(SpatialGrid, FindNearestToRay) {
+	SpatialGrid::Grid grid(kCellSize);
+	grid.Update(1, Vector3{ 100.0f, 10.0f, 0.0f });
+	grid.Update(2, Vector3{ 300.0f, -5.0f, 0.0f });
+	grid.Update(3, Vector3{ -50.0f, 0.0f, 0.0f });
+	grid.Update(4, Vector3{ 5000.0f, 0.0f, 0.0f });
+
+	Vector3 origin{};
+	Vector3 direction{ 2.0f, 0.0f, 0.0f };
+
+	// Closest to the line wins, the point behind the origin and the one past the maximum distance are ignored
+	EXPECT_EQ(grid.FindNearestToRay(origin, direction, 50.0f, 1000.0f), 2u);
+	EXPECT_FALSE(grid.FindNearestToRay(origin, direction, 1.0f, 1000.0f));
+	EXPECT_EQ(grid.FindNearestToRay(origin, direction, 50.0f, 6000.0f), 4u);
+	EXPECT_FALSE(grid.FindNearestToRay(Vector3{ 0.0f, 0.0f, 0.0f }, Vector3{ -1.0f, 0.0f, 0.0f }, 10.0f, 10.0f));
+	EXPECT_EQ(grid.FindNearestToRay(Vector3{ 0.0f, 0.0f, 0.0f }, Vector3{ -1.0f, 0.0f, 0.0f }, 10.0f, 100.0f), 3u);
+
+	// A zero direction has no ray
+	EXPECT_FALSE(grid.FindNearestToRay(origin, Vector3{}, 50.0f, 1000.0f));
+}
+
+TEST(SpatialGrid, FindNearestToRayMatchesBruteForce) {
+	auto points = MakeActors(100, 10);
+	SpatialGrid::Grid grid(kCellSize);
+	for (const auto& point : points) {
+		grid.Update(point.id, point.position);
+	}
+
+	// Short rays walk the cells, long ones check every actor, both must agree with the brute force pick
+	Corpus::Random random(11);
+	std::uint32_t hits = 0;
+	for (std::uint32_t ii = 0; ii < 500; ii++) {
+		const Vector3& near = points[random.Next(static_cast<std::uint32_t>(points.size()))].position;
+		Vector3 origin{ near.x + random.Next(-300.0f, 300.0f), near.y + random.Next(-300.0f, 300.0f), near.z + 100.0f };
+		Vector3 direction{ near.x - origin.x, near.y - origin.y, near.z - origin.z };
+		float maxDistance = ii % 2 == 0 ? 1000.0f : 20000.0f;
+
+		auto expected = FindNearestToRay(points, origin, direction, 100.0f, maxDistance);
+		auto found = grid.FindNearestToRay(origin, direction, 100.0f, maxDistance);
+		EXPECT_EQ(found.has_value(), expected.has_value()) << ii;
+		hits += found.has_value();
+	}
+	EXPECT_GT(hits, 400u);
+}
+
+TEST(SpatialGrid, FindNearestToRayPrefersTheActorInFront) {
+	SpatialGrid::Grid grid(kCellSize);
+	grid.Update(1, Vector3{ 800.0f, 20.0f, 0.0f });
+	grid.Update(2, Vector3{ 200.0f, 20.0f, 0.0f });
+	grid.Update(3, Vector3{ 400.0f, -20.0f, 0.0f });
+
+	EXPECT_EQ(grid.FindNearestToRay(Vector3{}, Vector3{ 1.0f, 0.0f, 0.0f }, 50.0f, 1000.0f), 2u);
+}
+
+TEST(SpatialGrid, SortByDistance) {
+	SpatialGrid::Grid grid(kCellSize);
+	grid.Update(1, Vector3{ 3000.0f, 0.0f, 0.0f });
+	grid.Update(2, Vector3{ 10.0f, 0.0f, 0.0f });
+	grid.Update(3, Vector3{ 0.0f, -700.0f, 0.0f });
+	grid.Update(4, Vector3{ 0.0f, 0.0f, 200.0f });
+
+	std::vector<std::uint32_t> expected{ 2, 4, 3, 1 };
+	EXPECT_EQ(grid.SortByDistance(Vector3{}), expected);
+}
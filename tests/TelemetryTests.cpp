@@ -0,0 +1,145 @@
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Core/Telemetry.h"
+
+namespace {
+	// Each test starts a fresh region and removes it again, a reader can only attach while it exists
+	class Telemetry : public ::testing::Test {
+	protected:
+		void SetUp() override { ASSERT_TRUE(::Telemetry::Start()); }
+		void TearDown() override { ::Telemetry::Stop(); }
+	};
+}
+
+TEST_F(Telemetry, ReaderAttachesOnlyWhileStarted) {
+	::Telemetry::Reader reader;
+	EXPECT_TRUE(reader.Open());
+	EXPECT_EQ(reader.GetWriteIndex(), 0u);
+	reader.Close();
+
+	::Telemetry::Stop();
+	EXPECT_FALSE(::Telemetry::IsEnabled());
+	EXPECT_FALSE(reader.Open());
+
+	::Telemetry::Record record;
+	std::uint64_t cursor = 0;
+	EXPECT_FALSE(reader.ReadNext(cursor, record));
+}
+
+TEST_F(Telemetry, RecordsArriveInOrder) {
+	::Telemetry::Reader reader;
+	ASSERT_TRUE(reader.Open());
+
+	for (std::uint32_t ii = 0; ii < 10; ii++) {
+		::Telemetry::Push(::Telemetry::EVENT::kAnimationChange, 7, ii, Vector3{ static_cast<float>(ii), 0.0f, 1.0f }, ii * 10, "Leito_Doggy_001");
+	}
+
+	std::uint64_t cursor = 0;
+	::Telemetry::Record record;
+	for (std::uint32_t ii = 0; ii < 10; ii++) {
+		ASSERT_TRUE(reader.ReadNext(cursor, record));
+		EXPECT_EQ(record.event, ::Telemetry::EVENT::kAnimationChange);
+		EXPECT_EQ(record.sceneID, 7u);
+		EXPECT_EQ(record.formID, ii);
+		EXPECT_EQ(record.duration, ii * 10);
+		EXPECT_EQ(record.offset, (Vector3{ static_cast<float>(ii), 0.0f, 1.0f }));
+		EXPECT_STREQ(record.position, "Leito_Doggy_001");
+	}
+	EXPECT_FALSE(reader.ReadNext(cursor, record));
+	EXPECT_EQ(cursor, 10u);
+}
+
+TEST_F(Telemetry, LongPositionsAreTruncated) {
+	::Telemetry::Reader reader;
+	ASSERT_TRUE(reader.Open());
+
+	std::string position(200, 'a');
+	::Telemetry::Push(::Telemetry::EVENT::kSavePosition, 1, 1, {}, 0, position);
+
+	std::uint64_t cursor = 0;
+	::Telemetry::Record record;
+	ASSERT_TRUE(reader.ReadNext(cursor, record));
+	EXPECT_EQ(std::string(record.position), std::string(::Telemetry::kMaxPositionLength - 1, 'a'));
+}
+
+TEST_F(Telemetry, SlowReaderSkipsToTheOldestRecordStillHeld) {
+	::Telemetry::Reader reader;
+	ASSERT_TRUE(reader.Open());
+
+	constexpr std::uint32_t kPushed = ::Telemetry::kRingCapacity + 100;
+	for (std::uint32_t ii = 0; ii < kPushed; ii++) {
+		::Telemetry::Push(::Telemetry::EVENT::kApplyOffset, 1, ii, {}, 1, "");
+	}
+
+	std::uint64_t cursor = 0;
+	::Telemetry::Record record;
+	ASSERT_TRUE(reader.ReadNext(cursor, record));
+	EXPECT_EQ(record.formID, 100u);
+
+	std::uint32_t count = 1;
+	while (reader.ReadNext(cursor, record)) {
+		count++;
+	}
+	EXPECT_EQ(count, ::Telemetry::kRingCapacity);
+	EXPECT_EQ(record.formID, kPushed - 1);
+}
+
+TEST_F(Telemetry, SnapshotTracksTimingsAndCounts) {
+	::Telemetry::Reader reader;
+	ASSERT_TRUE(reader.Open());
+
+	::Telemetry::Push(::Telemetry::EVENT::kApplyOffset, 1, 1, {}, 30, "");
+	::Telemetry::Push(::Telemetry::EVENT::kApplyOffset, 1, 1, {}, 10, "");
+	::Telemetry::Push(::Telemetry::EVENT::kLoadPosition, 1, 1, {}, 500, "");
+	::Telemetry::Push(::Telemetry::EVENT::kSceneInit, 1, 1, {}, 999, "");
+	::Telemetry::UpdateCounts(3, 7);
+	::Telemetry::UpdatePrefetch(5, 2);
+
+	::Telemetry::Snapshot snapshot;
+	ASSERT_TRUE(reader.ReadSnapshot(snapshot));
+	EXPECT_EQ(snapshot.apply.count, 2u);
+	EXPECT_EQ(snapshot.apply.last, 10u);
+	EXPECT_EQ(snapshot.apply.max, 30u);
+	EXPECT_EQ(snapshot.load.count, 1u);
+	EXPECT_EQ(snapshot.save.count, 0u);
+	EXPECT_EQ(snapshot.activeScenes, 3u);
+	EXPECT_EQ(snapshot.activeActors, 7u);
+	EXPECT_EQ(snapshot.prefetchHits, 5u);
+	EXPECT_EQ(snapshot.prefetchMisses, 2u);
+}
+
+// Every record is written with offset.x equal to its form ID, a torn read would break that
+TEST_F(Telemetry, ConcurrentReaderNeverSeesATornRecord) {
+	::Telemetry::Reader reader;
+	ASSERT_TRUE(reader.Open());
+
+	std::atomic<bool> done = false;
+	std::jthread writer([&]() {
+		for (std::uint32_t ii = 0; ii < 200000; ii++) {
+			::Telemetry::Push(::Telemetry::EVENT::kApplyOffset, ii, ii, Vector3{ static_cast<float>(ii % 1000), 0.0f, 0.0f }, ii, "");
+		}
+		done = true;
+	});
+
+	std::uint64_t cursor = 0;
+	std::uint64_t read = 0;
+	std::uint64_t lastFormID = 0;
+	::Telemetry::Record record;
+	while (!done || cursor < reader.GetWriteIndex()) {
+		if (!reader.ReadNext(cursor, record)) {
+			continue;
+		}
+
+		ASSERT_EQ(static_cast<std::uint32_t>(record.offset.x), record.formID % 1000);
+		ASSERT_EQ(record.sceneID, record.formID);
+		ASSERT_TRUE(read == 0 || record.formID > lastFormID);
+		lastFormID = record.formID;
+		read++;
+	}
+
+	EXPECT_GT(read, 0u);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace TestUtils {
+	// A fresh directory under the temp directory that is removed with everything in it
+	class TemporaryDirectory {
+	public:
+		TemporaryDirectory() {
+			static std::atomic<std::uint32_t> counter = 0;
+			path = std::filesystem::temp_directory_path() / fmt::format("AAFDynamicPositionerTests-{}-{}", std::chrono::steady_clock::now().time_since_epoch().count(), counter++);
+			std::filesystem::create_directories(path);
+		}
+
+		~TemporaryDirectory() {
+			std::error_code ec;
+			std::filesystem::remove_all(path, ec);
+		}
+
+		TemporaryDirectory(const TemporaryDirectory&) = delete;
+		TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+		const std::filesystem::path& Get() const { return path; }
+
+		std::filesystem::path Write(const std::filesystem::path& a_relative, std::string_view a_content) const {
+			std::filesystem::path target = path / a_relative;
+			std::filesystem::create_directories(target.parent_path());
+			std::ofstream file(target, std::ios::binary | std::ios::trunc);
+			file.write(a_content.data(), static_cast<std::streamsize>(a_content.size()));
+			return target;
+		}
+
+	private:
+		std::filesystem::path path;
+	};
+
+	inline std::filesystem::path GetFixture(std::string_view a_relative) {
+		return std::filesystem::path(TEST_FIXTURE_DIR) / a_relative;
+	}
+}
@@ -0,0 +1,163 @@
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/Tokenizer.h"
+#include "bench/Corpus.h"
+#include "bench/LegacyTokenizer.h"
+
+using namespace std::literals;
+
+namespace {
+	// Printable ASCII weighted towards the bytes the tokenizer cares about
+	std::string MakeLine(Corpus::Random& a_random) {
+		constexpr std::string_view kSpecial = " \t\v\f\r,|#@.-+0123456789"sv;
+
+		std::string line;
+		std::uint32_t length = a_random.Next(80u);
+		for (std::uint32_t ii = 0; ii < length; ii++) {
+			if (a_random.Next(2u) == 0) {
+				line.push_back(kSpecial[a_random.Next(static_cast<std::uint32_t>(kSpecial.size()))]);
+			}
+			else {
+				line.push_back(static_cast<char>(' ' + a_random.Next(95u)));
+			}
+		}
+		return line;
+	}
+}
+
+TEST(Tokenizer, TrimMatchesLegacy) {
+	Corpus::Random random(29);
+	for (int ii = 0; ii < 20000; ii++) {
+		std::string line = MakeLine(random);
+		std::string expected = line;
+		LegacyTokenizer::Trim(expected);
+		EXPECT_EQ(Tokenizer::Trim(line), expected) << line;
+	}
+}
+
+TEST(Tokenizer, GetNextDataMatchesLegacy) {
+	constexpr char kDelimiters[] = { ',', '|', 0 };
+
+	Corpus::Random random(30);
+	for (int ii = 0; ii < 50000; ii++) {
+		std::string line = MakeLine(random);
+
+		std::uint32_t legacyIndex = 0;
+		std::size_t index = 0;
+		for (int field = 0; field < 6; field++) {
+			char delimiter = kDelimiters[random.Next(3u)];
+			std::string expected = LegacyTokenizer::GetNextData(line, legacyIndex, delimiter);
+			std::string_view actual = Tokenizer::GetNextData(line, index, delimiter);
+			ASSERT_EQ(actual, expected) << "line: " << line << " field: " << field;
+			ASSERT_EQ(index, legacyIndex) << "line: " << line << " field: " << field;
+		}
+	}
+}
+
+TEST(Tokenizer, CommentStopsEveryFollowingRead) {
+	std::string_view line = " 1 | 2 # 3 , 4"sv;
+	std::size_t index = 0;
+	EXPECT_EQ(Tokenizer::GetNextData(line, index, '|'), "1"sv);
+	EXPECT_EQ(Tokenizer::GetNextData(line, index, ','), "2"sv);
+	EXPECT_EQ(line[index], '#');
+	EXPECT_EQ(Tokenizer::GetNextData(line, index, ','), ""sv);
+	EXPECT_EQ(Tokenizer::GetNextData(line, index, 0), ""sv);
+}
+
+TEST(Tokenizer, FindFirstOfMatchesTheStandardLibrary) {
+	Corpus::Random random(31);
+	for (int ii = 0; ii < 20000; ii++) {
+		std::string line = MakeLine(random);
+		std::size_t start = line.empty() ? 0 : random.Next(static_cast<std::uint32_t>(line.size()));
+		std::size_t expected = std::min(line.find_first_of("#,|", start), line.size());
+		EXPECT_EQ(Tokenizer::FindFirstOf(line, start, '#', ',', '|'), expected) << line;
+	}
+
+	// A match in every position of a chunk and past it
+	for (std::size_t size = 0; size < 70; size++) {
+		for (std::size_t pos = 0; pos <= size; pos++) {
+			std::string line(size, 'a');
+			if (pos < size) {
+				line[pos] = '#';
+			}
+			EXPECT_EQ(Tokenizer::FindFirstOf(line, 0, '#', '#', '#'), pos);
+		}
+	}
+}
+
+TEST(Tokenizer, LineReaderMatchesGetline) {
+	Corpus::Random random(32);
+	std::string buffer;
+	for (int ii = 0; ii < 2000; ii++) {
+		buffer += MakeLine(random);
+		buffer += random.Next(3u) == 0 ? "\r\n" : "\n";
+	}
+	buffer += "last line without a newline";
+
+	std::vector<std::string> expected;
+	std::istringstream stream(buffer);
+	for (std::string line; std::getline(stream, line);) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		expected.push_back(line);
+	}
+
+	std::vector<std::string> actual;
+	Tokenizer::LineReader reader(buffer);
+	std::string_view line;
+	while (reader.Next(line)) {
+		actual.emplace_back(line);
+	}
+
+	EXPECT_EQ(actual, expected);
+}
+
+TEST(Tokenizer, ParsesNumbers) {
+	float value;
+	EXPECT_TRUE(Tokenizer::ParseNumber("+1.5"sv, value));
+	EXPECT_EQ(value, 1.5f);
+	EXPECT_TRUE(Tokenizer::ParseNumber("-2e2"sv, value));
+	EXPECT_EQ(value, -200.0f);
+	EXPECT_FALSE(Tokenizer::ParseNumber(""sv, value));
+	EXPECT_FALSE(Tokenizer::ParseNumber("1.5x"sv, value));
+	EXPECT_FALSE(Tokenizer::ParseNumber("+-1"sv, value));
+
+	std::uint32_t index;
+	EXPECT_TRUE(Tokenizer::ParseNumber("42"sv, index));
+	EXPECT_EQ(index, 42u);
+	EXPECT_FALSE(Tokenizer::ParseNumber("-1"sv, index));
+	EXPECT_FALSE(Tokenizer::ParseNumber("4294967296"sv, index));
+}
+
+TEST(Tokenizer, IgnoresCase) {
+	EXPECT_EQ(Tokenizer::ToLower("AAF_Bed_01.TXT"sv), "aaf_bed_01.txt");
+	EXPECT_EQ(Tokenizer::ToLower(""sv), "");
+	EXPECT_TRUE(Tokenizer::IEquals("TRUE"sv, "true"sv));
+	EXPECT_TRUE(Tokenizer::IEquals(""sv, ""sv));
+	EXPECT_FALSE(Tokenizer::IEquals("true"sv, "true "sv));
+	EXPECT_FALSE(Tokenizer::IEquals("bPrewarm"sv, "bPrefetch"sv));
+}
+
+TEST(Tokenizer, LowerKeyServesTransparentLookups) {
+	std::unordered_map<std::string, int, Tokenizer::StringHash, std::equal_to<>> map{ { "aaf_bed_01", 1 } };
+
+	Tokenizer::LowerKey key("AAF_Bed_01"sv);
+	EXPECT_EQ(key.Get(), "aaf_bed_01"sv);
+	auto it = map.find(key.Get());
+	ASSERT_NE(it, map.end());
+	EXPECT_EQ(it->second, 1);
+
+	// Names longer than the stack buffer still come out whole
+	std::string longName(1000, 'A');
+	Tokenizer::LowerKey longKey(longName);
+	EXPECT_EQ(longKey.Get(), std::string(1000, 'a'));
+	EXPECT_EQ(Tokenizer::LowerKey(""sv).Get(), ""sv);
+}
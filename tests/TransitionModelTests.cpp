@@ -0,0 +1,89 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Core/TransitionModel.h"
+#include "tests/TestUtils.h"
+
+namespace {
+	class TransitionModel : public ::testing::Test {
+	protected:
+		void SetUp() override { ::TransitionModel::Clear(); }
+		void TearDown() override { ::TransitionModel::Clear(); }
+	};
+
+	std::string GetName(const char* a_prefix, std::size_t a_index) {
+		return a_prefix + std::to_string(a_index);
+	}
+}
+
+TEST_F(TransitionModel, PredictsTheMostFrequentSuccessorsFirst) {
+	for (int ii = 0; ii < 3; ii++) {
+		::TransitionModel::Observe("Leito_Doggy_01", "Leito_Doggy_02");
+	}
+	::TransitionModel::Observe("Leito_Doggy_01", "Leito_Doggy_03");
+	::TransitionModel::Observe("leito_doggy_01", "LEITO_DOGGY_03");
+	::TransitionModel::Observe("Leito_Doggy_01", "Leito_Missionary_01");
+
+	auto predictions = ::TransitionModel::Predict("LEITO_DOGGY_01", 2);
+	ASSERT_EQ(predictions.size(), 2u);
+	EXPECT_EQ(predictions[0], "leito_doggy_02");
+	EXPECT_EQ(predictions[1], "leito_doggy_03");
+	EXPECT_TRUE(::TransitionModel::IsDirty());
+
+	// Self transitions and empty names teach nothing
+	::TransitionModel::Observe("Leito_Doggy_04", "Leito_Doggy_04");
+	::TransitionModel::Observe("", "Leito_Doggy_04");
+	EXPECT_TRUE(::TransitionModel::Predict("Leito_Doggy_04", 4).empty());
+	EXPECT_TRUE(::TransitionModel::Predict("Unknown", 4).empty());
+}
+
+TEST_F(TransitionModel, SaveAndLoadRoundTrip) {
+	::TransitionModel::Observe("A", "B");
+	::TransitionModel::Observe("A", "B");
+	::TransitionModel::Observe("A", "C");
+
+	TestUtils::TemporaryDirectory dir;
+	std::string path = (dir.Get() / "Transitions.dat").string();
+	ASSERT_TRUE(::TransitionModel::Save(path));
+	EXPECT_FALSE(::TransitionModel::IsDirty());
+
+	::TransitionModel::Clear();
+	ASSERT_TRUE(::TransitionModel::Load(path));
+	auto predictions = ::TransitionModel::Predict("a", 4);
+	ASSERT_EQ(predictions.size(), 2u);
+	EXPECT_EQ(predictions[0], "b");
+	EXPECT_EQ(predictions[1], "c");
+	EXPECT_EQ(::TransitionModel::GetNameCount(), 3u);
+}
+
+TEST_F(TransitionModel, EvictedStatesGiveTheirNamesBack) {
+	// A chain longer than both limits, each step evicts the oldest state once the table is full
+	constexpr std::size_t kSteps = ::TransitionModel::kMaxNames + 2000;
+	for (std::size_t ii = 0; ii + 1 < kSteps; ii++) {
+		::TransitionModel::Observe(GetName("p", ii), GetName("p", ii + 1));
+	}
+
+	EXPECT_LE(::TransitionModel::GetNameCount(), ::TransitionModel::kMaxStates + 1);
+
+	// Names past the old limit are still taken
+	auto predictions = ::TransitionModel::Predict(GetName("p", kSteps - 2), 1);
+	ASSERT_EQ(predictions.size(), 1u);
+	EXPECT_EQ(predictions[0], GetName("p", kSteps - 1));
+
+	EXPECT_TRUE(::TransitionModel::Predict(GetName("p", 0), 1).empty());
+}
+
+TEST_F(TransitionModel, FullNameTableEvictsStatesToMakeRoom) {
+	// Four distinct successors per state fill the name table before the state table
+	constexpr std::size_t kStates = 4000;
+	for (std::size_t ii = 0; ii < kStates; ii++) {
+		for (std::size_t jj = 0; jj < ::TransitionModel::kMaxSuccessors; jj++) {
+			::TransitionModel::Observe(GetName("s", ii), GetName("t", ii * ::TransitionModel::kMaxSuccessors + jj));
+		}
+	}
+
+	EXPECT_LE(::TransitionModel::GetNameCount(), ::TransitionModel::kMaxNames);
+	EXPECT_EQ(::TransitionModel::Predict(GetName("s", kStates - 1), 4).size(), ::TransitionModel::kMaxSuccessors);
+	EXPECT_TRUE(::TransitionModel::Predict(GetName("s", 0), 4).empty());
+}
@@ -0,0 +1,671 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/sinks/stdout_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "Core/OffsetProfiles.h"
+#include "Core/PositionBaker.h"
+#include "Core/PositionFile.h"
+#include "Core/Tokenizer.h"
+
+namespace {
+	namespace fs = std::filesystem;
+
+	using PositionFile::Entry;
+
+	constexpr float kDefaultBucketSize = 0.05f;
+
+	struct Options {
+		unsigned                 threads = std::max(1u, std::thread::hardware_concurrency());
+		float                    bucketSize = kDefaultBucketSize;
+		bool                     dryRun = false;
+		bool                     flat = false;
+		bool                     absolute = false;
+		bool                     separatePlayer = false;
+		std::vector<std::string> args;
+	};
+
+	// A position file of a tree, the name is the path relative to the root without the extension
+	struct Item {
+		std::string name;
+		fs::path    path;
+	};
+
+	using Tree = std::map<std::string, Item>;
+
+	// Results are printed as soon as a worker finishes, the lock keeps the lines whole
+	std::mutex g_outputLock;
+
+	template <class... Args>
+	void Print(const char* a_format, Args... a_args) {
+		std::lock_guard lock(g_outputLock);
+		std::printf(a_format, a_args...);
+	}
+
+	using Tokenizer::ToLower;
+
+	// Position names are matched case-insensitively like the game's file system does
+	Tree ScanTree(const fs::path& a_root, bool a_flat) {
+		Tree result;
+
+		std::error_code ec;
+		for (fs::recursive_directory_iterator it(a_root, ec), end; !ec && it != end; it.increment(ec)) {
+			if (a_flat && it->is_directory(ec)) {
+				it.disable_recursion_pending();
+				continue;
+			}
+
+			if (!it->is_regular_file(ec) || ToLower(it->path().extension().string()) != ".txt") {
+				continue;
+			}
+
+			fs::path relative = it->path().lexically_relative(a_root);
+			relative.replace_extension();
+
+			std::string name = relative.generic_string();
+			result.emplace(ToLower(name), Item{ name, it->path() });
+		}
+
+		if (ec) {
+			std::fprintf(stderr, "Cannot scan %s: %s\n", a_root.string().c_str(), ec.message().c_str());
+		}
+
+		return result;
+	}
+
+	std::vector<const Item*> GetItems(const Tree& a_tree) {
+		std::vector<const Item*> result;
+		result.reserve(a_tree.size());
+		for (const auto& [key, item] : a_tree) {
+			result.push_back(&item);
+		}
+		return result;
+	}
+
+	// Workers take the next index until every item is done
+	template <class F>
+	void ParallelFor(std::size_t a_count, unsigned a_threads, F&& a_func) {
+		std::atomic<std::size_t> next = 0;
+
+		auto worker = [&]() {
+			for (std::size_t ii = next.fetch_add(1, std::memory_order_relaxed); ii < a_count; ii = next.fetch_add(1, std::memory_order_relaxed)) {
+				a_func(ii);
+			}
+		};
+
+		std::vector<std::jthread> threads;
+		unsigned threadCount = static_cast<unsigned>(std::min<std::size_t>(a_threads, a_count));
+		for (unsigned ii = 1; ii < threadCount; ii++) {
+			threads.emplace_back(worker);
+		}
+		worker();
+	}
+
+	// Later lines of the same index and bucket win, the result is sorted the way the plugin stores it
+	std::vector<Entry> Normalize(const std::vector<Entry>& a_entries, float a_bucketSize) {
+		std::vector<Entry> result;
+		OffsetProfiles::Merge(result, a_entries, a_bucketSize);
+		return result;
+	}
+
+	bool LoadNormalized(const fs::path& a_path, float a_bucketSize, std::string& a_buffer, std::vector<Entry>& a_entries) {
+		if (!Tokenizer::ReadFile(a_path.string(), a_buffer)) {
+			return false;
+		}
+
+		a_entries = Normalize(PositionFile::Parse(a_buffer), a_bucketSize);
+		return true;
+	}
+
+	std::string FormatScale(float a_scale) {
+		if (a_scale == PositionFile::kNoScale) {
+			return {};
+		}
+
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "@%g", a_scale);
+		return buffer;
+	}
+
+	int Scan(const Options& a_options, bool a_rewrite) {
+		if (a_options.args.size() != 1) {
+			return -1;
+		}
+
+		Tree tree = ScanTree(a_options.args[0], a_options.flat);
+		std::vector<const Item*> items = GetItems(tree);
+
+		std::atomic<std::size_t> entryCount = 0;
+		std::atomic<std::size_t> failedCount = 0;
+		std::atomic<std::size_t> changedCount = 0;
+
+		ParallelFor(items.size(), a_options.threads, [&](std::size_t a_index) {
+			const Item& item = *items[a_index];
+
+			std::string buffer;
+			std::vector<Entry> entries;
+			if (!LoadNormalized(item.path, a_options.bucketSize, buffer, entries)) {
+				Print("! %s: cannot read\n", item.name.c_str());
+				failedCount++;
+				return;
+			}
+
+			entryCount += entries.size();
+
+			std::string normalized = PositionFile::Serialize(entries);
+			if (normalized == buffer) {
+				if (!a_rewrite) {
+					Print("  %s: %zu\n", item.name.c_str(), entries.size());
+				}
+				return;
+			}
+
+			changedCount++;
+
+			if (a_rewrite && !a_options.dryRun && !PositionFile::Save(item.path.string(), entries)) {
+				Print("! %s: cannot write\n", item.name.c_str());
+				failedCount++;
+				return;
+			}
+
+			Print("* %s: %zu\n", item.name.c_str(), entries.size());
+		});
+
+		std::printf("%zu files, %zu entries, %zu %s, %zu failed\n", items.size(), entryCount.load(), changedCount.load(),
+			a_rewrite && !a_options.dryRun ? "normalized" : "not normalized", failedCount.load());
+		return failedCount > 0 ? 1 : 0;
+	}
+
+	void DiffEntries(const std::string& a_name, const std::vector<Entry>& a_lhs, const std::vector<Entry>& a_rhs) {
+		auto less = [](const Entry& a_a, const Entry& a_b) {
+			return a_a.index != a_b.index ? a_a.index < a_b.index : a_a.scale < a_b.scale;
+		};
+
+		std::string lines;
+		char buffer[256];
+
+		auto lhs = a_lhs.begin();
+		auto rhs = a_rhs.begin();
+		while (lhs != a_lhs.end() || rhs != a_rhs.end()) {
+			if (rhs == a_rhs.end() || (lhs != a_lhs.end() && less(*lhs, *rhs))) {
+				std::snprintf(buffer, sizeof(buffer), "- %s: %u%s|%g,%g,%g\n", a_name.c_str(), lhs->index, FormatScale(lhs->scale).c_str(), lhs->offset.x, lhs->offset.y, lhs->offset.z);
+				lines += buffer;
+				++lhs;
+			}
+			else if (lhs == a_lhs.end() || less(*rhs, *lhs)) {
+				std::snprintf(buffer, sizeof(buffer), "+ %s: %u%s|%g,%g,%g\n", a_name.c_str(), rhs->index, FormatScale(rhs->scale).c_str(), rhs->offset.x, rhs->offset.y, rhs->offset.z);
+				lines += buffer;
+				++rhs;
+			}
+			else {
+				if (!(lhs->offset == rhs->offset)) {
+					std::snprintf(buffer, sizeof(buffer), "~ %s: %u%s|%g,%g,%g -> %g,%g,%g\n", a_name.c_str(), lhs->index, FormatScale(lhs->scale).c_str(),
+						lhs->offset.x, lhs->offset.y, lhs->offset.z, rhs->offset.x, rhs->offset.y, rhs->offset.z);
+					lines += buffer;
+				}
+				++lhs;
+				++rhs;
+			}
+		}
+
+		if (!lines.empty()) {
+			Print("%s", lines.c_str());
+		}
+	}
+
+	// Pairs up the positions of two trees, a side is null when the position only exists in the other tree
+	std::vector<std::pair<const Item*, const Item*>> PairTrees(const Tree& a_lhs, const Tree& a_rhs) {
+		std::vector<std::pair<const Item*, const Item*>> result;
+		for (const auto& [key, item] : a_lhs) {
+			auto it = a_rhs.find(key);
+			result.emplace_back(&item, it != a_rhs.end() ? &it->second : nullptr);
+		}
+		for (const auto& [key, item] : a_rhs) {
+			if (!a_lhs.contains(key)) {
+				result.emplace_back(nullptr, &item);
+			}
+		}
+		return result;
+	}
+
+	int Diff(const Options& a_options) {
+		if (a_options.args.size() != 2) {
+			return -1;
+		}
+
+		Tree lhsTree = ScanTree(a_options.args[0], a_options.flat);
+		Tree rhsTree = ScanTree(a_options.args[1], a_options.flat);
+		auto pairs = PairTrees(lhsTree, rhsTree);
+
+		std::atomic<std::size_t> differentCount = 0;
+
+		ParallelFor(pairs.size(), a_options.threads, [&](std::size_t a_index) {
+			auto [lhs, rhs] = pairs[a_index];
+			if (!rhs) {
+				Print("- %s\n", lhs->name.c_str());
+				differentCount++;
+				return;
+			}
+			if (!lhs) {
+				Print("+ %s\n", rhs->name.c_str());
+				differentCount++;
+				return;
+			}
+
+			std::string buffer;
+			std::vector<Entry> lhsEntries, rhsEntries;
+			if (!LoadNormalized(lhs->path, a_options.bucketSize, buffer, lhsEntries) || !LoadNormalized(rhs->path, a_options.bucketSize, buffer, rhsEntries)) {
+				Print("! %s: cannot read\n", lhs->name.c_str());
+				differentCount++;
+				return;
+			}
+
+			if (PositionFile::Serialize(lhsEntries) != PositionFile::Serialize(rhsEntries)) {
+				DiffEntries(lhs->name, lhsEntries, rhsEntries);
+				differentCount++;
+			}
+		});
+
+		std::printf("%zu positions, %zu different\n", pairs.size(), differentCount.load());
+		return differentCount > 0 ? 1 : 0;
+	}
+
+	// The second tree wins for entries of the same index and bucket
+	int Merge(const Options& a_options) {
+		if (a_options.args.size() != 3) {
+			return -1;
+		}
+
+		Tree lhsTree = ScanTree(a_options.args[0], a_options.flat);
+		Tree rhsTree = ScanTree(a_options.args[1], a_options.flat);
+		fs::path outRoot = a_options.args[2];
+		auto pairs = PairTrees(lhsTree, rhsTree);
+
+		std::atomic<std::size_t> failedCount = 0;
+
+		ParallelFor(pairs.size(), a_options.threads, [&](std::size_t a_index) {
+			auto [lhs, rhs] = pairs[a_index];
+			const Item* named = lhs ? lhs : rhs;
+
+			std::string buffer;
+			std::vector<Entry> entries, updates;
+			if ((lhs && !LoadNormalized(lhs->path, a_options.bucketSize, buffer, entries)) || (rhs && !LoadNormalized(rhs->path, a_options.bucketSize, buffer, updates))) {
+				Print("! %s: cannot read\n", named->name.c_str());
+				failedCount++;
+				return;
+			}
+
+			OffsetProfiles::Merge(entries, updates, a_options.bucketSize);
+
+			if (!a_options.dryRun) {
+				fs::path outPath = outRoot / fs::path(named->name + ".txt");
+				std::error_code ec;
+				fs::create_directories(outPath.parent_path(), ec);
+
+				if (!PositionFile::Save(outPath.string(), entries)) {
+					Print("! %s: cannot write\n", named->name.c_str());
+					failedCount++;
+					return;
+				}
+			}
+
+			Print("%c %s: %zu\n", lhs && rhs ? '*' : (lhs ? '<' : '>'), named->name.c_str(), entries.size());
+		});
+
+		std::printf("%zu positions merged, %zu failed\n", pairs.size() - failedCount.load(), failedCount.load());
+		return failedCount > 0 ? 1 : 0;
+	}
+
+	// Every position as a [name] header followed by its normalized lines, in name order
+	int Export(const Options& a_options) {
+		if (a_options.args.size() != 2) {
+			return -1;
+		}
+
+		Tree tree = ScanTree(a_options.args[0], a_options.flat);
+		std::vector<const Item*> items = GetItems(tree);
+		std::vector<std::string> sections(items.size());
+
+		std::atomic<std::size_t> failedCount = 0;
+
+		ParallelFor(items.size(), a_options.threads, [&](std::size_t a_index) {
+			std::string buffer;
+			std::vector<Entry> entries;
+			if (!LoadNormalized(items[a_index]->path, a_options.bucketSize, buffer, entries)) {
+				Print("! %s: cannot read\n", items[a_index]->name.c_str());
+				failedCount++;
+				return;
+			}
+
+			sections[a_index] = "[" + items[a_index]->name + "]\n" + PositionFile::Serialize(entries);
+		});
+
+		std::FILE* file = std::fopen(a_options.args[1].c_str(), "wb");
+		if (!file) {
+			std::fprintf(stderr, "Cannot open %s\n", a_options.args[1].c_str());
+			return 1;
+		}
+
+		for (const auto& section : sections) {
+			std::fwrite(section.data(), 1, section.size(), file);
+		}
+		std::fclose(file);
+
+		std::printf("%zu positions exported, %zu failed\n", items.size() - failedCount.load(), failedCount.load());
+		return failedCount > 0 ? 1 : 0;
+	}
+
+	std::vector<fs::path> ScanXml(const fs::path& a_root) {
+		std::vector<fs::path> result;
+
+		std::error_code ec;
+		for (fs::recursive_directory_iterator it(a_root, ec), end; !ec && it != end; it.increment(ec)) {
+			if (it->is_regular_file(ec) && ToLower(it->path().extension().string()) == ".xml") {
+				result.push_back(it->path());
+			}
+		}
+
+		if (ec) {
+			std::fprintf(stderr, "Cannot scan %s: %s\n", a_root.string().c_str(), ec.message().c_str());
+		}
+
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	// Offsets are added to the actors of each position's animation. An animation played by several positions is only baked
+	// when all of them have the same offsets, and scale buckets stay with the plugin since they depend on the actor.
+	int Bake(const Options& a_options) {
+		if (a_options.args.size() != 3 && a_options.args.size() != 4) {
+			return -1;
+		}
+
+		// The relative positioner moves actors by offset * (1 - scale), which no fixed XML offset can reproduce
+		if (!a_options.absolute) {
+			std::fprintf(stderr, "Baked offsets are only right when iNPCPositionerType and iPlayerPositionerType are 1 (absolute), pass --absolute to confirm\n");
+			return 2;
+		}
+
+		Tree tree = ScanTree(a_options.args[0], true);
+		Tree playerTree = a_options.separatePlayer ? ScanTree(fs::path(a_options.args[0]) / "Player", true) : Tree{};
+		fs::path xmlRoot = a_options.args[1];
+		fs::path outRoot = a_options.args[2];
+		fs::path reportPath = a_options.args.size() == 4 ? fs::path(a_options.args[3]) : outRoot / "Baked.txt";
+
+		std::vector<fs::path> xmlFiles = ScanXml(xmlRoot);
+		std::vector<std::vector<PositionBaker::Position>> filePositions(xmlFiles.size());
+
+		std::atomic<std::size_t> failedCount = 0;
+
+		ParallelFor(xmlFiles.size(), a_options.threads, [&](std::size_t a_index) {
+			if (!PositionBaker::ReadPositions(xmlFiles[a_index], filePositions[a_index])) {
+				Print("! %s: cannot read\n", xmlFiles[a_index].string().c_str());
+				failedCount++;
+			}
+		});
+
+		// AAF keeps the first definition of a position id
+		std::unordered_map<std::string, PositionBaker::Position> positions;
+		std::unordered_map<std::string, std::vector<std::string>> animationPositions;
+		for (auto& list : filePositions) {
+			for (auto& position : list) {
+				std::string key = PositionBaker::MakeKey(position.id);
+				if (positions.contains(key)) {
+					continue;
+				}
+
+				if (!position.animation.empty()) {
+					animationPositions[PositionBaker::MakeKey(position.animation)].push_back(key);
+				}
+				positions.emplace(std::move(key), std::move(position));
+			}
+		}
+
+		std::vector<const Item*> items = GetItems(tree);
+		std::vector<std::vector<Entry>> itemEntries(items.size());
+		// The Player\ file of each item, loaded only with separate player offsets
+		std::vector<std::optional<std::vector<Entry>>> playerEntries(items.size());
+
+		ParallelFor(items.size(), a_options.threads, [&](std::size_t a_index) {
+			std::string buffer;
+			if (!LoadNormalized(items[a_index]->path, a_options.bucketSize, buffer, itemEntries[a_index])) {
+				Print("! %s: cannot read\n", items[a_index]->name.c_str());
+				failedCount++;
+			}
+
+			auto playerIt = playerTree.find(ToLower(items[a_index]->name));
+			if (playerIt != playerTree.end()) {
+				playerEntries[a_index].emplace();
+				if (!LoadNormalized(playerIt->second.path, a_options.bucketSize, buffer, *playerEntries[a_index])) {
+					Print("! Player/%s: cannot read\n", playerIt->second.name.c_str());
+					failedCount++;
+				}
+			}
+		});
+
+		// Positions sharing an animation must agree on what both scene kinds get
+		auto getSignature = [&](std::size_t a_index) {
+			std::string result = PositionFile::Serialize(itemEntries[a_index]);
+			if (a_options.separatePlayer) {
+				result += playerEntries[a_index] ? "|" + PositionFile::Serialize(*playerEntries[a_index]) : "|-";
+			}
+			return result;
+		};
+
+		std::unordered_map<std::string, std::size_t> itemIndices;
+		for (std::size_t ii = 0; ii < items.size(); ii++) {
+			itemIndices.emplace(ToLower(items[ii]->name), ii);
+		}
+
+		std::map<std::string, std::string> skipped;
+		std::map<std::string, std::string> planned;
+		std::unordered_map<std::string, std::vector<Entry>> animations;
+
+		for (std::size_t ii = 0; ii < items.size(); ii++) {
+			std::string key = ToLower(items[ii]->name);
+			auto positionIt = positions.find(key);
+			const PositionBaker::Position* position = positionIt != positions.end() ? &positionIt->second : nullptr;
+
+			const std::vector<Entry>* player = playerEntries[ii] ? &*playerEntries[ii] : nullptr;
+			std::string reason = PositionBaker::CheckBakeable(position, itemEntries[ii], a_options.separatePlayer, player);
+			if (!reason.empty()) {
+				skipped.emplace(items[ii]->name, std::move(reason));
+				continue;
+			}
+
+			std::string animationKey = PositionBaker::MakeKey(position->animation);
+			std::string signature = getSignature(ii);
+			for (const auto& other : animationPositions[animationKey]) {
+				auto otherIt = itemIndices.find(other);
+				if (otherIt == itemIndices.end() || getSignature(otherIt->second) != signature) {
+					reason = "animation shared with " + positions[other].id;
+					break;
+				}
+			}
+
+			if (!reason.empty()) {
+				skipped.emplace(items[ii]->name, std::move(reason));
+				continue;
+			}
+
+			animations.emplace(animationKey, itemEntries[ii]);
+			planned.emplace(items[ii]->name, std::move(animationKey));
+		}
+
+		std::set<std::string> bakedAnimations;
+		std::atomic<std::size_t> writtenCount = 0;
+		std::mutex bakedLock;
+
+		if (!a_options.dryRun) {
+			ParallelFor(xmlFiles.size(), a_options.threads, [&](std::size_t a_index) {
+				fs::path outPath = outRoot / xmlFiles[a_index].lexically_relative(xmlRoot);
+
+				PositionBaker::Result result;
+				if (!PositionBaker::Bake(xmlFiles[a_index], outPath, animations, result)) {
+					Print("! %s: cannot bake\n", xmlFiles[a_index].string().c_str());
+					failedCount++;
+					return;
+				}
+
+				if (result.actorCount == 0) {
+					return;
+				}
+
+				writtenCount++;
+				Print("* %s: %zu actors\n", outPath.string().c_str(), result.actorCount);
+
+				std::lock_guard lock(bakedLock);
+				bakedAnimations.insert(result.animations.begin(), result.animations.end());
+			});
+		}
+
+		std::string report = "# Positions whose offsets are baked into the AAF XML, the plugin does not load or apply their offset files\n";
+		report += "# Only valid with the absolute positioner";
+		report += a_options.separatePlayer ? ", Player/ lines cover player scenes with separate player offsets\n" : "\n";
+		std::size_t bakedCount = 0;
+		for (const auto& [name, animationKey] : planned) {
+			if (a_options.dryRun || bakedAnimations.contains(animationKey)) {
+				report += name + "\n";
+				if (a_options.separatePlayer) {
+					report += "Player/" + name + "\n";
+				}
+				bakedCount++;
+				Print("+ %s\n", name.c_str());
+			}
+			else {
+				skipped.emplace(name, "animation not found");
+			}
+		}
+
+		for (const auto& [name, reason] : skipped) {
+			report += "# " + name + ": " + reason + "\n";
+			Print("- %s: %s\n", name.c_str(), reason.c_str());
+		}
+
+		if (!a_options.dryRun) {
+			std::error_code ec;
+			fs::create_directories(reportPath.parent_path(), ec);
+
+			std::FILE* file = std::fopen(reportPath.string().c_str(), "wb");
+			if (!file) {
+				std::fprintf(stderr, "Cannot open %s\n", reportPath.string().c_str());
+				return 1;
+			}
+			std::fwrite(report.data(), 1, report.size(), file);
+			std::fclose(file);
+		}
+
+		std::printf("%zu positions %s into %zu files, %zu skipped, %zu failed\n", bakedCount, a_options.dryRun ? "to bake" : "baked", writtenCount.load(), skipped.size(), failedCount.load());
+		return failedCount > 0 ? 1 : 0;
+	}
+
+	void PrintUsage() {
+		std::fprintf(stderr,
+			"Usage: AAFDynamicPositionerPositionTool <command> [options] <args>\n"
+			"  scan <dir>                 list every position and report files that are not normalized\n"
+			"  normalize <dir>            sort and deduplicate every file in place\n"
+			"  diff <dir> <dir>           compare two trees entry by entry\n"
+			"  merge <dir> <dir> <out>    write the union of two trees, the second one wins\n"
+			"  export <dir> <file>        write every position into a single file\n"
+			"  bake <dir> <xml> <out> [<report>]\n"
+			"                             add the offsets to the AAF XML files under <xml>, writing the changed files to <out>\n"
+			"Options:\n"
+			"  --threads <n>              worker threads, defaults to the number of cores\n"
+			"  --bucket <size>            scale bucket size used to match entries, defaults to %g\n"
+			"  --dry-run                  report without writing\n"
+			"  --flat                     skip subdirectories such as Player\n"
+			"  --absolute                 bake, confirming both positioner types are absolute\n"
+			"  --separate-player          bake only positions whose Player\\ offsets are the same, for bSeparatePlayerOffset\n",
+			kDefaultBucketSize);
+	}
+
+	bool ParseOptions(int a_argc, char* a_argv[], Options& a_options) {
+		for (int ii = 2; ii < a_argc; ii++) {
+			std::string_view arg = a_argv[ii];
+			if (arg == "--threads" && ii + 1 < a_argc) {
+				std::uint32_t threads;
+				if (!Tokenizer::ParseNumber(a_argv[++ii], threads) || threads == 0) {
+					return false;
+				}
+				a_options.threads = threads;
+			}
+			else if (arg == "--bucket" && ii + 1 < a_argc) {
+				if (!Tokenizer::ParseNumber(a_argv[++ii], a_options.bucketSize) || a_options.bucketSize <= 0.0f) {
+					return false;
+				}
+			}
+			else if (arg == "--dry-run") {
+				a_options.dryRun = true;
+			}
+			else if (arg == "--flat") {
+				a_options.flat = true;
+			}
+			else if (arg == "--absolute") {
+				a_options.absolute = true;
+			}
+			else if (arg == "--separate-player") {
+				a_options.separatePlayer = true;
+			}
+			else if (arg.starts_with("--")) {
+				return false;
+			}
+			else {
+				a_options.args.emplace_back(arg);
+			}
+		}
+		return true;
+	}
+}
+
+int main(int a_argc, char* a_argv[]) {
+	// Parse errors of the core go to stderr so that stdout stays machine readable
+	spdlog::set_default_logger(spdlog::stderr_logger_mt("PositionTool"));
+
+	Options options;
+	if (a_argc < 2 || !ParseOptions(a_argc, a_argv, options)) {
+		PrintUsage();
+		return 2;
+	}
+
+	std::string_view command = a_argv[1];
+
+	int result = -1;
+	if (command == "scan") {
+		result = Scan(options, false);
+	}
+	else if (command == "normalize") {
+		result = Scan(options, true);
+	}
+	else if (command == "diff") {
+		result = Diff(options);
+	}
+	else if (command == "merge") {
+		result = Merge(options);
+	}
+	else if (command == "export") {
+		result = Export(options);
+	}
+	else if (command == "bake") {
+		result = Bake(options);
+	}
+
+	if (result < 0) {
+		PrintUsage();
+		return 2;
+	}
+
+	return result;
+}
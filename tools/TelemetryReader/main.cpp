@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Core/Telemetry.h"
+
+namespace {
+	constexpr auto kPollInterval = std::chrono::milliseconds(100);
+	constexpr auto kSnapshotInterval = std::chrono::seconds(1);
+	constexpr auto kOpenRetryInterval = std::chrono::seconds(1);
+
+	std::string_view GetEventName(Telemetry::EVENT a_event) {
+		switch (a_event) {
+		case Telemetry::EVENT::kSceneInit:
+			return "SceneInit";
+		case Telemetry::EVENT::kAnimationChange:
+			return "AnimationChange";
+		case Telemetry::EVENT::kSceneEnd:
+			return "SceneEnd";
+		case Telemetry::EVENT::kApplyOffset:
+			return "ApplyOffset";
+		case Telemetry::EVENT::kLoadPosition:
+			return "LoadPosition";
+		case Telemetry::EVENT::kSavePosition:
+			return "SavePosition";
+		case Telemetry::EVENT::kPrefetch:
+			return "Prefetch";
+		default:
+			return "Unknown";
+		}
+	}
+
+	void PrintTiming(const char* a_name, const Telemetry::Timing& a_timing) {
+		std::printf(" %s=%llu(last %uus, max %uus)", a_name, static_cast<unsigned long long>(a_timing.count), a_timing.last, a_timing.max);
+	}
+
+	void PrintSnapshot(const Telemetry::Snapshot& a_snapshot) {
+		std::printf("[snapshot] scenes=%u actors=%u", a_snapshot.activeScenes, a_snapshot.activeActors);
+		PrintTiming("apply", a_snapshot.apply);
+		PrintTiming("load", a_snapshot.load);
+		PrintTiming("save", a_snapshot.save);
+
+		std::uint64_t prefetchTotal = a_snapshot.prefetchHits + a_snapshot.prefetchMisses;
+		if (prefetchTotal > 0) {
+			std::printf(" prefetch=%llu/%llu(%.1f%%)", static_cast<unsigned long long>(a_snapshot.prefetchHits), static_cast<unsigned long long>(prefetchTotal),
+				100.0 * static_cast<double>(a_snapshot.prefetchHits) / static_cast<double>(prefetchTotal));
+		}
+		std::printf("\n");
+	}
+
+	void PrintRecord(const Telemetry::Record& a_record) {
+		std::string_view position(a_record.position, strnlen(a_record.position, Telemetry::kMaxPositionLength));
+
+		std::printf("%llu %-15s scene=%llu form=%08X offset=(%g, %g, %g) duration=%uus position=%.*s\n",
+			static_cast<unsigned long long>(a_record.timestamp), GetEventName(a_record.event).data(),
+			static_cast<unsigned long long>(a_record.sceneID), a_record.formID,
+			a_record.offset.x, a_record.offset.y, a_record.offset.z, a_record.duration,
+			static_cast<int>(position.size()), position.data());
+	}
+}
+
+int main(int a_argc, char* a_argv[]) {
+	bool fromStart = a_argc > 1 && std::strcmp(a_argv[1], "--all") == 0;
+
+	Telemetry::Reader reader;
+	while (!reader.Open()) {
+		std::fprintf(stderr, "Waiting for the telemetry region, enable bTelemetry in the MCM settings...\n");
+		std::this_thread::sleep_for(kOpenRetryInterval);
+	}
+
+	// Only follow new records unless asked to dump whatever is still in the ring
+	std::uint64_t cursor = fromStart ? 0 : reader.GetWriteIndex();
+	auto lastSnapshot = std::chrono::steady_clock::time_point{};
+
+	for (;;) {
+		Telemetry::Record record;
+		while (reader.ReadNext(cursor, record)) {
+			PrintRecord(record);
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		if (now - lastSnapshot >= kSnapshotInterval) {
+			Telemetry::Snapshot snapshot;
+			if (reader.ReadSnapshot(snapshot)) {
+				PrintSnapshot(snapshot);
+			}
+			lastSnapshot = now;
+		}
+
+		std::fflush(stdout);
+		std::this_thread::sleep_for(kPollInterval);
+	}
+}